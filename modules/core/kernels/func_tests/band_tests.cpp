@@ -0,0 +1,90 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/band.hpp"
+
+namespace {
+
+// Random n x n matrix with the given band and no diagonal boost.
+std::vector<double> randomBandMatrix(size_t n, size_t kl, size_t ku, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> a(n * n, 0.0);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = (i > kl ? i - kl : 0); j <= std::min(n - 1, i + ku); j++) a[i * n + j] = dist(gen);
+  }
+  return a;
+}
+
+}  // namespace
+
+TEST(band_kernel, detects_lower_and_upper_bandwidth) {
+  const size_t n = 12;
+  auto a = randomBandMatrix(n, 2, 4, 1);
+  auto band = ppc::core::kernels::detectBandwidth(n, a.data(), n);
+  EXPECT_EQ(band.lower, 2U);
+  EXPECT_EQ(band.upper, 4U);
+  a[11 * n + 3] = 1.0;  // one far entry widens the band
+  band = ppc::core::kernels::detectBandwidth(n, a.data(), n);
+  EXPECT_EQ(band.lower, 8U);
+  EXPECT_EQ(band.upper, 4U);
+  std::vector<double> diagonal(n * n, 0.0);
+  band = ppc::core::kernels::detectBandwidth(n, diagonal.data(), n);
+  EXPECT_EQ(band.lower, 0U);
+  EXPECT_EQ(band.upper, 0U);
+}
+
+TEST(band_kernel, solve_recovers_solution_with_pivoting) {
+  for (auto [kl, ku] : {std::pair<size_t, size_t>{1, 1}, {3, 1}, {0, 2}, {2, 5}}) {
+    const size_t n = 80;
+    auto a = randomBandMatrix(n, kl, ku, 7);
+    if (kl == 0) {
+      // Nothing to pivot; a random triangular matrix is hopelessly ill-conditioned.
+      for (size_t i = 0; i < n; i++) a[i * n + i] += 4.0;
+    }
+    std::vector<double> x(n * 2);
+    for (size_t i = 0; i < x.size(); i++) x[i] = 1.0 + static_cast<double>(i % 9);
+    std::vector<double> b(n * 2, 0.0);
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = 0; j < n; j++) {
+        for (size_t c = 0; c < 2; c++) b[i * 2 + c] += a[i * n + j] * x[j * 2 + c];
+      }
+    }
+    auto lu = ppc::core::kernels::BandMatrix<double>::fromDense(n, a.data(), n, {kl, ku});
+    std::vector<int> pivots(n);
+    ASSERT_TRUE(ppc::core::kernels::bandFactor(lu, pivots.data()));
+    ppc::core::kernels::bandSolve(lu, pivots.data(), b.data(), 2);
+    for (size_t i = 0; i < x.size(); i++) {
+      ASSERT_NEAR(b[i], x[i], 1e-8) << kl << " " << ku << " " << i;
+    }
+  }
+}
+
+TEST(band_kernel, compact_rows_match_dense_input) {
+  const size_t n = 9;
+  const auto a = randomBandMatrix(n, 2, 1, 3);
+  std::vector<double> rows(n * 4, -7.0);  // the out-of-matrix slots are ignored
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = (i > 2 ? i - 2 : 0); j <= std::min(n - 1, i + 1); j++) rows[i * 4 + j + 2 - i] = a[i * n + j];
+  }
+  const auto from_dense = ppc::core::kernels::BandMatrix<double>::fromDense(n, a.data(), n, {2, 1});
+  const auto from_rows = ppc::core::kernels::BandMatrix<double>::fromRows(n, rows.data(), {2, 1});
+  EXPECT_EQ(from_dense.values, from_rows.values);
+  EXPECT_EQ(from_dense.stride(), 6U);
+}
+
+TEST(band_kernel, singular_band_matrix_is_reported) {
+  // Rows 1 and 2 are equal inside the band.
+  std::vector<double> a = {2.0, 1.0, 0.0, 0.0,  //
+                           0.0, 1.0, 1.0, 0.0,  //
+                           0.0, 1.0, 1.0, 0.0,  //
+                           0.0, 0.0, 1.0, 3.0};
+  auto lu = ppc::core::kernels::BandMatrix<double>::fromDense(4, a.data(), 4, {1, 1});
+  std::vector<int> pivots(4);
+  EXPECT_FALSE(ppc::core::kernels::bandFactor(lu, pivots.data()));
+}
@@ -0,0 +1,80 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/batched_gemm.hpp"
+#include "core/kernels/include/gemm.hpp"
+
+namespace {
+
+template <class T>
+std::vector<T> makeBatch(size_t count, size_t rows, size_t cols, size_t seed) {
+  std::vector<T> batch(count * rows * cols);
+  for (size_t i = 0; i < batch.size(); i++) {
+    batch[i] = static_cast<T>(static_cast<int>((i * 29 + seed * 13) % 17) - 8);
+  }
+  return batch;
+}
+
+// Multiplies a batch through the interleaved layout and compares every product
+// with the GEMM kernel.
+template <class T>
+void checkBatch(size_t count, size_t m, size_t n, size_t k, int num_threads) {
+  const auto a = makeBatch<T>(count, m, k, 1);
+  const auto b = makeBatch<T>(count, k, n, 2);
+  const size_t packs = ppc::core::kernels::batchPacks<T>(count);
+  const size_t lanes = ppc::core::kernels::kBatchLanes<T>;
+  std::vector<T> a_packed(packs * lanes * m * k);
+  std::vector<T> b_packed(packs * lanes * k * n);
+  std::vector<T> c_packed(packs * lanes * m * n);
+  ppc::core::kernels::interleaveBatch(count, m, k, a.data(), a_packed.data());
+  ppc::core::kernels::interleaveBatch(count, k, n, b.data(), b_packed.data());
+  ppc::core::kernels::batchedGemm(m, n, k, packs, a_packed.data(), b_packed.data(), c_packed.data(), num_threads);
+  std::vector<T> c(count * m * n);
+  ppc::core::kernels::deinterleaveBatch(count, m, n, c_packed.data(), c.data());
+
+  std::vector<T> expected(m * n);
+  for (size_t matrix = 0; matrix < count; matrix++) {
+    ppc::core::kernels::matmul(m, n, k, a.data() + matrix * m * k, b.data() + matrix * k * n, expected.data());
+    ASSERT_EQ(std::vector<T>(c.begin() + matrix * m * n, c.begin() + (matrix + 1) * m * n), expected)
+        << "matrix " << matrix;
+  }
+}
+
+}  // namespace
+
+template <class T>
+class batched_gemm_kernel : public ::testing::Test {};
+
+using BatchedGemmTypes = ::testing::Types<int32_t, float, double>;
+TYPED_TEST_SUITE(batched_gemm_kernel, BatchedGemmTypes);
+
+TYPED_TEST(batched_gemm_kernel, check_compile_time_sizes) {
+  for (size_t size : {4, 8, 16, 32}) {
+    checkBatch<TypeParam>(37, size, size, size, 1);
+  }
+}
+
+TYPED_TEST(batched_gemm_kernel, check_run_time_sizes) {
+  checkBatch<TypeParam>(21, 3, 5, 2, 1);
+  checkBatch<TypeParam>(1, 7, 1, 6, 1);
+}
+
+TYPED_TEST(batched_gemm_kernel, check_split_between_threads) { checkBatch<TypeParam>(5000, 4, 4, 4, 3); }
+
+TEST(batched_gemm_layout, interleave_round_trip_pads_last_pack) {
+  const size_t count = 11;
+  const auto batch = makeBatch<double>(count, 2, 3, 4);
+  const size_t lanes = ppc::core::kernels::kBatchLanes<double>;
+  std::vector<double> packed(ppc::core::kernels::batchPacks<double>(count) * lanes * 6, -1.0);
+  ppc::core::kernels::interleaveBatch(count, 2, 3, batch.data(), packed.data());
+  // Element 0 of matrix 5 sits in lane 5 % lanes of pack 5 / lanes.
+  EXPECT_EQ(packed[(5 / lanes) * lanes * 6 + 5 % lanes], batch[5 * 6]);
+  EXPECT_EQ(packed.back(), 0.0);
+
+  std::vector<double> restored(batch.size());
+  ppc::core::kernels::deinterleaveBatch(count, 2, 3, packed.data(), restored.data());
+  EXPECT_EQ(restored, batch);
+}
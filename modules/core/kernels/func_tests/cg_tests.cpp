@@ -0,0 +1,81 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "core/kernels/include/cg.hpp"
+
+namespace {
+
+// Tridiagonal [-1, 2, -1] matrix of order n, SPD with condition ~n^2.
+void multiplyTridiagonal(size_t n, const double* u, double* w) {
+  for (size_t i = 0; i < n; i++) {
+    w[i] = 2.0 * u[i] - (i > 0 ? u[i - 1] : 0.0) - (i + 1 < n ? u[i + 1] : 0.0);
+  }
+}
+
+}  // namespace
+
+TEST(cg_kernel, block_jacobi_solves_its_own_blocks) {
+  // Two 2 x 2 blocks and a trailing 1 x 1 block.
+  const size_t n = 5;
+  const std::vector<double> a = {4, 1, 0, 0, 0,  //
+                                 1, 3, 0, 0, 0,  //
+                                 0, 0, 5, 2, 0,  //
+                                 0, 0, 2, 6, 0,  //
+                                 0, 0, 0, 0, 7};
+  ppc::core::kernels::BlockJacobiPreconditioner<double> preconditioner;
+  ASSERT_TRUE(preconditioner.factorise(n, 2, [&](size_t i, size_t j) { return a[i * n + j]; }));
+  const std::vector<double> r = {5, 4, 7, 8, 7};
+  std::vector<double> u(n);
+  preconditioner.apply(r.data(), u.data());
+  for (size_t i = 0; i < n; i++) {
+    EXPECT_NEAR(u[i], 1.0, 1e-14) << i;
+  }
+}
+
+TEST(cg_kernel, block_jacobi_rejects_indefinite_block) {
+  ppc::core::kernels::BlockJacobiPreconditioner<double> preconditioner;
+  EXPECT_FALSE(preconditioner.factorise(2, 2, [](size_t i, size_t j) { return i == j ? 1.0 : 2.0; }));
+}
+
+TEST(cg_kernel, pcg_solves_tridiagonal_system) {
+  for (int num_threads : {1, 3}) {
+    const size_t n = 200;
+    std::vector<double> solution(n);
+    for (size_t i = 0; i < n; i++) solution[i] = std::sin(static_cast<double>(i));
+    std::vector<double> b(n);
+    multiplyTridiagonal(n, solution.data(), b.data());
+    ppc::core::kernels::BlockJacobiPreconditioner<double> preconditioner;
+    ASSERT_TRUE(preconditioner.factorise(n, 1, [](size_t i, size_t j) { return i == j ? 2.0 : -1.0; }));
+    std::vector<double> x(n);
+    int reductions = 0;
+    const auto result = ppc::core::kernels::pcgSolve(
+        n, b.data(), x.data(), [&](const double* u, double* w) { multiplyTridiagonal(n, u, w); },
+        [&](const double* r, double* u) { preconditioner.apply(r, u); },
+        [&](std::array<double, 3>& /*sums*/) { reductions++; }, 1e-12, 1000, num_threads);
+    EXPECT_TRUE(result.converged);
+    // One reduction per iteration plus the initial one; CG needs at most n
+    // iterations in exact arithmetic.
+    EXPECT_EQ(reductions, result.iterations + 1);
+    EXPECT_LE(result.iterations, static_cast<int>(n) + 20);
+    for (size_t i = 0; i < n; i++) {
+      ASSERT_NEAR(x[i], solution[i], 1e-8);
+    }
+  }
+}
+
+TEST(cg_kernel, pcg_reports_non_convergence) {
+  const size_t n = 100;
+  const std::vector<double> b(n, 1.0);
+  std::vector<double> x(n);
+  const auto result = ppc::core::kernels::pcgSolve(
+      n, b.data(), x.data(), [&](const double* u, double* w) { multiplyTridiagonal(n, u, w); },
+      [&](const double* r, double* u) { std::copy(r, r + n, u); }, [](std::array<double, 3>& /*sums*/) {}, 1e-12, 5);
+  EXPECT_FALSE(result.converged);
+  EXPECT_EQ(result.iterations, 5);
+  EXPECT_GT(result.residual, 1e-12);
+}
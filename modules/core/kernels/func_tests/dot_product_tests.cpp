@@ -0,0 +1,117 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "core/kernels/include/dot_product.hpp"
+
+TEST(dot_product_kernel, check_int32_t_all_tail_lengths) {
+  for (size_t n = 0; n < 40; n++) {
+    std::vector<int32_t> a(n);
+    std::vector<int32_t> b(n);
+    int64_t expected = 0;
+    for (size_t i = 0; i < n; i++) {
+      a[i] = static_cast<int32_t>(i) - 7;
+      b[i] = 3 * static_cast<int32_t>(i) + 1;
+      expected += static_cast<int64_t>(a[i]) * b[i];
+    }
+    EXPECT_EQ(ppc::core::kernels::dot(a.data(), b.data(), n), expected);
+  }
+}
+
+TEST(dot_product_kernel, check_int32_t_widens_to_int64) {
+  const size_t n = 1000;
+  std::vector<int32_t> a(n, std::numeric_limits<int32_t>::max());
+  std::vector<int32_t> b(n, 2);
+  auto result = ppc::core::kernels::dot(a.data(), b.data(), n);
+  static_assert(std::is_same_v<decltype(result), int64_t>);
+  EXPECT_EQ(result, static_cast<int64_t>(std::numeric_limits<int32_t>::max()) * 2 * static_cast<int64_t>(n));
+}
+
+TEST(dot_product_kernel, check_int16_t) {
+  const size_t n = 5000;
+  std::vector<int16_t> a(n, -32768);
+  std::vector<int16_t> b(n, -32768);
+  EXPECT_EQ(ppc::core::kernels::dot(a.data(), b.data(), n), int64_t{32768} * 32768 * static_cast<int64_t>(n));
+}
+
+TEST(dot_product_kernel, check_uint8_t) {
+  const size_t n = 333;
+  std::vector<uint8_t> a(n, 255);
+  std::vector<uint8_t> b(n, 255);
+  EXPECT_EQ(ppc::core::kernels::dot(a.data(), b.data(), n), uint64_t{255} * 255 * n);
+}
+
+TEST(dot_product_kernel, check_double) {
+  const size_t n = 10001;
+  std::vector<double> a(n, 1.1);
+  std::vector<double> b(n, 1.3);
+  EXPECT_NEAR(ppc::core::kernels::dot(a.data(), b.data(), n), n * 1.1 * 1.3, 1e-8);
+}
+
+TEST(dot_product_kernel, check_float_is_more_accurate_than_single_chain) {
+  const size_t n = 1 << 20;
+  std::vector<float> a(n, 1.0f);
+  std::vector<float> b(n, 0.1f);
+  float single_chain = 0.0f;
+  for (size_t i = 0; i < n; i++) {
+    single_chain += a[i] * b[i];
+  }
+  const double expected = static_cast<double>(n) * static_cast<double>(0.1f);
+  const float result = ppc::core::kernels::dot(a.data(), b.data(), n);
+  EXPECT_LE(std::abs(result - expected), std::abs(single_chain - expected));
+  EXPECT_NEAR(result, expected, expected * 5e-3);
+}
+
+TEST(dot_product_kernel, check_float_with_double_accumulator) {
+  const size_t n = 1 << 20;
+  std::vector<float> a(n, 1.0f);
+  std::vector<float> b(n, 0.1f);
+  const auto result = ppc::core::kernels::dot<float, double>(a.data(), b.data(), n);
+  static_assert(std::is_same_v<decltype(result), const double>);
+  const double expected = static_cast<double>(n) * static_cast<double>(0.1f);
+  EXPECT_NEAR(result, expected, expected * 1e-12);
+}
+
+TEST(dot_product_kernel, check_pairs) {
+  const size_t n = 13;
+  const size_t count = 7;
+  std::vector<int32_t> a(n * count);
+  std::vector<int32_t> b(n * count);
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<int32_t>(i % 11) - 5;
+    b[i] = static_cast<int32_t>(i % 7) + 2;
+  }
+  std::vector<int64_t> out(count);
+  ppc::core::kernels::dotPairs(a.data(), b.data(), n, count, out.data());
+  for (size_t p = 0; p < count; p++) {
+    EXPECT_EQ(out[p], ppc::core::kernels::dot(a.data() + p * n, b.data() + p * n, n));
+  }
+}
+
+TEST(dot_product_kernel, check_many_against_query) {
+  const size_t n = 37;
+  for (size_t count : {0, 1, 4, 9}) {
+    std::vector<double> query(n);
+    std::vector<double> rows(n * count);
+    for (size_t i = 0; i < n; i++) {
+      query[i] = 0.5 * static_cast<double>(i) - 3.0;
+    }
+    for (size_t i = 0; i < rows.size(); i++) {
+      rows[i] = static_cast<double>(i % 5) * 0.25;
+    }
+    std::vector<double> out(count);
+    ppc::core::kernels::dotMany(query.data(), rows.data(), n, count, out.data());
+    for (size_t r = 0; r < count; r++) {
+      double expected = 0.0;
+      for (size_t i = 0; i < n; i++) {
+        expected += query[i] * rows[r * n + i];
+      }
+      EXPECT_NEAR(out[r], expected, 1e-9);
+    }
+  }
+}
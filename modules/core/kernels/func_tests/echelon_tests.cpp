@@ -0,0 +1,84 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "core/kernels/include/echelon.hpp"
+
+namespace {
+
+// rows x cols product of random rows x rank and rank x cols factors.
+std::vector<double> lowRankMatrix(size_t rows, size_t cols, size_t rank, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> left(rows * rank);
+  std::vector<double> right(rank * cols);
+  for (auto& value : left) value = dist(gen);
+  for (auto& value : right) value = dist(gen);
+  std::vector<double> a(rows * cols, 0.0);
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t k = 0; k < rank; k++) {
+      for (size_t j = 0; j < cols; j++) a[i * cols + j] += left[i * rank + k] * right[k * cols + j];
+    }
+  }
+  return a;
+}
+
+}  // namespace
+
+TEST(echelon_kernel, full_rank_square_matches_lu_determinant) {
+  const size_t n = 45;
+  auto a = lowRankMatrix(n, n, n, 3);
+  const auto det = ppc::core::kernels::LuFactors<double>::factorise(n, a.data()).determinant();
+  const auto result = ppc::core::kernels::rowEchelon(n, n, a.data(), n);
+  EXPECT_EQ(result.rank, n);
+  EXPECT_EQ(result.determinant.sign, det.sign);
+  EXPECT_NEAR(result.determinant.log_abs, det.log_abs, 1e-9);
+}
+
+TEST(echelon_kernel, rank_deficient_matrices) {
+  for (size_t rank : {0U, 1U, 7U, 19U}) {
+    auto square = lowRankMatrix(20, 20, rank, 5);
+    const auto result = ppc::core::kernels::rowEchelon(20, 20, square.data(), 20);
+    EXPECT_EQ(result.rank, rank);
+    if (rank < 20) {
+      EXPECT_EQ(result.determinant.value(), 0.0);
+    }
+  }
+  auto tall = lowRankMatrix(30, 8, 5, 7);
+  EXPECT_EQ(ppc::core::kernels::rowEchelon(30, 8, tall.data(), 8).rank, 5U);
+  auto wide = lowRankMatrix(6, 25, 6, 9);
+  EXPECT_EQ(ppc::core::kernels::rowEchelon(6, 25, wide.data(), 25).rank, 6U);
+}
+
+TEST(echelon_kernel, pivots_on_largest_entry) {
+  // The first column is zero; the largest entry, 6, is eliminated first.
+  std::vector<double> a = {0.0, 2.0, 1.0, 0.0,  //
+                           0.0, 4.0, 2.0, 6.0,  //
+                           0.0, 2.0, 1.0, 1.0};
+  EXPECT_EQ(ppc::core::kernels::rowEchelon(3, 4, a.data(), 4).rank, 2U);
+  EXPECT_EQ(a[0], 6.0);
+  EXPECT_EQ(a[4], 0.0);
+  EXPECT_EQ(a[8], 0.0);
+  EXPECT_EQ(a[10], 0.0);  // the third row is eliminated by the second pivot
+  EXPECT_EQ(a[11], 0.0);
+}
+
+TEST(echelon_kernel, rank_of_many_random_low_rank_matrices) {
+  // Partial pivoting gets a few percent of these wrong; complete pivoting
+  // none.
+  for (unsigned seed = 0; seed < 200; seed++) {
+    auto a = lowRankMatrix(40, 40, 23, seed);
+    ASSERT_EQ(ppc::core::kernels::rowEchelon(40, 40, a.data(), 40).rank, 23U) << seed;
+  }
+}
+
+TEST(echelon_kernel, tolerance_decides_numerical_rank) {
+  std::vector<double> a = {1.0, 0.0, 0.0, 1e-9};
+  auto copy = a;
+  EXPECT_EQ(ppc::core::kernels::rowEchelon(2, 2, copy.data(), 2).rank, 2U);
+  copy = a;
+  EXPECT_EQ(ppc::core::kernels::rowEchelon(2, 2, copy.data(), 2, 1e-6).rank, 1U);
+}
@@ -0,0 +1,88 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/gemm.hpp"
+#include "core/testing/include/compare.hpp"
+
+namespace {
+
+template <class T>
+std::vector<T> naiveMatmul(size_t m, size_t n, size_t k, const std::vector<T>& a, const std::vector<T>& b) {
+  std::vector<T> c(m * n, T{});
+  for (size_t i = 0; i < m; i++) {
+    for (size_t p = 0; p < k; p++) {
+      for (size_t j = 0; j < n; j++) {
+        c[i * n + j] += a[i * k + p] * b[p * n + j];
+      }
+    }
+  }
+  return c;
+}
+
+}  // namespace
+
+template <class T>
+class gemm_kernel : public ::testing::Test {};
+
+using GemmTypes = ::testing::Types<int32_t, int64_t, float, double>;
+TYPED_TEST_SUITE(gemm_kernel, GemmTypes);
+
+TYPED_TEST(gemm_kernel, check_edge_sizes) {
+  using T = TypeParam;
+  for (size_t m : {1, 3, 4, 5, 17}) {
+    for (size_t n : {1, 7, 16, 33}) {
+      for (size_t k : {1, 2, 9}) {
+        auto a = ppc::core::testing::getExactRandomVector<T>(m * k, 10, 1);
+        auto b = ppc::core::testing::getExactRandomVector<T>(k * n, 10, 2);
+        std::vector<T> c(m * n);
+        ppc::core::kernels::matmul(m, n, k, a.data(), b.data(), c.data());
+        ASSERT_EQ(c, naiveMatmul(m, n, k, a, b)) << m << "x" << n << "x" << k;
+      }
+    }
+  }
+}
+
+TYPED_TEST(gemm_kernel, check_sizes_crossing_all_blocks) {
+  using T = TypeParam;
+  const size_t m = ppc::core::kernels::kGemmMc + 13;
+  const size_t n = ppc::core::kernels::kGemmNc + 29;
+  const size_t k = ppc::core::kernels::kGemmKc + 7;
+  auto a = ppc::core::testing::getExactRandomVector<T>(m * k, 10, 3);
+  auto b = ppc::core::testing::getExactRandomVector<T>(k * n, 10, 4);
+  std::vector<T> c(m * n);
+  ppc::core::kernels::matmul(m, n, k, a.data(), b.data(), c.data());
+  EXPECT_EQ(c, naiveMatmul(m, n, k, a, b));
+}
+
+TEST(gemm_kernel_strides, check_accumulates_into_submatrix) {
+  // C[1..4) x [2..7) of a 5 x 9 matrix += A * B, where A and B are themselves
+  // blocks of wider matrices.
+  const size_t m = 3;
+  const size_t n = 5;
+  const size_t k = 6;
+  auto big_a = ppc::core::testing::getExactRandomVector<int>(m * (k + 4), 10, 5);
+  auto big_b = ppc::core::testing::getExactRandomVector<int>(k * (n + 3), 10, 6);
+  std::vector<int> big_c(5 * 9, 1);
+  ppc::core::kernels::gemm(m, n, k, big_a.data() + 2, k + 4, big_b.data() + 1, n + 3, big_c.data() + 9 + 2, 9);
+
+  for (size_t i = 0; i < 5; i++) {
+    for (size_t j = 0; j < 9; j++) {
+      int expected = 1;
+      if (i >= 1 && i < 1 + m && j >= 2 && j < 2 + n) {
+        for (size_t p = 0; p < k; p++) {
+          expected += big_a[(i - 1) * (k + 4) + 2 + p] * big_b[p * (n + 3) + 1 + (j - 2)];
+        }
+      }
+      ASSERT_EQ(big_c[i * 9 + j], expected) << i << "," << j;
+    }
+  }
+}
+
+TEST(gemm_kernel_strides, check_empty_dimension_is_noop) {
+  std::vector<double> c(4, 2.0);
+  ppc::core::kernels::gemm<double>(2, 2, 0, nullptr, 0, nullptr, 2, c.data(), 2);
+  EXPECT_EQ(c, std::vector<double>(4, 2.0));
+}
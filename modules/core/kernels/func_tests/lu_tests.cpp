@@ -0,0 +1,261 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "core/kernels/include/lu.hpp"
+
+namespace {
+
+std::vector<double> randomMatrix(size_t n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> a(n * n);
+  for (auto& value : a) value = dist(gen);
+  return a;
+}
+
+// max |P A - L U| for the factors of luFactor().
+double factorisationError(size_t n, const std::vector<double>& a, const std::vector<double>& lu,
+                          const std::vector<int>& pivots) {
+  std::vector<double> pa = a;
+  ppc::core::kernels::swapRows(n, pa.data(), n, pivots.data(), 0, n);
+  double error = 0.0;
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      double sum = 0.0;
+      for (size_t p = 0; p <= std::min(i, j); p++) {
+        sum += (p == i ? 1.0 : lu[i * n + p]) * lu[p * n + j];
+      }
+      error = std::max(error, std::abs(pa[i * n + j] - sum));
+    }
+  }
+  return error;
+}
+
+}  // namespace
+
+TEST(lu_kernel, panel_picks_largest_pivot) {
+  // The first column's largest entry is in row 2, the second's (after the
+  // swap and elimination) in row 2 again.
+  std::vector<double> a = {1.0, 2.0,  //
+                           2.0, 1.0,  //
+                           4.0, 0.0};
+  std::vector<int> pivots(2);
+  ASSERT_TRUE(ppc::core::kernels::luPanel(3, 2, a.data(), 2, pivots.data()));
+  EXPECT_EQ(pivots, (std::vector<int>{2, 2}));
+  EXPECT_DOUBLE_EQ(a[0], 4.0);
+  EXPECT_DOUBLE_EQ(a[2], 0.25);
+  EXPECT_DOUBLE_EQ(a[3], 2.0);
+  EXPECT_DOUBLE_EQ(a[4], 0.5);
+  EXPECT_DOUBLE_EQ(a[5], 0.5);
+}
+
+TEST(lu_kernel, blocked_factorisation_matches_matrix) {
+  for (size_t block : {1, 7, 64}) {
+    const size_t n = 150;
+    const auto a = randomMatrix(n, 3);
+    auto lu = a;
+    std::vector<int> pivots(n);
+    ASSERT_TRUE(ppc::core::kernels::luFactor(n, lu.data(), n, pivots.data(), block));
+    EXPECT_LT(factorisationError(n, a, lu, pivots), 1e-12) << block;
+  }
+}
+
+TEST(lu_kernel, blocked_and_unblocked_give_same_factors) {
+  const size_t n = 70;
+  const auto a = randomMatrix(n, 5);
+  auto blocked = a;
+  auto unblocked = a;
+  std::vector<int> blocked_pivots(n);
+  std::vector<int> unblocked_pivots(n);
+  ppc::core::kernels::luFactor(n, blocked.data(), n, blocked_pivots.data(), 16);
+  ppc::core::kernels::luPanel(n, n, unblocked.data(), n, unblocked_pivots.data());
+  EXPECT_EQ(blocked_pivots, unblocked_pivots);
+  for (size_t i = 0; i < n * n; i++) {
+    ASSERT_NEAR(blocked[i], unblocked[i], 1e-12) << i;
+  }
+}
+
+TEST(lu_kernel, solve_recovers_solution) {
+  const size_t n = 97;
+  const auto a = randomMatrix(n, 7);
+  std::vector<double> x(n);
+  for (size_t i = 0; i < n; i++) x[i] = std::sin(static_cast<double>(i));
+  std::vector<double> b(n, 0.0);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) b[i] += a[i * n + j] * x[j];
+  }
+  auto lu = a;
+  std::vector<int> pivots(n);
+  ASSERT_TRUE(ppc::core::kernels::luFactor(n, lu.data(), n, pivots.data(), 32));
+  ppc::core::kernels::luSolve(n, lu.data(), n, pivots.data(), b.data());
+  for (size_t i = 0; i < n; i++) {
+    EXPECT_NEAR(b[i], x[i], 1e-10) << i;
+  }
+}
+
+TEST(lu_kernel, singular_matrix_is_reported) {
+  // Second row = 2 * first row; the elimination gives an exact zero pivot.
+  std::vector<double> a = {1.0, 2.0, 3.0,  //
+                           2.0, 4.0, 6.0,  //
+                           1.0, 0.0, 1.0};
+  std::vector<int> pivots(3);
+  EXPECT_FALSE(ppc::core::kernels::luFactor(3, a.data(), 3, pivots.data(), 2));
+}
+
+TEST(lu_kernel, batched_solve_matches_single_solves) {
+  const size_t n = 60;
+  const size_t nrhs = 9;
+  const auto a = randomMatrix(n, 11);
+  const auto b = randomMatrix(n, 13);  // the first nrhs columns are used
+  auto lu = a;
+  std::vector<int> pivots(n);
+  ASSERT_TRUE(ppc::core::kernels::luFactor(n, lu.data(), n, pivots.data(), 16));
+  std::vector<double> batch(n * nrhs);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t r = 0; r < nrhs; r++) batch[i * nrhs + r] = b[i * n + r];
+  }
+  ppc::core::kernels::luSolve(n, lu.data(), n, pivots.data(), batch.data(), nrhs, nrhs, 3);
+  for (size_t r = 0; r < nrhs; r++) {
+    std::vector<double> single(n);
+    for (size_t i = 0; i < n; i++) single[i] = b[i * n + r];
+    ppc::core::kernels::luSolve(n, lu.data(), n, pivots.data(), single.data());
+    for (size_t i = 0; i < n; i++) {
+      ASSERT_NEAR(batch[i * nrhs + r], single[i], 1e-12) << r << " " << i;
+    }
+  }
+}
+
+TEST(lu_kernel, fingerprint_sees_every_value) {
+  auto a = randomMatrix(5, 17);
+  const auto original = ppc::core::kernels::fingerprint(a.data(), a.size());
+  EXPECT_EQ(ppc::core::kernels::fingerprint(a.data(), a.size()), original);
+  a[24] = std::nextafter(a[24], 2.0);
+  EXPECT_NE(ppc::core::kernels::fingerprint(a.data(), a.size()), original);
+  EXPECT_NE(ppc::core::kernels::fingerprint(a.data(), a.size() - 1), original);
+}
+
+TEST(lu_kernel, cache_reuses_factors_of_the_same_matrix) {
+  const size_t n = 40;
+  const auto a = randomMatrix(n, 19);
+  const auto other = randomMatrix(n, 23);
+  ppc::core::kernels::LuFactorCache<double> cache(1);
+  const auto first = cache.factorise(n, a.data());
+  EXPECT_EQ(cache.factorise(n, a.data()), first);
+  EXPECT_EQ(cache.hits(), 1U);
+  EXPECT_EQ(cache.misses(), 1U);
+  // The capacity is one entry, so the other matrix evicts the first.
+  EXPECT_NE(cache.factorise(n, other.data()), first);
+  EXPECT_NE(cache.factorise(n, a.data()), first);
+  EXPECT_EQ(cache.misses(), 3U);
+  EXPECT_EQ(cache.size(), 1U);
+  EXPECT_TRUE(first->regular);
+}
+
+TEST(lu_kernel, mixed_precision_refines_to_double_accuracy) {
+  const size_t n = 120;
+  const size_t nrhs = 3;
+  auto a = randomMatrix(n, 29);
+  for (size_t i = 0; i < n; i++) a[i * n + i] += 4.0;
+  std::vector<double> x(n * nrhs);
+  for (size_t i = 0; i < x.size(); i++) x[i] = std::cos(static_cast<double>(i));
+  std::vector<double> b(n * nrhs, 0.0);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      for (size_t r = 0; r < nrhs; r++) b[i * nrhs + r] += a[i * n + j] * x[j * nrhs + r];
+    }
+  }
+  ppc::core::kernels::RefinementResult result;
+  ASSERT_TRUE(ppc::core::kernels::luSolveMixed<float>(n, a.data(), b.data(), nrhs, result));
+  EXPECT_TRUE(result.converged);
+  EXPECT_FALSE(result.fell_back);
+  EXPECT_GE(result.iterations, 1);
+  EXPECT_LT(result.residual, 1e-14);
+  for (size_t i = 0; i < x.size(); i++) {
+    ASSERT_NEAR(b[i], x[i], 1e-12) << i;
+  }
+}
+
+TEST(lu_kernel, mixed_precision_falls_back_on_ill_conditioned_matrix) {
+  // The 10 x 10 Hilbert matrix has a condition number near 1e13, far beyond
+  // what float factors can refine.
+  const size_t n = 10;
+  std::vector<double> a(n * n);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) a[i * n + j] = 1.0 / static_cast<double>(i + j + 1);
+  }
+  std::vector<double> b(n, 1.0);
+  ppc::core::kernels::RefinementResult result;
+  ASSERT_TRUE(ppc::core::kernels::luSolveMixed<float>(n, a.data(), b.data(), 1, result));
+  EXPECT_FALSE(result.converged);
+  EXPECT_TRUE(result.fell_back);
+  EXPECT_LT(result.residual, 1e-14);
+}
+
+TEST(lu_kernel, transposed_solve_recovers_solution) {
+  const size_t n = 83;
+  const auto a = randomMatrix(n, 29);
+  std::vector<double> x(n);
+  for (size_t i = 0; i < n; i++) x[i] = std::cos(static_cast<double>(i));
+  std::vector<double> b(n, 0.0);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) b[j] += a[i * n + j] * x[i];
+  }
+  auto lu = a;
+  std::vector<int> pivots(n);
+  ASSERT_TRUE(ppc::core::kernels::luFactor(n, lu.data(), n, pivots.data(), 16));
+  ppc::core::kernels::luSolveTransposed(n, lu.data(), n, pivots.data(), b.data());
+  for (size_t i = 0; i < n; i++) {
+    EXPECT_NEAR(b[i], x[i], 1e-10) << i;
+  }
+}
+
+TEST(lu_kernel, determinant_from_factors) {
+  // det = 1 * (5 * 10 - 6 * 8) - 2 * (4 * 10 - 6 * 7) + 3 * (4 * 8 - 5 * 7) = -3
+  const std::vector<double> a = {1.0, 2.0, 3.0,  //
+                                 4.0, 5.0, 6.0,  //
+                                 7.0, 8.0, 10.0};
+  const auto factors = ppc::core::kernels::LuFactors<double>::factorise(3, a.data());
+  const auto det = factors.determinant();
+  EXPECT_EQ(det.sign, -1);
+  EXPECT_NEAR(det.value(), -3.0, 1e-12);
+
+  const std::vector<double> singular = {1.0, 2.0, 2.0, 4.0};
+  EXPECT_EQ(ppc::core::kernels::LuFactors<double>::factorise(2, singular.data()).determinant().value(), 0.0);
+}
+
+TEST(lu_kernel, determinant_does_not_overflow) {
+  // 400 x 400 diagonal of 10s: det = 1e400, beyond double, log_abs = 400 ln 10.
+  const size_t n = 400;
+  std::vector<double> a(n * n, 0.0);
+  for (size_t i = 0; i < n; i++) a[i * n + i] = i == 0 ? -10.0 : 10.0;
+  const auto det = ppc::core::kernels::LuFactors<double>::factorise(n, a.data()).determinant();
+  EXPECT_EQ(det.sign, -1);
+  EXPECT_NEAR(det.log_abs, 400.0 * std::log(10.0), 1e-9);
+}
+
+TEST(lu_kernel, condition_estimate_is_close_to_exact) {
+  const size_t n = 50;
+  auto a = randomMatrix(n, 31);
+  // Scaling the columns makes the condition number grow by about 1e4.
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) a[i * n + j] *= std::pow(10.0, -4.0 * static_cast<double>(j) / (n - 1));
+  }
+  const auto factors = ppc::core::kernels::LuFactors<double>::factorise(n, a.data());
+  std::vector<double> inverse(n * n, 0.0);
+  for (size_t i = 0; i < n; i++) inverse[i * n + i] = 1.0;
+  factors.solve(inverse.data(), n);
+  const double exact =
+      ppc::core::kernels::oneNorm(n, n, a.data(), n) * ppc::core::kernels::oneNorm(n, n, inverse.data(), n);
+  const double estimate = factors.conditionEstimate();
+  EXPECT_LE(estimate, exact * (1.0 + 1e-10));
+  EXPECT_GE(estimate, exact / 3.0);
+
+  const std::vector<double> diagonal = {4.0, 0.0, 0.0, -0.5};
+  EXPECT_NEAR(ppc::core::kernels::LuFactors<double>::factorise(2, diagonal.data()).conditionEstimate(), 8.0, 1e-12);
+  const std::vector<double> singular = {1.0, 2.0, 2.0, 4.0};
+  EXPECT_TRUE(std::isinf(ppc::core::kernels::LuFactors<double>::factorise(2, singular.data()).conditionEstimate()));
+}
@@ -0,0 +1,66 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "core/kernels/include/reduce.hpp"
+#include "core/kernels/include/simd.hpp"
+
+template <class T>
+class reduce_kernel : public ::testing::Test {};
+
+using ReduceTypes = ::testing::Types<int8_t, int16_t, int32_t, int64_t, uint8_t, float, double>;
+TYPED_TEST_SUITE(reduce_kernel, ReduceTypes);
+
+TYPED_TEST(reduce_kernel, check_all_tail_lengths) {
+  using T = TypeParam;
+  for (size_t n = 1; n < 3 * ppc::core::kernels::kSimdLanes<T>; n++) {
+    std::vector<T> data(n);
+    ppc::core::kernels::WideningAccumulatorT<T> expected_sum = 0;
+    T expected_min = std::numeric_limits<T>::max();
+    T expected_max = std::numeric_limits<T>::lowest();
+    for (size_t i = 0; i < n; i++) {
+      data[i] = static_cast<T>((i * 37) % 101);
+      expected_sum += data[i];
+      expected_min = std::min(expected_min, data[i]);
+      expected_max = std::max(expected_max, data[i]);
+    }
+    EXPECT_EQ(ppc::core::kernels::sum(data.data(), n), expected_sum);
+    EXPECT_EQ(ppc::core::kernels::minimum(data.data(), n), expected_min);
+    EXPECT_EQ(ppc::core::kernels::maximum(data.data(), n), expected_max);
+  }
+}
+
+TYPED_TEST(reduce_kernel, check_empty_range) {
+  using T = TypeParam;
+  EXPECT_EQ(ppc::core::kernels::sum<T>(nullptr, 0), ppc::core::kernels::WideningAccumulatorT<T>{});
+  EXPECT_EQ(ppc::core::kernels::minimum<T>(nullptr, 0), std::numeric_limits<T>::max());
+  EXPECT_EQ(ppc::core::kernels::maximum<T>(nullptr, 0), std::numeric_limits<T>::lowest());
+}
+
+TYPED_TEST(reduce_kernel, check_sum_of_extreme_values_is_exact) {
+  using T = TypeParam;
+  using Acc = ppc::core::kernels::WideningAccumulatorT<T>;
+  if constexpr (std::is_integral_v<T>) {
+    // Long enough to span several of the 32-bit blocks of narrow sums.
+    const size_t n = sizeof(T) == 1 ? (size_t{1} << 25) + 3 : 200003;
+    for (T value : {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()}) {
+      std::vector<T> data(n, value);
+      EXPECT_EQ(ppc::core::kernels::sum(data.data(), n), static_cast<Acc>(value) * static_cast<Acc>(n));
+    }
+  }
+}
+
+TEST(reduce_kernel_sum, check_int8_t_does_not_overflow) {
+  std::vector<int8_t> data(100000, 127);
+  EXPECT_EQ(ppc::core::kernels::sum(data.data(), data.size()), int64_t{127} * 100000);
+}
+
+TEST(reduce_kernel_sum, check_int16_t_negative) {
+  std::vector<int16_t> data(70000, -32768);
+  EXPECT_EQ(ppc::core::kernels::sum(data.data(), data.size()), int64_t{-32768} * 70000);
+}
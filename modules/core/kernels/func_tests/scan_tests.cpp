@@ -0,0 +1,141 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/scan.hpp"
+#include "core/kernels/include/simd.hpp"
+
+namespace {
+
+template <class T, class Out>
+std::vector<Out> serialInclusive(const std::vector<T>& data, Out offset = Out{}) {
+  std::vector<Out> res(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    offset += static_cast<Out>(data[i]);
+    res[i] = offset;
+  }
+  return res;
+}
+
+template <class T>
+std::vector<T> makeData(size_t n) {
+  std::vector<T> data(n);
+  for (size_t i = 0; i < n; i++) {
+    data[i] = static_cast<T>(static_cast<int>((i * 37) % 101) - 50);
+  }
+  return data;
+}
+
+}  // namespace
+
+template <class T>
+class scan_kernel : public ::testing::Test {};
+
+using ScanTypes = ::testing::Types<int8_t, int16_t, int32_t, int64_t, float, double>;
+TYPED_TEST_SUITE(scan_kernel, ScanTypes);
+
+TYPED_TEST(scan_kernel, check_inclusive_all_tail_lengths) {
+  using T = TypeParam;
+  using Out = ppc::core::kernels::WideningAccumulatorT<T>;
+  for (size_t n = 0; n < 3 * ppc::core::kernels::kSimdLanes<Out>; n++) {
+    auto data = makeData<T>(n);
+    std::vector<Out> res(n);
+    const Out total = ppc::core::kernels::inclusiveScan(data.data(), n, res.data(), Out{7});
+    const auto expected = serialInclusive<T, Out>(data, Out{7});
+    EXPECT_EQ(res, expected);
+    EXPECT_EQ(total, n == 0 ? Out{7} : expected.back());
+  }
+}
+
+TYPED_TEST(scan_kernel, check_exclusive_all_tail_lengths) {
+  using T = TypeParam;
+  using Out = ppc::core::kernels::WideningAccumulatorT<T>;
+  for (size_t n = 1; n < 3 * ppc::core::kernels::kSimdLanes<Out>; n++) {
+    auto data = makeData<T>(n);
+    std::vector<Out> res(n);
+    const Out total = ppc::core::kernels::exclusiveScan(data.data(), n, res.data());
+    const auto inclusive = serialInclusive<T, Out>(data);
+    EXPECT_EQ(res[0], Out{});
+    for (size_t i = 1; i < n; i++) {
+      EXPECT_EQ(res[i], inclusive[i - 1]);
+    }
+    EXPECT_EQ(total, inclusive.back());
+  }
+}
+
+TEST(scan_kernel_inplace, check_exclusive_in_place) {
+  std::vector<int> data = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+  ppc::core::kernels::exclusiveScan(data.data(), data.size(), data.data());
+  std::vector<int> expected = {0, 3, 4, 8, 9, 14, 23, 25, 31, 36, 39};
+  EXPECT_EQ(data, expected);
+}
+
+TEST(scan_kernel_inplace, check_int8_t_widens) {
+  std::vector<int8_t> data(1000, 100);
+  std::vector<int64_t> res(data.size());
+  EXPECT_EQ(ppc::core::kernels::inclusiveScan(data.data(), data.size(), res.data()), int64_t{100000});
+  EXPECT_EQ(res[499], int64_t{50000});
+}
+
+TEST(scan_kernel_parallel, check_inclusive_matches_serial) {
+  const size_t n = 1000003;
+  auto data = makeData<int32_t>(n);
+  std::vector<int64_t> res(n);
+  for (int threads : {1, 2, 3, 8}) {
+    const int64_t total = ppc::core::kernels::parallelInclusiveScan(data.data(), n, res.data(), int64_t{0}, threads);
+    const auto expected = serialInclusive<int32_t, int64_t>(data);
+    ASSERT_EQ(res, expected);
+    ASSERT_EQ(total, expected.back());
+  }
+}
+
+TEST(scan_kernel_parallel, check_exclusive_matches_serial) {
+  const size_t n = 200001;
+  auto data = makeData<int16_t>(n);
+  std::vector<int64_t> res(n);
+  std::vector<int64_t> expected(n);
+  ppc::core::kernels::exclusiveScan(data.data(), n, expected.data(), int64_t{-5});
+  ppc::core::kernels::parallelExclusiveScan(data.data(), n, res.data(), int64_t{-5}, 4);
+  EXPECT_EQ(res, expected);
+}
+
+TEST(scan_kernel_parallel, check_small_range_runs_serially) {
+  std::vector<double> data = {0.5, 0.25, 0.125};
+  std::vector<double> res(data.size());
+  EXPECT_EQ(ppc::core::kernels::parallelInclusiveScan(data.data(), data.size(), res.data(), 0.0, 16), 0.875);
+  EXPECT_EQ(res[1], 0.75);
+}
+
+TEST(scan_kernel_segmented, check_restarts_at_heads) {
+  std::vector<int> data = {1, 2, 3, 4, 5, 6, 7};
+  std::vector<uint8_t> heads = {0, 0, 1, 0, 1, 1, 0};
+  std::vector<int> res(data.size());
+  ppc::core::kernels::SegmentCarry<int> carry{10, 0};
+  carry = ppc::core::kernels::segmentedInclusiveScan(data.data(), heads.data(), data.size(), res.data(), carry);
+  std::vector<int> expected = {11, 13, 3, 7, 5, 6, 13};
+  EXPECT_EQ(res, expected);
+  EXPECT_EQ(carry.value, 13);
+  EXPECT_EQ(carry.has_head, 1);
+}
+
+TEST(scan_kernel_segmented, check_parallel_matches_serial) {
+  const size_t n = 300007;
+  auto data = makeData<int32_t>(n);
+  std::vector<uint8_t> heads(n, 0);
+  // Long head-free stretches make segments cross the thread chunks.
+  for (size_t i = 0; i < n; i += (i % 7 == 0 ? 70001 : 13)) {
+    heads[i] = 1;
+  }
+  std::vector<int64_t> expected(n);
+  std::vector<int64_t> res(n);
+  const auto serial = ppc::core::kernels::segmentedInclusiveScan(data.data(), heads.data(), n, expected.data(),
+                                                                 ppc::core::kernels::SegmentCarry<int64_t>{});
+  for (int threads : {2, 5, 16}) {
+    const auto parallel =
+        ppc::core::kernels::parallelSegmentedInclusiveScan(data.data(), heads.data(), n, res.data(), threads);
+    ASSERT_EQ(res, expected);
+    ASSERT_EQ(parallel.value, serial.value);
+  }
+}
@@ -0,0 +1,110 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "core/kernels/include/sparse.hpp"
+
+TEST(sparse_kernel, from_dense_keeps_non_zeros_in_order) {
+  const std::vector<double> dense = {1.0, 0.0, 2.0,  //
+                                     0.0, 0.0, 0.0,  //
+                                     0.0, 3.0, 4.0};
+  const auto csr = ppc::core::kernels::CsrMatrix<double>::fromDense(3, 3, dense.data());
+  EXPECT_EQ(csr.row_ptr, (std::vector<int>{0, 2, 2, 4}));
+  EXPECT_EQ(csr.col_idx, (std::vector<int>{0, 2, 1, 2}));
+  EXPECT_EQ(csr.values, (std::vector<double>{1.0, 2.0, 3.0, 4.0}));
+  EXPECT_EQ(csr.nnz(), 4U);
+  EXPECT_EQ(csr.at(2, 1), 3.0);
+  EXPECT_EQ(csr.at(1, 1), 0.0);
+}
+
+TEST(sparse_kernel, spmv_matches_dense_product) {
+  const size_t rows = 7;
+  const size_t cols = 5;
+  std::vector<float> dense(rows * cols);
+  for (size_t i = 0; i < dense.size(); i++) {
+    dense[i] = i % 3 == 0 ? static_cast<float>(i % 7) - 3.0F : 0.0F;
+  }
+  const std::vector<float> x = {1.0F, -2.0F, 0.5F, 4.0F, -1.0F};
+  const auto csr = ppc::core::kernels::CsrMatrix<float>::fromDense(rows, cols, dense.data());
+  std::vector<float> y(rows);
+  ppc::core::kernels::spmv(csr, x.data(), y.data());
+  for (size_t i = 0; i < rows; i++) {
+    float expected = 0.0F;
+    for (size_t j = 0; j < cols; j++) expected += dense[i * cols + j] * x[j];
+    EXPECT_FLOAT_EQ(y[i], expected) << i;
+  }
+}
+
+TEST(sparse_kernel, is_valid_csr_rejects_malformed_structure) {
+  const std::vector<int> row_ptr = {0, 2, 3};
+  const std::vector<int> good = {0, 1, 1};
+  const std::vector<int> unsorted = {1, 0, 1};
+  const std::vector<int> out_of_range = {0, 1, 2};
+  EXPECT_TRUE(ppc::core::kernels::isValidCsr(2, 2, 3, row_ptr.data(), good.data()));
+  EXPECT_FALSE(ppc::core::kernels::isValidCsr(2, 2, 3, row_ptr.data(), unsorted.data()));
+  EXPECT_FALSE(ppc::core::kernels::isValidCsr(2, 2, 3, row_ptr.data(), out_of_range.data()));
+  EXPECT_FALSE(ppc::core::kernels::isValidCsr(2, 2, 4, row_ptr.data(), good.data()));
+}
+
+namespace {
+
+// rows x cols matrix whose row i has (i * 7) % 11 non-zeros (at most cols) at
+// spread-out, increasing columns.
+ppc::core::kernels::CsrMatrix<double> makeIrregular(size_t rows, size_t cols) {
+  ppc::core::kernels::CsrMatrix<double> a;
+  a.rows = rows;
+  a.cols = cols;
+  for (size_t i = 0; i < rows; i++) {
+    const size_t count = std::min(cols, (i * 7) % 11);
+    for (size_t k = 0; k < count; k++) {
+      a.col_idx.push_back(static_cast<int>((k * cols) / count + i % (cols / count)));
+      a.values.push_back(static_cast<double>(i + 1) - 0.25 * static_cast<double>(k));
+    }
+    a.row_ptr.push_back(static_cast<int>(a.values.size()));
+  }
+  return a;
+}
+
+}  // namespace
+
+TEST(sparse_kernel, parallel_spmv_matches_serial) {
+  const auto a = makeIrregular(20000, 300);
+  std::vector<double> x(a.cols);
+  for (size_t j = 0; j < x.size(); j++) x[j] = 1.0 / static_cast<double>(j + 1);
+  std::vector<double> expected(a.rows);
+  ppc::core::kernels::spmv(a, x.data(), expected.data());
+  for (int threads : {1, 2, 3, 7}) {
+    std::vector<double> y(a.rows, -1.0);
+    ppc::core::kernels::parallelSpmv(a, x.data(), y.data(), threads);
+    EXPECT_EQ(y, expected) << threads;
+  }
+}
+
+TEST(sparse_kernel, sell_spmv_matches_csr) {
+  const auto a = makeIrregular(37, 23);
+  std::vector<double> x(a.cols);
+  for (size_t j = 0; j < x.size(); j++) x[j] = static_cast<double>(j % 5) - 2.0;
+  std::vector<double> expected(a.rows);
+  ppc::core::kernels::spmv(a, x.data(), expected.data());
+  for (size_t chunk : {1, 4, 8}) {
+    for (size_t sigma : {1, 8, 64}) {
+      const auto sell = ppc::core::kernels::SellMatrix<double>::fromCsr(a, chunk, sigma);
+      std::vector<double> y(a.rows, -1.0);
+      ppc::core::kernels::spmv(sell, x.data(), y.data());
+      EXPECT_EQ(y, expected) << chunk << " " << sigma;
+      ppc::core::kernels::parallelSpmv(sell, x.data(), y.data(), 3);
+      EXPECT_EQ(y, expected) << chunk << " " << sigma;
+    }
+  }
+}
+
+TEST(sparse_kernel, sell_sorting_reduces_padding) {
+  const auto a = makeIrregular(64, 23);
+  const auto unsorted = ppc::core::kernels::SellMatrix<double>::fromCsr(a, 8, 1);
+  const auto sorted = ppc::core::kernels::SellMatrix<double>::fromCsr(a, 8, 64);
+  EXPECT_GE(unsorted.storedEntries(), a.nnz());
+  EXPECT_LT(sorted.storedEntries(), unsorted.storedEntries());
+  EXPECT_EQ(sorted.chunks(), 8U);
+}
@@ -0,0 +1,110 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "core/kernels/include/gemm.hpp"
+#include "core/kernels/include/strassen.hpp"
+#include "core/testing/include/compare.hpp"
+
+namespace {
+
+// Runs the products of a level in reverse order, to check they are independent.
+struct ReverseFork {
+  template <class F1, class F2, class F3, class F4, class F5, class F6, class F7>
+  void operator()(F1&& f1, F2&& f2, F3&& f3, F4&& f4, F5&& f5, F6&& f6, F7&& f7) const {
+    f7();
+    f6();
+    f5();
+    f4();
+    f3();
+    f2();
+    f1();
+  }
+};
+
+}  // namespace
+
+template <class T>
+class strassen_kernel : public ::testing::Test {};
+
+using StrassenTypes = ::testing::Types<int32_t, int64_t, float, double>;
+TYPED_TEST_SUITE(strassen_kernel, StrassenTypes);
+
+TYPED_TEST(strassen_kernel, check_matches_classical_product) {
+  using T = TypeParam;
+  for (size_t n : {1, 2, 7, 16, 33, 64, 100}) {
+    for (size_t crossover : {0, 1, 4, 16}) {
+      auto a = ppc::core::testing::getExactRandomVector<T>(n * n, 10, 1);
+      auto b = ppc::core::testing::getExactRandomVector<T>(n * n, 10, 2);
+      std::vector<T> c(n * n);
+      std::vector<T> reference(n * n);
+      ppc::core::kernels::strassenMatmul(n, a.data(), b.data(), c.data(), crossover);
+      ppc::core::kernels::matmul(n, n, n, a.data(), b.data(), reference.data());
+      ASSERT_EQ(c, reference) << n << " crossover " << crossover;
+    }
+  }
+}
+
+TEST(strassen_kernel_plan, pads_to_leaf_times_power_of_two) {
+  const auto plan = ppc::core::kernels::strassenPlan(100, 16);
+  EXPECT_EQ(plan.leaf, 13U);
+  EXPECT_EQ(plan.levels, 3U);
+  EXPECT_EQ(plan.padded, 104U);
+
+  const auto exact = ppc::core::kernels::strassenPlan(256, 64);
+  EXPECT_EQ(exact.padded, 256U);
+  EXPECT_EQ(exact.leaf, 64U);
+
+  const auto leaf_only = ppc::core::kernels::strassenPlan(50, 64);
+  EXPECT_EQ(leaf_only.levels, 0U);
+  EXPECT_EQ(leaf_only.padded, 50U);
+
+  const auto zero_crossover = ppc::core::kernels::strassenPlan(6, 0);
+  EXPECT_EQ(zero_crossover.leaf, 1U);
+  EXPECT_EQ(zero_crossover.levels, 3U);
+  EXPECT_EQ(zero_crossover.padded, 8U);
+}
+
+TEST(strassen_kernel_fork, check_products_are_independent) {
+  const size_t n = 48;
+  auto a = ppc::core::testing::getExactRandomVector<int>(n * n, 10, 3);
+  auto b = ppc::core::testing::getExactRandomVector<int>(n * n, 10, 4);
+  std::vector<int> c(n * n);
+  std::vector<int> reference(n * n);
+  ppc::core::kernels::strassenMatmul(n, a.data(), b.data(), c.data(), 6, ReverseFork{});
+  ppc::core::kernels::matmul(n, n, n, a.data(), b.data(), reference.data());
+  EXPECT_EQ(c, reference);
+}
+
+TEST(strassen_kernel_error, random_doubles_stay_within_bound) {
+  const size_t n = 192;
+  const size_t crossover = 24;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> a(n * n);
+  std::vector<double> b(n * n);
+  for (auto& value : a) value = dist(gen);
+  for (auto& value : b) value = dist(gen);
+  std::vector<double> c(n * n);
+  std::vector<double> reference(n * n);
+  ppc::core::kernels::strassenMatmul(n, a.data(), b.data(), c.data(), crossover);
+  ppc::core::kernels::matmul(n, n, n, a.data(), b.data(), reference.data());
+
+  double max_error = 0.0;
+  for (size_t i = 0; i < c.size(); i++) {
+    max_error = std::max(max_error, std::abs(c[i] - reference[i]));
+  }
+  const auto max_abs = [](const std::vector<double>& m) {
+    double result = 0.0;
+    for (double value : m) result = std::max(result, std::abs(value));
+    return result;
+  };
+  const double bound = ppc::core::kernels::strassenErrorBound<double>(n, crossover, max_abs(a), max_abs(b));
+  EXPECT_GT(max_error, 0.0);
+  EXPECT_LE(max_error, bound);
+}
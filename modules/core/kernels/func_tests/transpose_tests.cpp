@@ -0,0 +1,83 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "core/kernels/include/transpose.hpp"
+
+namespace {
+
+template <class T>
+std::vector<T> naiveTranspose(size_t rows, size_t cols, const std::vector<T>& in) {
+  std::vector<T> out(rows * cols);
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t j = 0; j < cols; j++) {
+      out[j * rows + i] = in[i * cols + j];
+    }
+  }
+  return out;
+}
+
+template <class T>
+std::vector<T> iotaMatrix(size_t rows, size_t cols) {
+  std::vector<T> matrix(rows * cols);
+  std::iota(matrix.begin(), matrix.end(), T{});
+  return matrix;
+}
+
+}  // namespace
+
+template <class T>
+class transpose_kernel : public ::testing::Test {};
+
+using TransposeTypes = ::testing::Types<int8_t, int32_t, float, double>;
+TYPED_TEST_SUITE(transpose_kernel, TransposeTypes);
+
+TYPED_TEST(transpose_kernel, check_out_of_place_sizes) {
+  using T = TypeParam;
+  for (size_t rows : {1, 7, 8, 65, 130}) {
+    for (size_t cols : {1, 9, 64, 200}) {
+      const auto in = iotaMatrix<T>(rows, cols);
+      std::vector<T> out(rows * cols);
+      ppc::core::kernels::transpose(rows, cols, in.data(), out.data());
+      ASSERT_EQ(out, naiveTranspose(rows, cols, in)) << rows << "x" << cols;
+    }
+  }
+}
+
+TYPED_TEST(transpose_kernel, check_in_place_square) {
+  using T = TypeParam;
+  for (size_t n : {1, 5, 8, 63, 64, 65, 257}) {
+    auto matrix = iotaMatrix<T>(n, n);
+    const auto expected = naiveTranspose(n, n, matrix);
+    ppc::core::kernels::transposeInPlace(n, matrix.data());
+    ASSERT_EQ(matrix, expected) << n;
+  }
+}
+
+TYPED_TEST(transpose_kernel, check_parallel_matches_serial) {
+  using T = TypeParam;
+  const size_t rows = 1000;
+  const size_t cols = 333;
+  const auto in = iotaMatrix<T>(rows, cols);
+  std::vector<T> out(rows * cols);
+  ppc::core::kernels::parallelTranspose(rows, cols, in.data(), out.data(), 4);
+  EXPECT_EQ(out, naiveTranspose(rows, cols, in));
+}
+
+TEST(transpose_kernel_strides, check_transposes_submatrix) {
+  // The 5 x 3 block at (1, 2) of a 7 x 10 matrix goes to the 3 x 5 block at
+  // (2, 1) of a 6 x 8 matrix; everything else stays untouched.
+  const auto in = iotaMatrix<int>(7, 10);
+  std::vector<int> out(6 * 8, -1);
+  ppc::core::kernels::transpose<int>(5, 3, in.data() + 10 + 2, 10, out.data() + 2 * 8 + 1, 8);
+  for (size_t i = 0; i < 6; i++) {
+    for (size_t j = 0; j < 8; j++) {
+      const bool inside = i >= 2 && i < 5 && j >= 1 && j < 6;
+      const int expected = inside ? in[(1 + (j - 1)) * 10 + 2 + (i - 2)] : -1;
+      ASSERT_EQ(out[i * 8 + j], expected) << i << "," << j;
+    }
+  }
+}
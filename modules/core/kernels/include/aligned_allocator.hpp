@@ -0,0 +1,44 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_ALIGNED_ALLOCATOR_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_ALIGNED_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace ppc::core::kernels {
+
+// Allocator returning kAlignment-byte aligned storage, so that the first element
+// of a local block starts on a cache line and the vector loads of the kernels
+// never split one.
+template <class T, std::size_t kAlignment = 64>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <class U>
+  struct rebind {
+    using other = AlignedAllocator<U, kAlignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <class U>
+  explicit AlignedAllocator(const AlignedAllocator<U, kAlignment>& /*other*/) {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(kAlignment)));
+  }
+  void deallocate(T* p, std::size_t /*n*/) { ::operator delete(p, std::align_val_t(kAlignment)); }
+
+  template <class U>
+  bool operator==(const AlignedAllocator<U, kAlignment>& /*other*/) const {
+    return true;
+  }
+};
+
+template <class T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_ALIGNED_ALLOCATOR_HPP_
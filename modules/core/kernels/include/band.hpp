@@ -0,0 +1,162 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_BAND_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_BAND_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace ppc::core::kernels {
+
+// Numbers of non-zero diagonals below (`lower`, kl) and above (`upper`, ku) the
+// main one.
+struct Bandwidth {
+  std::size_t lower{};
+  std::size_t upper{};
+};
+
+// Smallest band holding every non-zero entry of the row-major n x n matrix `a`.
+template <class T>
+Bandwidth detectBandwidth(std::size_t n, const T* a, std::size_t lda) {
+  Bandwidth band;
+  for (std::size_t i = 0; i < n; i++) {
+    const T* row = a + i * lda;
+    // Only the entries outside the band found so far need looking at.
+    for (std::size_t j = 0; j + band.lower < i; j++) {
+      if (row[j] != T{}) {
+        band.lower = i - j;
+        break;
+      }
+    }
+    for (std::size_t j = n; j-- > i + band.upper + 1;) {
+      if (row[j] != T{}) {
+        band.upper = j - i;
+        break;
+      }
+    }
+  }
+  return band;
+}
+
+// n x n band matrix in LAPACK-style band storage, kept by rows (LAPACK's
+// column-major layout transposed): row i holds columns i - kl .. i + kl + ku
+// in `values[i * stride() ..]`, entry (i, j) at offset j - i + kl. The kl
+// extra diagonals above the band start out zero and take the fill-in of the
+// row swaps in bandFactor(), so the factorisation never reallocates. Storage
+// is O(n * (2 kl + ku + 1)) instead of O(n^2).
+template <class T>
+struct BandMatrix {
+  std::size_t n{};
+  Bandwidth band;
+  std::vector<T> values;
+
+  BandMatrix() = default;
+  BandMatrix(std::size_t n_, Bandwidth band_) : n(n_), band(band_), values(n_ * (2 * band_.lower + band_.upper + 1)) {}
+
+  [[nodiscard]] std::size_t stride() const { return 2 * band.lower + band.upper + 1; }
+
+  // Entry (i, j) for |j - i| inside the storage (i - kl <= j <= i + kl + ku).
+  [[nodiscard]] T& at(std::size_t i, std::size_t j) { return values[i * stride() + j + band.lower - i]; }
+  [[nodiscard]] const T& at(std::size_t i, std::size_t j) const { return values[i * stride() + j + band.lower - i]; }
+
+  // Copies the band of the row-major n x n matrix `a`; entries outside it are
+  // dropped.
+  static BandMatrix fromDense(std::size_t n, const T* a, std::size_t lda, Bandwidth band) {
+    BandMatrix matrix(n, band);
+    for (std::size_t i = 0; i < n; i++) {
+      const std::size_t first = i > band.lower ? i - band.lower : 0;
+      const std::size_t last = std::min(n - 1, i + band.upper);
+      for (std::size_t j = first; j <= last; j++) matrix.at(i, j) = a[i * lda + j];
+    }
+    return matrix;
+  }
+
+  // Copies compact band rows: row i of `rows` holds columns i - kl .. i + ku,
+  // entry (i, j) at rows[i * (kl + ku + 1) + j - i + kl]; slots that fall
+  // outside the matrix are ignored.
+  static BandMatrix fromRows(std::size_t n, const T* rows, Bandwidth band) {
+    BandMatrix matrix(n, band);
+    const std::size_t width = band.lower + band.upper + 1;
+    for (std::size_t i = 0; i < n; i++) {
+      const std::size_t first = i > band.lower ? i - band.lower : 0;
+      const std::size_t last = std::min(n - 1, i + band.upper);
+      for (std::size_t j = first; j <= last; j++) matrix.at(i, j) = rows[i * width + j + band.lower - i];
+    }
+    return matrix;
+  }
+};
+
+// LU with partial pivoting of a band matrix in place (LAPACK's gbtf2): the
+// pivot of column j is searched among the kl rows below the diagonal only, so
+// step j touches a (kl + 1) x (kl + ku + 1) window and the whole factorisation
+// costs O(n * kl * (kl + ku)). U (bandwidth kl + ku) ends up on and above the
+// diagonal, the multipliers of column j below it; as in LAPACK the swaps are
+// not applied to the multipliers of earlier columns, so bandSolve() replays
+// swaps and eliminations column by column. pivots[j] receives the row swapped
+// with row j. Returns false if a pivot is exactly zero (the factorisation goes
+// on, as in luPanel()).
+template <class T>
+bool bandFactor(BandMatrix<T>& a, int* pivots) {
+  const std::size_t n = a.n;
+  const std::size_t kl = a.band.lower;
+  const std::size_t reach = kl + a.band.upper;
+  bool regular = true;
+  for (std::size_t j = 0; j < n; j++) {
+    const std::size_t last_row = std::min(n - 1, j + kl);
+    const std::size_t last_col = std::min(n - 1, j + reach);
+    std::size_t pivot = j;
+    for (std::size_t i = j + 1; i <= last_row; i++) {
+      if (std::abs(a.at(i, j)) > std::abs(a.at(pivot, j))) pivot = i;
+    }
+    pivots[j] = static_cast<int>(pivot);
+    if (pivot != j) std::swap_ranges(&a.at(j, j), &a.at(j, last_col) + 1, &a.at(pivot, j));
+    const T diagonal = a.at(j, j);
+    if (diagonal == T{}) {
+      regular = false;
+      continue;
+    }
+    const T* row_j = &a.at(j, j);
+    for (std::size_t i = j + 1; i <= last_row; i++) {
+      T* row_i = &a.at(i, j);
+      const T factor = row_i[0] / diagonal;
+      row_i[0] = factor;
+      for (std::size_t p = 1; p <= last_col - j; p++) row_i[p] -= factor * row_j[p];
+    }
+  }
+  return regular;
+}
+
+// Solves A X = B in place for the n x nrhs row-major matrix `b` with the
+// factors from bandFactor(), in O(n * (2 kl + ku) * nrhs).
+template <class T>
+void bandSolve(const BandMatrix<T>& lu, const int* pivots, T* b, std::size_t nrhs = 1) {
+  const std::size_t n = lu.n;
+  const std::size_t kl = lu.band.lower;
+  const std::size_t reach = kl + lu.band.upper;
+  for (std::size_t j = 0; j < n; j++) {
+    T* row_j = b + j * nrhs;
+    const auto pivot = static_cast<std::size_t>(pivots[j]);
+    if (pivot != j) std::swap_ranges(row_j, row_j + nrhs, b + pivot * nrhs);
+    for (std::size_t i = j + 1; i <= std::min(n - 1, j + kl); i++) {
+      const T factor = lu.at(i, j);
+      T* row_i = b + i * nrhs;
+      for (std::size_t c = 0; c < nrhs; c++) row_i[c] -= factor * row_j[c];
+    }
+  }
+  for (std::size_t i = n; i-- > 0;) {
+    T* row_i = b + i * nrhs;
+    for (std::size_t p = i + 1; p <= std::min(n - 1, i + reach); p++) {
+      const T factor = lu.at(i, p);
+      const T* row_p = b + p * nrhs;
+      for (std::size_t c = 0; c < nrhs; c++) row_i[c] -= factor * row_p[c];
+    }
+    const T diagonal = lu.at(i, i);
+    for (std::size_t c = 0; c < nrhs; c++) row_i[c] /= diagonal;
+  }
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_BAND_HPP_
@@ -0,0 +1,154 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_BATCHED_GEMM_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_BATCHED_GEMM_HPP_
+
+#include <algorithm>
+#include <cstddef>
+
+#include "core/kernels/include/parallel.hpp"
+#include "core/kernels/include/simd.hpp"
+
+namespace ppc::core::kernels {
+
+// Batches of many small matrices are multiplied in an interleaved layout:
+// the matrices are grouped into packs of kBatchLanes<T>, and element (i, j) of
+// all matrices of a pack is stored as kBatchLanes<T> consecutive values, one
+// per matrix. One vector operation then works on the same element of a whole
+// pack, so even a 4 x 4 product fills the vector registers, which a single
+// 4 x 4 GEMM never does.
+template <class T>
+constexpr std::size_t kBatchLanes = kSimdLanes<T>;
+
+template <class T>
+constexpr std::size_t batchPacks(std::size_t count) {
+  return (count + kBatchLanes<T> - 1) / kBatchLanes<T>;
+}
+
+// Converts `count` contiguous row-major rows x cols matrices into
+// batchPacks<T>(count) interleaved packs. Lanes past `count` are zero.
+template <class T>
+void interleaveBatch(std::size_t count, std::size_t rows, std::size_t cols, const T* matrices, T* packed) {
+  constexpr std::size_t kLanes = kBatchLanes<T>;
+  const std::size_t size = rows * cols;
+  for (std::size_t pack = 0; pack < batchPacks<T>(count); pack++) {
+    T* out = packed + pack * size * kLanes;
+    for (std::size_t lane = 0; lane < kLanes; lane++) {
+      const std::size_t matrix = pack * kLanes + lane;
+      const T* in = matrices + matrix * size;
+      for (std::size_t e = 0; e < size; e++) {
+        out[e * kLanes + lane] = matrix < count ? in[e] : T{};
+      }
+    }
+  }
+}
+
+// Inverse of interleaveBatch(): writes back the first `count` matrices.
+template <class T>
+void deinterleaveBatch(std::size_t count, std::size_t rows, std::size_t cols, const T* packed, T* matrices) {
+  constexpr std::size_t kLanes = kBatchLanes<T>;
+  const std::size_t size = rows * cols;
+  for (std::size_t matrix = 0; matrix < count; matrix++) {
+    const T* in = packed + (matrix / kLanes) * size * kLanes + matrix % kLanes;
+    T* out = matrices + matrix * size;
+    for (std::size_t e = 0; e < size; e++) {
+      out[e] = in[e * kLanes];
+    }
+  }
+}
+
+namespace detail {
+
+// C = A * B for the kBatchLanes<T> matrices of one pack. With compile-time
+// M, N and K the loops are fully unrolled and the lane loop is one vector
+// multiply-add.
+template <std::size_t M, std::size_t N, std::size_t K, class T>
+void packGemmFixed(const T* a, const T* b, T* c) {
+  constexpr std::size_t kLanes = kBatchLanes<T>;
+  for (std::size_t i = 0; i < M; i++) {
+    for (std::size_t j = 0; j < N; j++) {
+      T acc[kLanes] = {};
+      for (std::size_t p = 0; p < K; p++) {
+        const T* a_ip = a + (i * K + p) * kLanes;
+        const T* b_pj = b + (p * N + j) * kLanes;
+        for (std::size_t l = 0; l < kLanes; l++) {
+          acc[l] += a_ip[l] * b_pj[l];
+        }
+      }
+      std::copy(acc, acc + kLanes, c + (i * N + j) * kLanes);
+    }
+  }
+}
+
+// Same for sizes only known at run time.
+template <class T>
+void packGemm(std::size_t m, std::size_t n, std::size_t k, const T* a, const T* b, T* c) {
+  constexpr std::size_t kLanes = kBatchLanes<T>;
+  for (std::size_t i = 0; i < m; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      T acc[kLanes] = {};
+      for (std::size_t p = 0; p < k; p++) {
+        const T* a_ip = a + (i * k + p) * kLanes;
+        const T* b_pj = b + (p * n + j) * kLanes;
+        for (std::size_t l = 0; l < kLanes; l++) {
+          acc[l] += a_ip[l] * b_pj[l];
+        }
+      }
+      std::copy(acc, acc + kLanes, c + (i * n + j) * kLanes);
+    }
+  }
+}
+
+// Runs pack_body(a, b, c) over `packs` packs split between threads, with at
+// least kMinChunk multiply-adds per thread.
+template <class T, class PackBody>
+void forEachPack(std::size_t m, std::size_t n, std::size_t k, std::size_t packs, const T* a, const T* b, T* c,
+                 int num_threads, PackBody pack_body) {
+  constexpr std::size_t kLanes = kBatchLanes<T>;
+  const std::size_t min_packs = std::max<std::size_t>(1, kMinChunk / std::max<std::size_t>(1, m * n * k * kLanes));
+  forEachChunk(
+      packs, num_threads,
+      [&](std::size_t /*chunk*/, std::size_t begin, std::size_t end) {
+        for (std::size_t pack = begin; pack < end; pack++) {
+          pack_body(a + pack * m * k * kLanes, b + pack * k * n * kLanes, c + pack * m * n * kLanes);
+        }
+      },
+      min_packs);
+}
+
+}  // namespace detail
+
+// C[b] = A[b] * B[b] for every matrix of interleaved batches of `packs` packs
+// (A: M x K, B: K x N, C: M x N), with the size fixed at compile time.
+template <std::size_t M, std::size_t N, std::size_t K, class T>
+void batchedGemm(std::size_t packs, const T* a, const T* b, T* c, int num_threads = detail::defaultThreads()) {
+  detail::forEachPack(M, N, K, packs, a, b, c, num_threads,
+                      [](const T* pa, const T* pb, T* pc) { detail::packGemmFixed<M, N, K>(pa, pb, pc); });
+}
+
+// Run-time sized version. Square 4, 8, 16 and 32 products, the common small
+// sizes, are dispatched to the compile-time kernels.
+template <class T>
+void batchedGemm(std::size_t m, std::size_t n, std::size_t k, std::size_t packs, const T* a, const T* b, T* c,
+                 int num_threads = detail::defaultThreads()) {
+  if (m == n && n == k) {
+    switch (m) {
+      case 4:
+        return batchedGemm<4, 4, 4>(packs, a, b, c, num_threads);
+      case 8:
+        return batchedGemm<8, 8, 8>(packs, a, b, c, num_threads);
+      case 16:
+        return batchedGemm<16, 16, 16>(packs, a, b, c, num_threads);
+      case 32:
+        return batchedGemm<32, 32, 32>(packs, a, b, c, num_threads);
+      default:
+        break;
+    }
+  }
+  detail::forEachPack(m, n, k, packs, a, b, c, num_threads,
+                      [=](const T* pa, const T* pb, T* pc) { detail::packGemm(m, n, k, pa, pb, pc); });
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_BATCHED_GEMM_HPP_
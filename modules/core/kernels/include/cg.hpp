@@ -0,0 +1,192 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_CG_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_CG_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "core/kernels/include/parallel.hpp"
+
+namespace ppc::core::kernels {
+
+// Block-Jacobi preconditioner for a symmetric positive definite matrix: the
+// diagonal blocks of `block` consecutive rows (the last one may be shorter) are
+// Cholesky-factorised once and apply() solves with every block. With block = 1
+// this is the plain Jacobi (diagonal) preconditioner.
+template <class T>
+class BlockJacobiPreconditioner {
+ public:
+  // entry(i, j) returns A[i][j] for i, j in [0, n) within one block. Returns
+  // false if a block is not positive definite.
+  template <class Entry>
+  bool factorise(std::size_t n, std::size_t block, Entry entry) {
+    n_ = n;
+    block_ = std::max<std::size_t>(block, 1);
+    factors_.assign(blockCount() * block_ * block_, T{});
+    for (std::size_t k = 0; k < blockCount(); k++) {
+      const std::size_t first = k * block_;
+      const std::size_t size = blockSize(k);
+      T* l = factors_.data() + k * block_ * block_;
+      for (std::size_t i = 0; i < size; i++) {
+        for (std::size_t j = 0; j <= i; j++) {
+          double sum = static_cast<double>(entry(first + i, first + j));
+          for (std::size_t p = 0; p < j; p++) {
+            sum -= static_cast<double>(l[i * block_ + p]) * l[j * block_ + p];
+          }
+          if (i == j) {
+            if (!(sum > 0.0)) return false;
+            l[i * block_ + i] = static_cast<T>(std::sqrt(sum));
+          } else {
+            l[i * block_ + j] = static_cast<T>(sum / l[j * block_ + j]);
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  // u = M^-1 r on num_threads threads.
+  void apply(const T* r, T* u, int num_threads = 1) const {
+    detail::forEachChunk(
+        blockCount(), num_threads,
+        [&](std::size_t /*chunk*/, std::size_t begin, std::size_t end) {
+          for (std::size_t k = begin; k < end; k++) {
+            solveBlock(k, r + k * block_, u + k * block_);
+          }
+        },
+        std::max<std::size_t>(1, detail::kMinChunk / (block_ * block_)));
+  }
+
+  [[nodiscard]] std::size_t block() const { return block_; }
+
+ private:
+  [[nodiscard]] std::size_t blockCount() const { return (n_ + block_ - 1) / block_; }
+  [[nodiscard]] std::size_t blockSize(std::size_t k) const { return std::min(block_, n_ - k * block_); }
+
+  // L L^T u = r for block k: forward then backward substitution.
+  void solveBlock(std::size_t k, const T* r, T* u) const {
+    const std::size_t size = blockSize(k);
+    const T* l = factors_.data() + k * block_ * block_;
+    for (std::size_t i = 0; i < size; i++) {
+      T sum = r[i];
+      for (std::size_t p = 0; p < i; p++) sum -= l[i * block_ + p] * u[p];
+      u[i] = sum / l[i * block_ + i];
+    }
+    for (std::size_t i = size; i-- > 0;) {
+      T sum = u[i];
+      for (std::size_t p = i + 1; p < size; p++) sum -= l[p * block_ + i] * u[p];
+      u[i] = sum / l[i * block_ + i];
+    }
+  }
+
+  std::size_t n_{};
+  std::size_t block_{1};
+  std::vector<T> factors_;
+};
+
+// Outcome of pcgSolve(): `residual` is ||b - A x|| / ||b|| as tracked by the
+// recurrence.
+struct PcgResult {
+  int iterations = 0;
+  double residual = 0.0;
+  bool converged = false;
+};
+
+namespace detail {
+
+// (r, u), (w, u) and (r, r) in one pass over the vectors.
+template <class T>
+std::array<double, 3> fusedDots(std::size_t n, const T* r, const T* u, const T* w, int num_threads) {
+  std::vector<std::array<double, 3>> partial(std::max(num_threads, 1), std::array<double, 3>{});
+  forEachChunk(n, num_threads, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::array<double, 3> sums{};
+    for (std::size_t i = begin; i < end; i++) {
+      sums[0] += static_cast<double>(r[i]) * u[i];
+      sums[1] += static_cast<double>(w[i]) * u[i];
+      sums[2] += static_cast<double>(r[i]) * r[i];
+    }
+    partial[chunk] = sums;
+  });
+  std::array<double, 3> sums{};
+  for (const auto& chunk : partial) {
+    for (std::size_t k = 0; k < 3; k++) sums[k] += chunk[k];
+  }
+  return sums;
+}
+
+}  // namespace detail
+
+// Preconditioned conjugate gradients for a symmetric positive definite A, in
+// the Chronopoulos-Gear form: the recurrence s = A p replaces the product
+// A p of classical CG, so the three inner products of an iteration, (r, u),
+// (A u, u) and (r, r), are all taken after the single product w = A u and
+// summed with one `reduce` call. For a distributed solve that is one
+// allreduce per iteration instead of two separate ones.
+//
+// The vectors are the n local entries; the operations are supplied by the
+// caller:
+//   multiply(u, w)     - w = A u (may communicate to get remote entries of u),
+//   precondition(r, u) - u = M^-1 r,
+//   reduce(sums)       - sums the std::array<double, 3> over all processes in
+//                        place (nothing to do for a single process).
+// Starts from x = 0 and stops when ||r|| <= tolerance * ||b|| or after
+// max_iterations iterations. Vector updates run on num_threads threads.
+template <class T, class Multiply, class Precondition, class Reduce>
+PcgResult pcgSolve(std::size_t n, const T* b, T* x, Multiply multiply, Precondition precondition, Reduce reduce,
+                   double tolerance, int max_iterations, int num_threads = 1) {
+  std::vector<T> r(b, b + n);
+  std::vector<T> u(n);
+  std::vector<T> w(n);
+  std::vector<T> p(n, T{});
+  std::vector<T> s(n, T{});
+  std::fill(x, x + n, T{});
+
+  precondition(r.data(), u.data());
+  multiply(u.data(), w.data());
+  std::array<double, 3> sums = detail::fusedDots(n, r.data(), u.data(), w.data(), num_threads);
+  reduce(sums);
+  const double b_norm = std::sqrt(sums[2]);
+  PcgResult result;
+  result.residual = b_norm > 0.0 ? 1.0 : 0.0;
+  if (b_norm == 0.0) {
+    result.converged = true;
+    return result;
+  }
+  double gamma = sums[0];
+  double alpha = gamma / sums[1];
+  double beta = 0.0;
+  while (result.iterations < max_iterations) {
+    const auto a = static_cast<T>(alpha);
+    const auto bt = static_cast<T>(beta);
+    detail::forEachChunk(n, num_threads, [&](std::size_t /*chunk*/, std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        p[i] = u[i] + bt * p[i];
+        s[i] = w[i] + bt * s[i];
+        x[i] += a * p[i];
+        r[i] -= a * s[i];
+      }
+    });
+    precondition(r.data(), u.data());
+    multiply(u.data(), w.data());
+    sums = detail::fusedDots(n, r.data(), u.data(), w.data(), num_threads);
+    reduce(sums);
+    result.iterations++;
+    result.residual = std::sqrt(sums[2]) / b_norm;
+    if (result.residual <= tolerance) {
+      result.converged = true;
+      break;
+    }
+    beta = sums[0] / gamma;
+    alpha = sums[0] / (sums[1] - beta * sums[0] / alpha);
+    gamma = sums[0];
+  }
+  return result;
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_CG_HPP_
@@ -0,0 +1,122 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_DOT_PRODUCT_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_DOT_PRODUCT_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "core/kernels/include/simd.hpp"
+
+namespace ppc::core::kernels {
+
+// Type in which a dot product of T is accumulated, see WideningAccumulator.
+template <class T>
+using DotAccumulatorT = WideningAccumulatorT<T>;
+
+// Number of independent partial sums kept by the kernels. Eight chains hide the
+// latency of a floating point add/FMA and map onto whole SIMD registers.
+constexpr std::size_t kDotLanes = 8;
+
+// acc + a * b, fused when the target has hardware FMA. Without it std::fma is a
+// library call, so the plain expression is left to the compiler.
+template <class Acc>
+inline Acc multiplyAdd(Acc a, Acc b, Acc acc) {
+  if constexpr (std::is_same_v<Acc, double>) {
+#ifdef FP_FAST_FMA
+    return std::fma(a, b, acc);
+#endif
+  } else if constexpr (std::is_same_v<Acc, float>) {
+#ifdef FP_FAST_FMAF
+    return std::fma(a, b, acc);
+#endif
+  }
+  return acc + a * b;
+}
+
+// Dot product of a[0..n) and b[0..n) with kDotLanes independent accumulators.
+// `Acc` may be set wider than the default, e.g. double for float data.
+template <class T, class Acc = DotAccumulatorT<T>>
+Acc dot(const T* a, const T* b, std::size_t n) {
+  Acc lanes[kDotLanes] = {};
+  std::size_t i = 0;
+  for (; i + kDotLanes <= n; i += kDotLanes) {
+    for (std::size_t k = 0; k < kDotLanes; k++) {
+      lanes[k] = multiplyAdd(static_cast<Acc>(a[i + k]), static_cast<Acc>(b[i + k]), lanes[k]);
+    }
+  }
+  for (std::size_t k = 0; i < n; i++, k++) {
+    lanes[k] = multiplyAdd(static_cast<Acc>(a[i]), static_cast<Acc>(b[i]), lanes[k]);
+  }
+  // Pairwise combination keeps the rounding error of the final sum small.
+  for (std::size_t width = kDotLanes / 2; width > 0; width /= 2) {
+    for (std::size_t k = 0; k < width; k++) {
+      lanes[k] += lanes[k + width];
+    }
+  }
+  return lanes[0];
+}
+
+// Batched variant for many independent pairs: out[p] = dot(a + p * n, b + p * n, n)
+// for p in [0, count). Both operands are stored pair after pair.
+template <class T>
+void dotPairs(const T* a, const T* b, std::size_t n, std::size_t count, DotAccumulatorT<T>* out) {
+  for (std::size_t p = 0; p < count; p++) {
+    out[p] = dot(a + p * n, b + p * n, n);
+  }
+}
+
+// One-against-many variant used for similarity search: out[r] is the dot product
+// of `query` with row r of the row-major count x n matrix `rows`. Four rows are
+// processed per sweep so every element of the query is loaded once for them.
+template <class T>
+void dotMany(const T* query, const T* rows, std::size_t n, std::size_t count, DotAccumulatorT<T>* out) {
+  using Acc = DotAccumulatorT<T>;
+  constexpr std::size_t kRowsPerSweep = 4;
+  std::size_t r = 0;
+  for (; r + kRowsPerSweep <= count; r += kRowsPerSweep) {
+    const T* row0 = rows + r * n;
+    const T* row1 = row0 + n;
+    const T* row2 = row1 + n;
+    const T* row3 = row2 + n;
+    Acc acc0[kDotLanes] = {};
+    Acc acc1[kDotLanes] = {};
+    Acc acc2[kDotLanes] = {};
+    Acc acc3[kDotLanes] = {};
+    std::size_t i = 0;
+    for (; i + kDotLanes <= n; i += kDotLanes) {
+      for (std::size_t k = 0; k < kDotLanes; k++) {
+        const auto q = static_cast<Acc>(query[i + k]);
+        acc0[k] = multiplyAdd(q, static_cast<Acc>(row0[i + k]), acc0[k]);
+        acc1[k] = multiplyAdd(q, static_cast<Acc>(row1[i + k]), acc1[k]);
+        acc2[k] = multiplyAdd(q, static_cast<Acc>(row2[i + k]), acc2[k]);
+        acc3[k] = multiplyAdd(q, static_cast<Acc>(row3[i + k]), acc3[k]);
+      }
+    }
+    Acc sums[kRowsPerSweep] = {};
+    for (std::size_t k = 0; k < kDotLanes; k++) {
+      sums[0] += acc0[k];
+      sums[1] += acc1[k];
+      sums[2] += acc2[k];
+      sums[3] += acc3[k];
+    }
+    for (; i < n; i++) {
+      const auto q = static_cast<Acc>(query[i]);
+      sums[0] = multiplyAdd(q, static_cast<Acc>(row0[i]), sums[0]);
+      sums[1] = multiplyAdd(q, static_cast<Acc>(row1[i]), sums[1]);
+      sums[2] = multiplyAdd(q, static_cast<Acc>(row2[i]), sums[2]);
+      sums[3] = multiplyAdd(q, static_cast<Acc>(row3[i]), sums[3]);
+    }
+    for (std::size_t k = 0; k < kRowsPerSweep; k++) {
+      out[r + k] = sums[k];
+    }
+  }
+  for (; r < count; r++) {
+    out[r] = dot(query, rows + r * n, n);
+  }
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_DOT_PRODUCT_HPP_
@@ -0,0 +1,90 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_ECHELON_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_ECHELON_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "core/kernels/include/lu.hpp"
+
+namespace ppc::core::kernels {
+
+// Pivots of at most this magnitude count as zero in rowEchelon(): max(m, n) *
+// epsilon * ||A||_F, MATLAB's rank threshold with the largest singular value
+// replaced by its upper bound ||A||_F (taking `sum_squares` = sum a_ij^2),
+// which costs one pass over A instead of an SVD.
+template <class T>
+double rankTolerance(std::size_t m, std::size_t n, double sum_squares) {
+  return static_cast<double>(std::max(m, n)) * std::numeric_limits<T>::epsilon() * std::sqrt(sum_squares);
+}
+
+// `rank`: number of pivots found. `determinant`: det A for a square A (zero
+// when rank < n), from the same pivots.
+struct EchelonResult {
+  std::size_t rank{};
+  Determinant determinant;
+};
+
+// Reduces the row-major m x n matrix `a` in place to the row echelon form of
+// P A Q by Gaussian elimination with complete pivoting: every step moves the
+// largest remaining entry to the diagonal, and the elimination stops when none
+// is above `tolerance` (negative: rankTolerance()). Unlike LU with partial
+// pivoting, which divides by whatever its column offers, the pivots never grow
+// and rounding noise is never amplified by a small pivot, so the number of
+// pivots is the numerical rank; for a square nonsingular A it gives the
+// determinant too. The search adds O(m n) per step, the cost of the update.
+template <class T>
+EchelonResult rowEchelon(std::size_t m, std::size_t n, T* a, std::size_t lda, double tolerance = -1.0) {
+  if (tolerance < 0.0) {
+    double sum_squares = 0.0;
+    for (std::size_t i = 0; i < m; i++) {
+      for (std::size_t j = 0; j < n; j++) {
+        const auto value = static_cast<double>(a[i * lda + j]);
+        sum_squares += value * value;
+      }
+    }
+    tolerance = rankTolerance<T>(m, n, sum_squares);
+  }
+  std::size_t rank = 0;
+  std::size_t swaps = 0;
+  for (; rank < std::min(m, n); rank++) {
+    std::size_t pivot_row = rank;
+    std::size_t pivot_col = rank;
+    for (std::size_t i = rank; i < m; i++) {
+      for (std::size_t j = rank; j < n; j++) {
+        if (std::abs(a[i * lda + j]) > std::abs(a[pivot_row * lda + pivot_col])) {
+          pivot_row = i;
+          pivot_col = j;
+        }
+      }
+    }
+    if (!(std::abs(static_cast<double>(a[pivot_row * lda + pivot_col])) > tolerance)) break;
+    if (pivot_row != rank) {
+      std::swap_ranges(a + rank * lda, a + rank * lda + n, a + pivot_row * lda);
+      swaps++;
+    }
+    if (pivot_col != rank) {
+      for (std::size_t i = 0; i < m; i++) std::swap(a[i * lda + rank], a[i * lda + pivot_col]);
+      swaps++;
+    }
+    const T* row_r = a + rank * lda;
+    for (std::size_t i = rank + 1; i < m; i++) {
+      T* row_i = a + i * lda;
+      const T factor = row_i[rank] / row_r[rank];
+      row_i[rank] = T{};
+      for (std::size_t p = rank + 1; p < n; p++) row_i[p] -= factor * row_r[p];
+    }
+  }
+  EchelonResult result{rank, {}};
+  if (m == n && rank == n) {
+    result.determinant = diagonalDeterminant(n, [&](std::size_t i) { return a[i * lda + i]; }, swaps);
+  }
+  return result;
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_ECHELON_HPP_
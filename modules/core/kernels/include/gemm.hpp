@@ -0,0 +1,128 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_GEMM_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_GEMM_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+
+namespace ppc::core::kernels {
+
+// Blocking parameters of gemm(). The micro-kernel keeps a kGemmMr x kGemmNr<T>
+// tile of C in registers (4 x 16 for int32/float, 4 x 8 for double with AVX2).
+// A kGemmKc-deep sliver of B (kGemmKc x kGemmNr<T>) stays in L1, a packed
+// kGemmMc x kGemmKc block of A in L2 and a kGemmKc x kGemmNc panel of B in L3.
+constexpr std::size_t kGemmMr = 4;
+template <class T>
+constexpr std::size_t kGemmNr = 2 * kSimdLanes<T>;
+constexpr std::size_t kGemmKc = 256;
+constexpr std::size_t kGemmMc = 96;
+constexpr std::size_t kGemmNc = 2048;
+
+namespace detail {
+
+// Copies the mc x kc block of A into row panels of kGemmMr rows, each stored
+// column by column, so the micro-kernel reads A with unit stride. Rows past
+// the end of the block are zero.
+template <class T>
+void packA(const T* a, std::size_t lda, std::size_t mc, std::size_t kc, T* packed) {
+  for (std::size_t ir = 0; ir < mc; ir += kGemmMr) {
+    const std::size_t mr = std::min(kGemmMr, mc - ir);
+    for (std::size_t p = 0; p < kc; p++) {
+      for (std::size_t i = 0; i < kGemmMr; i++) {
+        *packed++ = i < mr ? a[(ir + i) * lda + p] : T{};
+      }
+    }
+  }
+}
+
+// Copies the kc x nc panel of B into column slivers of kGemmNr<T> columns,
+// each stored row by row. Columns past the end of the panel are zero.
+template <class T>
+void packB(const T* b, std::size_t ldb, std::size_t kc, std::size_t nc, T* packed) {
+  constexpr std::size_t kNr = kGemmNr<T>;
+  for (std::size_t jr = 0; jr < nc; jr += kNr) {
+    const std::size_t nr = std::min(kNr, nc - jr);
+    for (std::size_t p = 0; p < kc; p++) {
+      const T* row = b + p * ldb + jr;
+      for (std::size_t j = 0; j < kNr; j++) {
+        *packed++ = j < nr ? row[j] : T{};
+      }
+    }
+  }
+}
+
+// C[0..mr) x [0..nr) += packed A sliver * packed B sliver. The full
+// kGemmMr x kGemmNr<T> tile is accumulated in registers: every step is kGemmMr
+// broadcasts of A and kGemmMr vector multiply-adds over one row of B.
+template <class T>
+void microKernel(std::size_t kc, const T* a, const T* b, T* c, std::size_t ldc, std::size_t mr, std::size_t nr) {
+  constexpr std::size_t kNr = kGemmNr<T>;
+  T acc[kGemmMr][kNr] = {};
+  for (std::size_t p = 0; p < kc; p++) {
+    for (std::size_t i = 0; i < kGemmMr; i++) {
+      const T a_ip = a[p * kGemmMr + i];
+      for (std::size_t j = 0; j < kNr; j++) {
+        acc[i][j] += a_ip * b[p * kNr + j];
+      }
+    }
+  }
+  for (std::size_t i = 0; i < mr; i++) {
+    for (std::size_t j = 0; j < nr; j++) {
+      c[i * ldc + j] += acc[i][j];
+    }
+  }
+}
+
+}  // namespace detail
+
+// C += A * B for row-major matrices: A is m x k, B is k x n and C is m x n, with
+// leading dimensions lda, ldb and ldc (elements between consecutive rows), so
+// blocks of bigger matrices can be passed directly. Zero C beforehand for a
+// plain product. Works for any arithmetic T; int32, float and double fill the
+// vector registers the blocking is tuned for.
+template <class T>
+void gemm(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda, const T* b, std::size_t ldb, T* c,
+          std::size_t ldc) {
+  if (m == 0 || n == 0 || k == 0) {
+    return;
+  }
+  constexpr std::size_t kNr = kGemmNr<T>;
+  const std::size_t nc_max = std::min(kGemmNc, (n + kNr - 1) / kNr * kNr);
+  const std::size_t mc_max = std::min(kGemmMc, (m + kGemmMr - 1) / kGemmMr * kGemmMr);
+  std::vector<T> packed_b(std::min(kGemmKc, k) * nc_max);
+  std::vector<T> packed_a(mc_max * std::min(kGemmKc, k));
+
+  for (std::size_t jc = 0; jc < n; jc += kGemmNc) {
+    const std::size_t nc = std::min(kGemmNc, n - jc);
+    for (std::size_t pc = 0; pc < k; pc += kGemmKc) {
+      const std::size_t kc = std::min(kGemmKc, k - pc);
+      detail::packB(b + pc * ldb + jc, ldb, kc, nc, packed_b.data());
+      for (std::size_t ic = 0; ic < m; ic += kGemmMc) {
+        const std::size_t mc = std::min(kGemmMc, m - ic);
+        detail::packA(a + ic * lda + pc, lda, mc, kc, packed_a.data());
+        for (std::size_t jr = 0; jr < nc; jr += kNr) {
+          const T* b_sliver = packed_b.data() + jr * kc;
+          for (std::size_t ir = 0; ir < mc; ir += kGemmMr) {
+            detail::microKernel(kc, packed_a.data() + ir * kc, b_sliver, c + (ic + ir) * ldc + jc + jr, ldc,
+                                std::min(kGemmMr, mc - ir), std::min(kNr, nc - jr));
+          }
+        }
+      }
+    }
+  }
+}
+
+// C = A * B for contiguous row-major matrices (lda = k, ldb = n, ldc = n).
+template <class T>
+void matmul(std::size_t m, std::size_t n, std::size_t k, const T* a, const T* b, T* c) {
+  std::fill(c, c + m * n, T{});
+  gemm(m, n, k, a, k, b, n, c, n);
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_GEMM_HPP_
@@ -0,0 +1,508 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_LU_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_LU_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/gemm.hpp"
+#include "core/kernels/include/parallel.hpp"
+
+namespace ppc::core::kernels {
+
+// Width of the panels luFactor() factorises before each trailing update. The
+// update is a GEMM with an inner dimension of kLuBlock, deep enough for the
+// packed kernel to run near its peak.
+constexpr std::size_t kLuBlock = 64;
+
+// Unblocked LU with partial pivoting of the m x n panel `a` (row-major,
+// leading dimension lda): for each of the first min(m, n) columns the entry of
+// largest magnitude on or below the diagonal is swapped onto it, whole panel
+// rows are swapped, and the rows below are eliminated. pivots[j] receives the
+// row (counted from the top of the panel) swapped with row j. L (unit
+// diagonal, not stored) ends up below the diagonal and U on and above it.
+// Returns false if a pivot is exactly zero; like LAPACK's getf2 the column is
+// then left as it is and the factorisation goes on.
+template <class T>
+bool luPanel(std::size_t m, std::size_t n, T* a, std::size_t lda, int* pivots) {
+  bool regular = true;
+  for (std::size_t j = 0; j < std::min(m, n); j++) {
+    std::size_t pivot = j;
+    for (std::size_t i = j + 1; i < m; i++) {
+      if (std::abs(a[i * lda + j]) > std::abs(a[pivot * lda + j])) pivot = i;
+    }
+    pivots[j] = static_cast<int>(pivot);
+    if (pivot != j) std::swap_ranges(a + j * lda, a + j * lda + n, a + pivot * lda);
+    const T diagonal = a[j * lda + j];
+    if (diagonal == T{}) {
+      regular = false;
+      continue;
+    }
+    const T* row_j = a + j * lda;
+    for (std::size_t i = j + 1; i < m; i++) {
+      T* row_i = a + i * lda;
+      const T factor = row_i[j] / diagonal;
+      row_i[j] = factor;
+      for (std::size_t p = j + 1; p < n; p++) row_i[p] -= factor * row_j[p];
+    }
+  }
+  return regular;
+}
+
+// Swaps rows i and pivots[i] of the `cols` columns of `a` for i = begin,
+// begin + 1, ..., end - 1 in this order.
+template <class T>
+void swapRows(std::size_t cols, T* a, std::size_t lda, const int* pivots, std::size_t begin, std::size_t end) {
+  for (std::size_t i = begin; i < end; i++) {
+    const auto pivot = static_cast<std::size_t>(pivots[i]);
+    if (pivot != i) std::swap_ranges(a + i * lda, a + i * lda + cols, a + pivot * lda);
+  }
+}
+
+// B = L^-1 B for the unit lower triangle of the n x n matrix `l` and the n x m
+// matrix `b`.
+template <class T>
+void solveLowerUnit(std::size_t n, std::size_t m, const T* l, std::size_t ldl, T* b, std::size_t ldb) {
+  for (std::size_t i = 1; i < n; i++) {
+    T* row_i = b + i * ldb;
+    for (std::size_t p = 0; p < i; p++) {
+      const T factor = l[i * ldl + p];
+      const T* row_p = b + p * ldb;
+      for (std::size_t j = 0; j < m; j++) row_i[j] -= factor * row_p[j];
+    }
+  }
+}
+
+// B = U^-1 B for the upper triangle of the n x n matrix `u` and the n x m
+// matrix `b`.
+template <class T>
+void solveUpper(std::size_t n, std::size_t m, const T* u, std::size_t ldu, T* b, std::size_t ldb) {
+  for (std::size_t i = n; i-- > 0;) {
+    T* row_i = b + i * ldb;
+    for (std::size_t p = i + 1; p < n; p++) {
+      const T factor = u[i * ldu + p];
+      const T* row_p = b + p * ldb;
+      for (std::size_t j = 0; j < m; j++) row_i[j] -= factor * row_p[j];
+    }
+    const T diagonal = u[i * ldu + i];
+    for (std::size_t j = 0; j < m; j++) row_i[j] /= diagonal;
+  }
+}
+
+// B = U^-T B for the upper triangle of the n x n matrix `u` (a forward
+// substitution with U^T).
+template <class T>
+void solveUpperTransposed(std::size_t n, std::size_t m, const T* u, std::size_t ldu, T* b, std::size_t ldb) {
+  for (std::size_t i = 0; i < n; i++) {
+    T* row_i = b + i * ldb;
+    const T diagonal = u[i * ldu + i];
+    for (std::size_t j = 0; j < m; j++) row_i[j] /= diagonal;
+    for (std::size_t p = i + 1; p < n; p++) {
+      const T factor = u[i * ldu + p];
+      T* row_p = b + p * ldb;
+      for (std::size_t j = 0; j < m; j++) row_p[j] -= factor * row_i[j];
+    }
+  }
+}
+
+// B = L^-T B for the unit lower triangle of the n x n matrix `l` (a back
+// substitution with L^T).
+template <class T>
+void solveLowerUnitTransposed(std::size_t n, std::size_t m, const T* l, std::size_t ldl, T* b, std::size_t ldb) {
+  for (std::size_t i = n; i-- > 0;) {
+    const T* row_i = b + i * ldb;
+    for (std::size_t p = 0; p < i; p++) {
+      const T factor = l[i * ldl + p];
+      T* row_p = b + p * ldb;
+      for (std::size_t j = 0; j < m; j++) row_p[j] -= factor * row_i[j];
+    }
+  }
+}
+
+// C -= A * B with the packed gemm() kernel (on a negated copy of A).
+template <class T>
+void gemmSubtract(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda, const T* b,
+                  std::size_t ldb, T* c, std::size_t ldc) {
+  if (m == 0 || n == 0 || k == 0) return;
+  std::vector<T> negated(m * k);
+  for (std::size_t i = 0; i < m; i++) {
+    std::transform(a + i * lda, a + i * lda + k, negated.data() + i * k, [](T value) { return -value; });
+  }
+  gemm(m, n, k, negated.data(), k, b, ldb, c, ldc);
+}
+
+// Blocked right-looking LU with partial pivoting, P A = L U, of the n x n
+// matrix `a`, in place. Each step factorises a panel of `block` columns with
+// luPanel(), applies its row swaps to the columns left and right of it, solves
+// for the block row of U and updates the trailing matrix with one GEMM, so
+// almost all the work runs in the GEMM kernel. pivots[i] receives the row
+// swapped with row i (rows counted from 0, swaps applied in order i = 0..n-1).
+// Returns false if A is singular (a zero pivot).
+template <class T>
+bool luFactor(std::size_t n, T* a, std::size_t lda, int* pivots, std::size_t block = kLuBlock) {
+  block = std::max<std::size_t>(block, 1);
+  bool regular = true;
+  for (std::size_t k0 = 0; k0 < n; k0 += block) {
+    const std::size_t kb = std::min(block, n - k0);
+    const std::size_t rest = n - k0 - kb;
+    regular = luPanel(n - k0, kb, a + k0 * lda + k0, lda, pivots + k0) && regular;
+    for (std::size_t j = k0; j < k0 + kb; j++) pivots[j] += static_cast<int>(k0);
+    swapRows(k0, a, lda, pivots, k0, k0 + kb);
+    swapRows(rest, a + k0 + kb, lda, pivots, k0, k0 + kb);
+    solveLowerUnit(kb, rest, a + k0 * lda + k0, lda, a + k0 * lda + k0 + kb, lda);
+    gemmSubtract(rest, rest, kb, a + (k0 + kb) * lda + k0, lda, a + k0 * lda + k0 + kb, lda,
+                 a + (k0 + kb) * lda + k0 + kb, lda);
+  }
+  return regular;
+}
+
+// Solves A x = b in place (b becomes x) with the factors from luFactor().
+template <class T>
+void luSolve(std::size_t n, const T* lu, std::size_t lda, const int* pivots, T* b) {
+  swapRows(1, b, 1, pivots, 0, n);
+  solveLowerUnit(n, 1, lu, lda, b, 1);
+  solveUpper(n, 1, lu, lda, b, 1);
+}
+
+// Solves A^T x = b in place with the factors from luFactor(): A^T = U^T L^T P,
+// so the swaps are undone last, in reverse order.
+template <class T>
+void luSolveTransposed(std::size_t n, const T* lu, std::size_t lda, const int* pivots, T* b) {
+  solveUpperTransposed(n, 1, lu, lda, b, 1);
+  solveLowerUnitTransposed(n, 1, lu, lda, b, 1);
+  for (std::size_t i = n; i-- > 0;) std::swap(b[i], b[pivots[i]]);
+}
+
+// det A = sign * exp(log_abs), kept in log form so that large matrices do not
+// overflow; sign is 0 for a singular matrix.
+struct Determinant {
+  int sign{};
+  double log_abs{};
+
+  [[nodiscard]] double value() const { return sign == 0 ? 0.0 : sign * std::exp(log_abs); }
+};
+
+// Determinant of the product of the diagonal entries `diagonal(i)`, i < n,
+// with `swaps` row swaps.
+template <class Diagonal>
+Determinant diagonalDeterminant(std::size_t n, Diagonal diagonal, std::size_t swaps) {
+  Determinant det{swaps % 2 == 0 ? 1 : -1, 0.0};
+  for (std::size_t i = 0; i < n; i++) {
+    const double value = static_cast<double>(diagonal(i));
+    if (value == 0.0) return {};
+    if (value < 0.0) det.sign = -det.sign;
+    det.log_abs += std::log(std::abs(value));
+  }
+  return det;
+}
+
+// det A from the factors of luFactor(): det P^-1 times the product of U's
+// diagonal, a by-product of the factorisation at O(n) cost.
+template <class T>
+Determinant luDeterminant(std::size_t n, const T* lu, std::size_t lda, const int* pivots) {
+  std::size_t swaps = 0;
+  for (std::size_t i = 0; i < n; i++) swaps += static_cast<std::size_t>(pivots[i]) != i ? 1 : 0;
+  return diagonalDeterminant(n, [&](std::size_t i) { return lu[i * lda + i]; }, swaps);
+}
+
+// max_j sum_i |a_ij| of the row-major m x n matrix `a`.
+template <class T>
+double oneNorm(std::size_t m, std::size_t n, const T* a, std::size_t lda) {
+  std::vector<double> sums(n, 0.0);
+  for (std::size_t i = 0; i < m; i++) {
+    for (std::size_t j = 0; j < n; j++) sums[j] += std::abs(static_cast<double>(a[i * lda + j]));
+  }
+  return n == 0 ? 0.0 : *std::max_element(sums.begin(), sums.end());
+}
+
+// Hager's estimate of ||A^-1||_1 (with Higham's refinements, as LAPACK's
+// lacon) from at most five pairs of solves: solve(v) overwrites the n
+// values of v with A^-1 v and solve_transposed(v) with A^-T v. It is a lower
+// bound, almost always within a factor of a few of the true value; times
+// ||A||_1 it estimates the condition number for O(n^2) work on top of the
+// O(n^3) factorisation. The callbacks may be collective as long as every
+// process sees the same vectors.
+template <class T, class Solve, class SolveTransposed>
+double estimateInverseNorm1(std::size_t n, Solve solve, SolveTransposed solve_transposed) {
+  if (n == 0) return 0.0;
+  const auto norm1 = [](const std::vector<T>& v) {
+    double sum = 0.0;
+    for (const T& value : v) sum += std::abs(static_cast<double>(value));
+    return sum;
+  };
+  std::vector<T> x(n, T{1} / static_cast<T>(n));
+  std::vector<T> z(n);
+  double estimate = 0.0;
+  std::size_t last = n;
+  for (int iteration = 0; iteration < 5; iteration++) {
+    solve(x.data());
+    const double value = norm1(x);
+    if (iteration > 0 && value <= estimate) break;
+    estimate = value;
+    for (std::size_t i = 0; i < n; i++) z[i] = x[i] >= T{} ? T{1} : T{-1};
+    solve_transposed(z.data());
+    const auto j = static_cast<std::size_t>(
+        std::max_element(z.begin(), z.end(), [](T a, T b) { return std::abs(a) < std::abs(b); }) - z.begin());
+    if (iteration > 0 && j == last) break;
+    last = j;
+    std::fill(x.begin(), x.end(), T{});
+    x[j] = T{1};
+  }
+  // Alternating-sign vector that catches the cases the iteration misses.
+  for (std::size_t i = 0; i < n; i++) {
+    const double magnitude = 1.0 + (n > 1 ? static_cast<double>(i) / static_cast<double>(n - 1) : 0.0);
+    x[i] = static_cast<T>(i % 2 == 0 ? magnitude : -magnitude);
+  }
+  solve(x.data());
+  return std::max(estimate, 2.0 * norm1(x) / (3.0 * static_cast<double>(n)));
+}
+
+// Solves A X = B in place for the n x nrhs row-major matrix `b` (leading
+// dimension ldb) with the factors from luFactor(). The right-hand sides are
+// independent, so they are split into blocks of columns over `num_threads`
+// threads; each block runs the substitutions with unit-stride inner loops
+// over its columns.
+template <class T>
+void luSolve(std::size_t n, const T* lu, std::size_t lda, const int* pivots, T* b, std::size_t nrhs,
+             std::size_t ldb, int num_threads = detail::defaultThreads()) {
+  const std::size_t min_columns = std::max<std::size_t>(1, detail::kMinChunk / std::max<std::size_t>(1, n * n));
+  detail::forEachChunk(
+      nrhs, num_threads,
+      [&](std::size_t /*chunk*/, std::size_t begin, std::size_t end) {
+        swapRows(end - begin, b + begin, ldb, pivots, 0, n);
+        solveLowerUnit(n, end - begin, lu, lda, b + begin, ldb);
+        solveUpper(n, end - begin, lu, lda, b + begin, ldb);
+      },
+      min_columns);
+}
+
+// 64-bit fingerprint of `count` values (of their bytes), for keying caches of
+// results computed from them. Values that differ in any bit, including 0.0 and
+// -0.0, get different fingerprints up to the usual hash collisions.
+template <class T>
+std::uint64_t fingerprint(const T* data, std::size_t count) {
+  constexpr std::uint64_t kPrime = 0x100000001b3ULL;
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+  const std::size_t size = count * sizeof(T);
+  std::uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+  std::size_t i = 0;
+  for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * kPrime;
+    hash ^= hash >> 29;
+  }
+  for (; i < size; i++) hash = (hash ^ bytes[i]) * kPrime;
+  return hash;
+}
+
+// P A = L U of an n x n matrix as luFactor() leaves it.
+template <class T>
+struct LuFactors {
+  std::size_t n{};
+  std::vector<T> lu;
+  std::vector<int> pivots;
+  bool regular{};
+  double a_norm{};  // ||A||_1, for conditionEstimate()
+
+  static LuFactors factorise(std::size_t n, const T* a, std::size_t block = kLuBlock) {
+    LuFactors factors{n, std::vector<T>(a, a + n * n), std::vector<int>(n), false, oneNorm(n, n, a, n)};
+    factors.regular = luFactor(n, factors.lu.data(), n, factors.pivots.data(), block);
+    return factors;
+  }
+
+  // X = A^-1 B in place for the n x nrhs row-major matrix `b`.
+  void solve(T* b, std::size_t nrhs = 1, int num_threads = detail::defaultThreads()) const {
+    luSolve(n, lu.data(), n, pivots.data(), b, nrhs, nrhs, num_threads);
+  }
+
+  [[nodiscard]] Determinant determinant() const { return luDeterminant(n, lu.data(), n, pivots.data()); }
+
+  // Estimate of the 1-norm condition number, infinite for a singular A.
+  [[nodiscard]] double conditionEstimate() const {
+    if (!regular) return std::numeric_limits<double>::infinity();
+    return a_norm * estimateInverseNorm1<T>(
+                        n, [&](T* v) { luSolve(n, lu.data(), n, pivots.data(), v); },
+                        [&](T* v) { luSolveTransposed(n, lu.data(), n, pivots.data(), v); });
+  }
+};
+
+// Keeps the factors of the last `capacity` matrices factorised through it,
+// keyed by n and fingerprint(), so repeated solves against the same A pay for
+// the O(n^3) factorisation once and for the O(n^2) fingerprint after that.
+template <class T>
+class LuFactorCache {
+ public:
+  explicit LuFactorCache(std::size_t capacity = 4) : capacity_(std::max<std::size_t>(capacity, 1)) {}
+
+  std::shared_ptr<const LuFactors<T>> factorise(std::size_t n, const T* a, std::size_t block = kLuBlock) {
+    const std::uint64_t key = fingerprint(a, n * n);
+    const auto hit = std::find_if(entries_.begin(), entries_.end(),
+                                  [&](const Entry& entry) { return entry.key == key && entry.factors->n == n; });
+    if (hit != entries_.end()) {
+      hits_++;
+      std::rotate(entries_.begin(), hit, hit + 1);
+      return entries_.front().factors;
+    }
+    misses_++;
+    auto factors = std::make_shared<const LuFactors<T>>(LuFactors<T>::factorise(n, a, block));
+    if (entries_.size() == capacity_) entries_.pop_back();
+    entries_.insert(entries_.begin(), Entry{key, factors});
+    return factors;
+  }
+
+  [[nodiscard]] std::size_t hits() const { return hits_; }
+  [[nodiscard]] std::size_t misses() const { return misses_; }
+  [[nodiscard]] std::size_t size() const { return entries_.size(); }
+  void clear() { entries_.clear(); }
+
+ private:
+  struct Entry {
+    std::uint64_t key;
+    std::shared_ptr<const LuFactors<T>> factors;
+  };
+
+  std::size_t capacity_;
+  std::vector<Entry> entries_;  // most recently used first
+  std::size_t hits_{};
+  std::size_t misses_{};
+};
+
+// Settings of mixed-precision iterative refinement (refineSolution()).
+// `tolerance` bounds the normwise backward error ||B - A X|| / (||A|| ||X||)
+// (infinity norms, worst column); 0 means sqrt(n) * epsilon of the working
+// precision, the criterion of LAPACK's dsgesv. The refinement stalls when a
+// step fails to shrink the residual below `stall_ratio` times the previous one.
+struct RefinementParams {
+  double tolerance = 0.0;
+  int max_iterations = 30;
+  double stall_ratio = 0.5;
+};
+
+// `converged`: the refinement reached the tolerance. `fell_back`: it did not
+// and the system was solved again with a working-precision factorisation.
+// `iterations`: corrections applied. `residual`: final backward error.
+struct RefinementResult {
+  bool converged{};
+  bool fell_back{};
+  int iterations{};
+  double residual{};
+};
+
+// max_i sum_j |a_ij| of the row-major m x n matrix `a`.
+template <class T>
+double infinityNorm(std::size_t m, std::size_t n, const T* a, std::size_t lda) {
+  double norm = 0.0;
+  for (std::size_t i = 0; i < m; i++) {
+    double sum = 0.0;
+    for (std::size_t j = 0; j < n; j++) sum += std::abs(static_cast<double>(a[i * lda + j]));
+    norm = std::max(norm, sum);
+  }
+  return norm;
+}
+
+// Worst normwise backward error over the columns of the n x nrhs residual `r`
+// of the solution `x`, for a matrix of infinity norm `a_norm`.
+template <class T>
+double backwardError(std::size_t n, std::size_t nrhs, double a_norm, const T* x, const T* r) {
+  double worst = 0.0;
+  for (std::size_t c = 0; c < nrhs; c++) {
+    double r_norm = 0.0;
+    double x_norm = 0.0;
+    for (std::size_t i = 0; i < n; i++) {
+      r_norm = std::max(r_norm, std::abs(static_cast<double>(r[i * nrhs + c])));
+      x_norm = std::max(x_norm, std::abs(static_cast<double>(x[i * nrhs + c])));
+    }
+    const double error = r_norm == 0.0 ? 0.0 : r_norm / (a_norm * x_norm);
+    // NaN (from an overflowing low-precision solve) must never look converged.
+    if (std::isnan(error)) return error;
+    worst = std::max(worst, error);
+  }
+  return worst;
+}
+
+// Iterative refinement of the n x nrhs solution `x` of A X = B computed in a
+// lower precision: r = B - A X is formed in the working precision T by
+// residual(x, r), correct(r) overwrites r with A^-1 r using the low-precision
+// factors and X += r, until the backward error meets the tolerance, stalls or
+// the iterations run out. Both callbacks may be collective as long as every
+// process sees the same x and r. Sets converged, iterations and residual.
+template <class T, class Residual, class Correct>
+RefinementResult refineSolution(std::size_t n, std::size_t nrhs, double a_norm, T* x, Residual residual,
+                                Correct correct, const RefinementParams& params = {}) {
+  const double tolerance = params.tolerance > 0.0
+                               ? params.tolerance
+                               : std::sqrt(static_cast<double>(n)) * std::numeric_limits<T>::epsilon();
+  RefinementResult result;
+  std::vector<T> r(n * nrhs);
+  double previous = std::numeric_limits<double>::infinity();
+  for (;;) {
+    residual(x, r.data());
+    result.residual = backwardError(n, nrhs, a_norm, x, r.data());
+    if (result.residual <= tolerance) {
+      result.converged = true;
+      return result;
+    }
+    if (!(result.residual < params.stall_ratio * previous) || result.iterations == params.max_iterations) {
+      return result;
+    }
+    previous = result.residual;
+    correct(r.data());
+    for (std::size_t i = 0; i < n * nrhs; i++) x[i] += r[i];
+    result.iterations++;
+  }
+}
+
+// Solves A X = B (b: n x nrhs, overwritten by X) by factorising A in the lower
+// precision Low, which halves the memory traffic of the O(n^3) part for
+// float, and refining the solution to the accuracy of T with
+// refineSolution(). If the refinement does not converge (A too
+// ill-conditioned or out of the range of Low) A is factorised again in T and
+// the system solved directly. Returns false only if A is singular in T. The
+// substitutions run on `num_threads` threads as in luSolve().
+template <class Low, class T>
+bool luSolveMixed(std::size_t n, const T* a, T* b, std::size_t nrhs, RefinementResult& result,
+                  const RefinementParams& params = {}, std::size_t block = kLuBlock,
+                  int num_threads = detail::defaultThreads()) {
+  const std::vector<T> rhs(b, b + n * nrhs);
+  const double a_norm = infinityNorm(n, n, a, n);
+  std::vector<Low> low(a, a + n * n);
+  std::vector<int> pivots(n);
+  std::vector<Low> work(n * nrhs);
+  const auto solve_low = [&](T* v) {
+    std::copy(v, v + n * nrhs, work.begin());
+    luSolve(n, low.data(), n, pivots.data(), work.data(), nrhs, nrhs, num_threads);
+    std::copy(work.begin(), work.end(), v);
+  };
+  const auto residual = [&](const T* x, T* r) {
+    std::copy(rhs.begin(), rhs.end(), r);
+    gemmSubtract(n, nrhs, n, a, n, x, nrhs, r, nrhs);
+  };
+  result = {};
+  if (luFactor(n, low.data(), n, pivots.data(), block)) {
+    solve_low(b);
+    result = refineSolution(n, nrhs, a_norm, b, residual, solve_low, params);
+    if (result.converged) return true;
+  }
+  result.fell_back = true;
+  const auto factors = LuFactors<T>::factorise(n, a, block);
+  if (!factors.regular) return false;
+  std::copy(rhs.begin(), rhs.end(), b);
+  factors.solve(b, nrhs, num_threads);
+  std::vector<T> r(n * nrhs);
+  residual(b, r.data());
+  result.residual = backwardError(n, nrhs, a_norm, b, r.data());
+  return true;
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_LU_HPP_
@@ -0,0 +1,39 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_PARALLEL_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_PARALLEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ppc::core::kernels::detail {
+
+// Default smallest chunk worth a thread of its own.
+constexpr std::size_t kMinChunk = std::size_t{1} << 14;
+
+// Splits [0, n) into at most `num_threads` chunks of at least `min_chunk` items
+// and runs body(chunk, begin, end) for every chunk on its own thread (chunk 0
+// on the calling one). Returns the number of chunks.
+template <class Body>
+std::size_t forEachChunk(std::size_t n, int num_threads, Body body, std::size_t min_chunk = kMinChunk) {
+  const std::size_t max_chunks = std::max<std::size_t>(1, n / std::max<std::size_t>(min_chunk, 1));
+  const std::size_t chunks = std::min<std::size_t>(std::max(num_threads, 1), max_chunks);
+  const std::size_t step = (n + chunks - 1) / chunks;
+  std::vector<std::thread> threads;
+  for (std::size_t c = 1; c < chunks; c++) {
+    threads.emplace_back(body, c, std::min(n, c * step), std::min(n, (c + 1) * step));
+  }
+  body(0, 0, std::min(n, step));
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return chunks;
+}
+
+inline int defaultThreads() { return std::max(1, static_cast<int>(std::thread::hardware_concurrency())); }
+
+}  // namespace ppc::core::kernels::detail
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_PARALLEL_HPP_
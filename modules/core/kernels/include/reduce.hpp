@@ -0,0 +1,78 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_REDUCE_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_REDUCE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "core/kernels/include/simd.hpp"
+
+namespace ppc::core::kernels {
+
+// Folds data[0..n) into kSimdLanes<Acc> independent partial results that are
+// combined at the end. The lane count follows the accumulator width, so the
+// inner loop fills exactly one vector register for every element type.
+template <class Acc, class T, class Op>
+Acc foldLanes(const T* data, std::size_t n, Acc init, Op op) {
+  constexpr std::size_t kLanes = kSimdLanes<Acc>;
+  Acc lanes[kLanes];
+  std::fill(lanes, lanes + kLanes, init);
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    for (std::size_t k = 0; k < kLanes; k++) {
+      lanes[k] = op(lanes[k], static_cast<Acc>(data[i + k]));
+    }
+  }
+  for (std::size_t k = 0; i < n; i++, k++) {
+    lanes[k] = op(lanes[k], static_cast<Acc>(data[i]));
+  }
+  for (std::size_t width = kLanes / 2; width > 0; width /= 2) {
+    for (std::size_t k = 0; k < width; k++) {
+      lanes[k] = op(lanes[k], lanes[k + width]);
+    }
+  }
+  return lanes[0];
+}
+
+// Sum of data[0..n) in the widened accumulator type (int64 for integers).
+// 8- and 16-bit integers are folded in 32-bit lanes, twice as many per
+// register as 64-bit ones, over blocks short enough that a block sum cannot
+// overflow; only the block sums are widened.
+template <class T>
+WideningAccumulatorT<T> sum(const T* data, std::size_t n) {
+  using Acc = WideningAccumulatorT<T>;
+  if constexpr (std::is_integral_v<T> && sizeof(T) < sizeof(std::int32_t)) {
+    using Narrow = std::conditional_t<std::is_signed_v<T>, std::int32_t, std::uint32_t>;
+    // kBlock elements of magnitude at most 2^(8 sizeof(T)) stay within Narrow.
+    constexpr std::size_t kBlock =
+        (static_cast<std::size_t>(std::numeric_limits<Narrow>::max()) >> (8 * sizeof(T))) / kSimdLanes<Narrow> *
+        kSimdLanes<Narrow>;
+    Acc total{};
+    for (std::size_t i = 0; i < n; i += kBlock) {
+      total += foldLanes<Narrow>(data + i, std::min(kBlock, n - i), Narrow{}, [](Narrow a, Narrow b) { return a + b; });
+    }
+    return total;
+  } else {
+    return foldLanes<Acc>(data, n, Acc{}, [](Acc a, Acc b) { return a + b; });
+  }
+}
+
+// Smallest element, std::numeric_limits<T>::max() for an empty range.
+template <class T>
+T minimum(const T* data, std::size_t n) {
+  return foldLanes<T>(data, n, std::numeric_limits<T>::max(), [](T a, T b) { return std::min(a, b); });
+}
+
+// Largest element, std::numeric_limits<T>::lowest() for an empty range.
+template <class T>
+T maximum(const T* data, std::size_t n) {
+  return foldLanes<T>(data, n, std::numeric_limits<T>::lowest(), [](T a, T b) { return std::max(a, b); });
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_REDUCE_HPP_
@@ -0,0 +1,185 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_SCAN_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_SCAN_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/parallel.hpp"
+#include "core/kernels/include/reduce.hpp"
+#include "core/kernels/include/simd.hpp"
+
+namespace ppc::core::kernels {
+
+namespace detail {
+
+// Inclusive scan of one block of kLanes values held in registers: log2(kLanes)
+// shift-and-add steps instead of kLanes dependent additions.
+template <std::size_t kLanes, class Out>
+void scanBlock(Out* block) {
+  for (std::size_t shift = 1; shift < kLanes; shift *= 2) {
+    Out prev[kLanes];
+    std::copy(block, block + kLanes, prev);
+    for (std::size_t k = shift; k < kLanes; k++) {
+      block[k] = prev[k] + prev[k - shift];
+    }
+  }
+}
+
+template <bool kInclusive, class T, class Out>
+Out scanLanes(const T* in, std::size_t n, Out* out, Out offset) {
+  constexpr std::size_t kLanes = kSimdLanes<Out>;
+  Out carry = offset;
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    Out block[kLanes];
+    for (std::size_t k = 0; k < kLanes; k++) {
+      block[k] = static_cast<Out>(in[i + k]);
+    }
+    scanBlock<kLanes>(block);
+    // `in` is read before `out` is written, so the scan may run in place.
+    if constexpr (kInclusive) {
+      for (std::size_t k = 0; k < kLanes; k++) {
+        out[i + k] = carry + block[k];
+      }
+    } else {
+      out[i] = carry;
+      for (std::size_t k = 1; k < kLanes; k++) {
+        out[i + k] = carry + block[k - 1];
+      }
+    }
+    carry = carry + block[kLanes - 1];
+  }
+  for (; i < n; i++) {
+    const auto value = static_cast<Out>(in[i]);
+    if constexpr (kInclusive) {
+      carry = carry + value;
+      out[i] = carry;
+    } else {
+      out[i] = carry;
+      carry = carry + value;
+    }
+  }
+  return carry;
+}
+
+template <bool kInclusive, class T, class Out>
+Out parallelScan(const T* in, std::size_t n, Out* out, Out offset, int num_threads) {
+  // Work-efficient two-pass scan: every thread sums its chunk, the chunk sums are
+  // scanned serially (one value per thread), then every thread scans its chunk
+  // starting from its offset. Each element is read twice and written once.
+  std::vector<Out> chunk_offset(std::max(num_threads, 1) + 1, Out{});
+  const std::size_t chunks = forEachChunk(n, num_threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+    chunk_offset[c + 1] = foldLanes<Out>(in + begin, end - begin, Out{}, [](Out a, Out b) { return a + b; });
+  });
+  chunk_offset[0] = offset;
+  for (std::size_t c = 1; c <= chunks; c++) {
+    chunk_offset[c] = chunk_offset[c - 1] + chunk_offset[c];
+  }
+  forEachChunk(n, num_threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+    scanLanes<kInclusive>(in + begin, end - begin, out + begin, chunk_offset[c]);
+  });
+  return chunk_offset[chunks];
+}
+
+}  // namespace detail
+
+// out[i] = offset + in[0] + ... + in[i]. Values are accumulated in Out, so an
+// int8 input can be scanned into int64 without overflow. Returns offset plus
+// the sum of the whole range. `out` may alias `in` when T and Out match.
+template <class T, class Out>
+Out inclusiveScan(const T* in, std::size_t n, Out* out, Out offset = Out{}) {
+  return detail::scanLanes<true>(in, n, out, offset);
+}
+
+// out[i] = offset + in[0] + ... + in[i - 1], out[0] = offset. Returns offset plus
+// the sum of the whole range, i.e. the value out[n] would have.
+template <class T, class Out>
+Out exclusiveScan(const T* in, std::size_t n, Out* out, Out offset = Out{}) {
+  return detail::scanLanes<false>(in, n, out, offset);
+}
+
+// Multithreaded versions of the scans above. Small ranges run on the calling
+// thread only. Floating point results may differ from the serial scan in the
+// last bits, as the additions are grouped differently.
+template <class T, class Out>
+Out parallelInclusiveScan(const T* in, std::size_t n, Out* out, Out offset = Out{},
+                          int num_threads = detail::defaultThreads()) {
+  return detail::parallelScan<true>(in, n, out, offset, num_threads);
+}
+
+template <class T, class Out>
+Out parallelExclusiveScan(const T* in, std::size_t n, Out* out, Out offset = Out{},
+                          int num_threads = detail::defaultThreads()) {
+  return detail::parallelScan<false>(in, n, out, offset, num_threads);
+}
+
+// State of a segmented scan after a range: `value` is the running sum since the
+// last segment head and `has_head` tells whether the range contained a head.
+// Combining the states of two neighbouring ranges is associative, which is what
+// the threaded and the distributed versions rely on.
+template <class Out>
+struct SegmentCarry {
+  Out value{};
+  std::uint8_t has_head = 0;
+};
+
+template <class Out>
+SegmentCarry<Out> combineSegments(const SegmentCarry<Out>& left, const SegmentCarry<Out>& right) {
+  if (right.has_head != 0) {
+    return right;
+  }
+  return {left.value + right.value, left.has_head};
+}
+
+// Inclusive scan that restarts at every i with heads[i] != 0. `carry` is the
+// running sum coming from the left of in[0]; it only reaches the elements before
+// the first head. Returns the carry after in[n - 1].
+template <class T, class Out>
+SegmentCarry<Out> segmentedInclusiveScan(const T* in, const std::uint8_t* heads, std::size_t n, Out* out,
+                                         SegmentCarry<Out> carry = {}) {
+  for (std::size_t i = 0; i < n; i++) {
+    const auto value = static_cast<Out>(in[i]);
+    if (heads[i] != 0) {
+      carry.value = value;
+      carry.has_head = 1;
+    } else {
+      carry.value = carry.value + value;
+    }
+    out[i] = carry.value;
+  }
+  return carry;
+}
+
+template <class T, class Out>
+SegmentCarry<Out> parallelSegmentedInclusiveScan(const T* in, const std::uint8_t* heads, std::size_t n, Out* out,
+                                                 int num_threads = detail::defaultThreads()) {
+  std::vector<SegmentCarry<Out>> chunk_carry(std::max(num_threads, 1) + 1);
+  const std::size_t chunks =
+      detail::forEachChunk(n, num_threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        SegmentCarry<Out> carry;
+        for (std::size_t i = begin; i < end; i++) {
+          if (heads[i] != 0) {
+            carry = {static_cast<Out>(in[i]), 1};
+          } else {
+            carry.value = carry.value + static_cast<Out>(in[i]);
+          }
+        }
+        chunk_carry[c + 1] = carry;
+      });
+  chunk_carry[0] = {};
+  for (std::size_t c = 1; c <= chunks; c++) {
+    chunk_carry[c] = combineSegments(chunk_carry[c - 1], chunk_carry[c]);
+  }
+  detail::forEachChunk(n, num_threads, [&](std::size_t c, std::size_t begin, std::size_t end) {
+    segmentedInclusiveScan(in + begin, heads + begin, end - begin, out + begin, chunk_carry[c]);
+  });
+  return chunk_carry[chunks];
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_SCAN_HPP_
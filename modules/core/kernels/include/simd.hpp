@@ -0,0 +1,63 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_SIMD_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_SIMD_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ppc::core::kernels {
+
+// Width of the vector registers the kernels are tuned for (AVX2). Kernels keep
+// kSimdLanes<T> independent partial results, so narrow element types get
+// proportionally more lanes: 32 for int8, 16 for int16, 8 for int32/float and
+// 4 for int64/double.
+constexpr std::size_t kSimdBytes = 32;
+
+template <class T>
+constexpr std::size_t kSimdLanes = kSimdBytes / sizeof(T) > 0 ? kSimdBytes / sizeof(T) : 1;
+
+// Type in which sums of T are accumulated. Integers are widened to 64 bit so that
+// sums and products of narrow values do not overflow, floating point types keep
+// their own precision (and SIMD width).
+template <class T>
+struct WideningAccumulator {
+  using type = std::conditional_t<std::is_floating_point_v<T>, T,
+                                  std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+};
+
+template <class T>
+using WideningAccumulatorT = typename WideningAccumulator<T>::type;
+
+// Short name of an element type, used in perf reports.
+template <class T>
+constexpr const char* typeName() {
+  if constexpr (std::is_same_v<T, std::int8_t>) {
+    return "int8";
+  } else if constexpr (std::is_same_v<T, std::uint8_t>) {
+    return "uint8";
+  } else if constexpr (std::is_same_v<T, std::int16_t>) {
+    return "int16";
+  } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+    return "uint16";
+  } else if constexpr (std::is_same_v<T, std::int32_t>) {
+    return "int32";
+  } else if constexpr (std::is_same_v<T, std::uint32_t>) {
+    return "uint32";
+  } else if constexpr (std::is_same_v<T, std::int64_t>) {
+    return "int64";
+  } else if constexpr (std::is_same_v<T, std::uint64_t>) {
+    return "uint64";
+  } else if constexpr (std::is_same_v<T, float>) {
+    return "float32";
+  } else if constexpr (std::is_same_v<T, double>) {
+    return "float64";
+  } else {
+    return "unknown";
+  }
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_SIMD_HPP_
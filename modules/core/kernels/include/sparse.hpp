@@ -0,0 +1,204 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_SPARSE_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_SPARSE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include "core/kernels/include/dot_product.hpp"
+#include "core/kernels/include/parallel.hpp"
+#include "core/kernels/include/simd.hpp"
+
+namespace ppc::core::kernels {
+
+// Compressed sparse row matrix: the non-zeros of row r are
+// values[row_ptr[r] .. row_ptr[r + 1]) in columns col_idx[same range], sorted
+// by column. Indices are 32-bit, as they travel through TaskData and MPI.
+template <class T>
+struct CsrMatrix {
+  std::size_t rows{};
+  std::size_t cols{};
+  std::vector<int> row_ptr{0};
+  std::vector<int> col_idx;
+  std::vector<T> values;
+
+  [[nodiscard]] std::size_t nnz() const { return values.size(); }
+
+  // Keeps the non-zero entries of the row-major rows x cols matrix `a`.
+  static CsrMatrix fromDense(std::size_t rows, std::size_t cols, const T* a) {
+    CsrMatrix matrix;
+    matrix.rows = rows;
+    matrix.cols = cols;
+    matrix.row_ptr.reserve(rows + 1);
+    for (std::size_t i = 0; i < rows; i++) {
+      for (std::size_t j = 0; j < cols; j++) {
+        if (a[i * cols + j] != T{}) {
+          matrix.col_idx.push_back(static_cast<int>(j));
+          matrix.values.push_back(a[i * cols + j]);
+        }
+      }
+      matrix.row_ptr.push_back(static_cast<int>(matrix.values.size()));
+    }
+    return matrix;
+  }
+
+  // Entry (i, j), zero if it is not stored.
+  [[nodiscard]] T at(std::size_t i, std::size_t j) const {
+    for (int k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+      if (static_cast<std::size_t>(col_idx[k]) == j) return values[k];
+    }
+    return T{};
+  }
+};
+
+// True if row_ptr, col_idx and values describe a rows x cols CSR matrix with
+// nnz entries and sorted, in-range, distinct columns in every row. Meant for
+// task validation of CSR input.
+inline bool isValidCsr(std::size_t rows, std::size_t cols, std::size_t nnz, const int* row_ptr, const int* col_idx) {
+  if (row_ptr[0] != 0 || static_cast<std::size_t>(row_ptr[rows]) != nnz) return false;
+  for (std::size_t i = 0; i < rows; i++) {
+    if (row_ptr[i] > row_ptr[i + 1]) return false;
+    for (int k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+      if (col_idx[k] < 0 || static_cast<std::size_t>(col_idx[k]) >= cols) return false;
+      if (k > row_ptr[i] && col_idx[k] <= col_idx[k - 1]) return false;
+    }
+  }
+  return true;
+}
+
+// y[i] = (A x)[i] for the rows i in [row_begin, row_end).
+template <class T>
+void spmvRows(const CsrMatrix<T>& a, const T* x, T* y, std::size_t row_begin, std::size_t row_end) {
+  using Acc = DotAccumulatorT<T>;
+  for (std::size_t i = row_begin; i < row_end; i++) {
+    Acc acc{};
+    for (int k = a.row_ptr[i]; k < a.row_ptr[i + 1]; k++) {
+      acc = multiplyAdd<Acc>(a.values[k], x[a.col_idx[k]], acc);
+    }
+    y[i] = static_cast<T>(acc);
+  }
+}
+
+// y = A x.
+template <class T>
+void spmv(const CsrMatrix<T>& a, const T* x, T* y) {
+  spmvRows(a, x, y, 0, a.rows);
+}
+
+// y = A x on num_threads threads. Threads get row ranges with about the same
+// number of non-zeros rather than the same number of rows, so a few long rows
+// do not leave the other threads idle.
+template <class T>
+void parallelSpmv(const CsrMatrix<T>& a, const T* x, T* y, int num_threads) {
+  const auto row_at = [&](std::size_t nz) {
+    if (nz == a.nnz()) return a.rows;
+    const auto first = a.row_ptr.begin();
+    return static_cast<std::size_t>(std::lower_bound(first, first + a.rows, static_cast<int>(nz)) - first);
+  };
+  detail::forEachChunk(a.nnz(), num_threads, [&](std::size_t /*chunk*/, std::size_t begin, std::size_t end) {
+    spmvRows(a, x, y, row_at(begin), row_at(end));
+  });
+}
+
+// SELL-C-sigma matrix: rows are grouped into chunks of `chunk` rows (C) and
+// each chunk is stored column by column, padded to its longest row, so the
+// inner loop of the product runs over C independent rows with unit stride -
+// one SIMD lane per row. Within every window of `sigma` rows the rows are
+// sorted by decreasing length first, which keeps the padding small; `perm`
+// maps the storage slot of a row back to its row index.
+template <class T>
+struct SellMatrix {
+  std::size_t rows{};
+  std::size_t cols{};
+  std::size_t chunk{};
+  std::vector<int> perm;
+  // Chunk k occupies [chunk_ptr[k], chunk_ptr[k + 1]) of col_idx/values, with
+  // entry j of slot s of the chunk at chunk_ptr[k] + j * chunk + s.
+  std::vector<std::size_t> chunk_ptr{0};
+  std::vector<int> col_idx;
+  std::vector<T> values;
+
+  [[nodiscard]] std::size_t chunks() const { return chunk_ptr.size() - 1; }
+  // Stored entries including the padding.
+  [[nodiscard]] std::size_t storedEntries() const { return values.size(); }
+
+  static SellMatrix fromCsr(const CsrMatrix<T>& a, std::size_t chunk = kSimdLanes<T>, std::size_t sigma = 1) {
+    SellMatrix matrix;
+    matrix.rows = a.rows;
+    matrix.cols = a.cols;
+    matrix.chunk = std::max<std::size_t>(chunk, 1);
+    const auto length = [&](int row) { return a.row_ptr[row + 1] - a.row_ptr[row]; };
+    matrix.perm.resize(a.rows);
+    std::iota(matrix.perm.begin(), matrix.perm.end(), 0);
+    const std::size_t window = std::max<std::size_t>(sigma, 1);
+    for (std::size_t begin = 0; begin < a.rows && window > 1; begin += window) {
+      const auto first = matrix.perm.begin() + static_cast<std::ptrdiff_t>(begin);
+      const auto last = matrix.perm.begin() + static_cast<std::ptrdiff_t>(std::min(a.rows, begin + window));
+      std::stable_sort(first, last, [&](int lhs, int rhs) { return length(lhs) > length(rhs); });
+    }
+    const std::size_t c = matrix.chunk;
+    for (std::size_t slot0 = 0; slot0 < a.rows; slot0 += c) {
+      int width = 0;
+      for (std::size_t s = slot0; s < std::min(a.rows, slot0 + c); s++) width = std::max(width, length(matrix.perm[s]));
+      const std::size_t base = matrix.chunk_ptr.back();
+      // Padding multiplies a zero by x[0]; rows are empty when cols == 0.
+      matrix.col_idx.resize(base + width * c, 0);
+      matrix.values.resize(base + width * c, T{});
+      for (std::size_t s = slot0; s < std::min(a.rows, slot0 + c); s++) {
+        const int row = matrix.perm[s];
+        for (int j = 0; j < length(row); j++) {
+          matrix.col_idx[base + j * c + (s - slot0)] = a.col_idx[a.row_ptr[row] + j];
+          matrix.values[base + j * c + (s - slot0)] = a.values[a.row_ptr[row] + j];
+        }
+      }
+      matrix.chunk_ptr.push_back(base + width * c);
+    }
+    return matrix;
+  }
+};
+
+// y = A x for the rows stored in chunks [chunk_begin, chunk_end).
+template <class T>
+void spmvChunks(const SellMatrix<T>& a, const T* x, T* y, std::size_t chunk_begin, std::size_t chunk_end) {
+  using Acc = DotAccumulatorT<T>;
+  const std::size_t c = a.chunk;
+  std::vector<Acc> acc(c);
+  for (std::size_t k = chunk_begin; k < chunk_end; k++) {
+    const std::size_t base = a.chunk_ptr[k];
+    const std::size_t width = (a.chunk_ptr[k + 1] - base) / c;
+    std::fill(acc.begin(), acc.end(), Acc{});
+    for (std::size_t j = 0; j < width; j++) {
+      const T* values = a.values.data() + base + j * c;
+      const int* cols = a.col_idx.data() + base + j * c;
+      for (std::size_t s = 0; s < c; s++) {
+        acc[s] = multiplyAdd<Acc>(values[s], x[cols[s]], acc[s]);
+      }
+    }
+    for (std::size_t s = 0; s < c && k * c + s < a.rows; s++) {
+      y[a.perm[k * c + s]] = static_cast<T>(acc[s]);
+    }
+  }
+}
+
+// y = A x.
+template <class T>
+void spmv(const SellMatrix<T>& a, const T* x, T* y) {
+  spmvChunks(a, x, y, 0, a.chunks());
+}
+
+// y = A x on num_threads threads, split by chunks.
+template <class T>
+void parallelSpmv(const SellMatrix<T>& a, const T* x, T* y, int num_threads) {
+  const std::size_t per_chunk = std::max<std::size_t>(1, a.storedEntries() / std::max<std::size_t>(1, a.chunks()));
+  detail::forEachChunk(
+      a.chunks(), num_threads,
+      [&](std::size_t /*chunk*/, std::size_t begin, std::size_t end) { spmvChunks(a, x, y, begin, end); },
+      std::max<std::size_t>(1, detail::kMinChunk / per_chunk));
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_SPARSE_HPP_
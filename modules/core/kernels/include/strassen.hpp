@@ -0,0 +1,191 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_STRASSEN_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_STRASSEN_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "core/kernels/include/gemm.hpp"
+
+namespace ppc::core::kernels {
+
+// Default size below which strassenMatmul() stops recursing and calls gemm().
+// Below a few hundred the packed kernel beats the extra O(n^2) additions.
+constexpr std::size_t kStrassenCrossover = 256;
+
+// Runs the seven sub-products of one recursion level one after another.
+// Task-parallel callers pass a functor with the same signature that forks the
+// calls (e.g. onto a tbb::task_group) and joins them before returning.
+struct SerialFork {
+  template <class... Tasks>
+  void operator()(Tasks&&... tasks) const {
+    (tasks(), ...);
+  }
+};
+
+// Shape of the recursion for an n x n product: the matrices are zero-padded to
+// `padded` = leaf * 2^levels, with leaf <= crossover. A crossover of 0 is
+// treated as 1.
+struct StrassenPlan {
+  std::size_t padded;
+  std::size_t leaf;
+  std::size_t levels;
+};
+
+inline StrassenPlan strassenPlan(std::size_t n, std::size_t crossover) {
+  crossover = std::max<std::size_t>(crossover, 1);
+  StrassenPlan plan{n, n, 0};
+  while (plan.leaf > crossover) {
+    plan.leaf = (plan.leaf + 1) / 2;
+    plan.levels++;
+  }
+  plan.padded = plan.leaf << plan.levels;
+  return plan;
+}
+
+// Forward error bound of strassenMatmul() for floating point T, in the max
+// norm: |C - fl(C)| <= [(n/n0)^log2(18) (n0^2 + 6 n0) - 6 n] u max|A| max|B|
+// with n0 the leaf size (Higham, Accuracy and Stability of Numerical
+// Algorithms, Thm. 23.4). The classical product is bounded by n u max|A| max|B|
+// per element, so the bound is what the extra speed costs in accuracy.
+template <class T>
+double strassenErrorBound(std::size_t n, std::size_t crossover, double max_abs_a, double max_abs_b) {
+  const StrassenPlan plan = strassenPlan(n, crossover);
+  const auto n0 = static_cast<double>(plan.leaf);
+  const auto padded = static_cast<double>(plan.padded);
+  const double growth = std::pow(padded / n0, std::log2(18.0)) * (n0 * n0 + 6.0 * n0) - 6.0 * padded;
+  const double unit_roundoff = std::numeric_limits<T>::epsilon() / 2;
+  return growth * unit_roundoff * max_abs_a * max_abs_b;
+}
+
+namespace detail {
+
+// out = a + b (or a - b) for n x n blocks with their own leading dimensions.
+template <class T, bool kSubtract>
+void combine(std::size_t n, const T* a, std::size_t lda, const T* b, std::size_t ldb, T* out, std::size_t ldo) {
+  for (std::size_t i = 0; i < n; i++) {
+    const T* a_row = a + i * lda;
+    const T* b_row = b + i * ldb;
+    T* out_row = out + i * ldo;
+    for (std::size_t j = 0; j < n; j++) {
+      out_row[j] = kSubtract ? a_row[j] - b_row[j] : a_row[j] + b_row[j];
+    }
+  }
+}
+
+// C = A * B for n x n blocks, Winograd's variant of Strassen's recursion:
+// seven half-size products and fifteen block additions per level. Each level
+// forms the operand sums S1..S4 and T1..T4, runs the seven products through
+// `fork` into separate buffers and combines them into the quadrants of C in one
+// fused pass.
+template <class T, class Fork>
+void strassenRecurse(std::size_t n, const T* a, std::size_t lda, const T* b, std::size_t ldb, T* c, std::size_t ldc,
+                     std::size_t crossover, const Fork& fork) {
+  if (n <= crossover || n % 2 != 0) {
+    for (std::size_t i = 0; i < n; i++) {
+      std::fill(c + i * ldc, c + i * ldc + n, T{});
+    }
+    gemm(n, n, n, a, lda, b, ldb, c, ldc);
+    return;
+  }
+  const std::size_t h = n / 2;
+  const std::size_t hh = h * h;
+  const T* a11 = a;
+  const T* a12 = a + h;
+  const T* a21 = a + h * lda;
+  const T* a22 = a21 + h;
+  const T* b11 = b;
+  const T* b12 = b + h;
+  const T* b21 = b + h * ldb;
+  const T* b22 = b21 + h;
+
+  std::vector<T> work(15 * hh);
+  T* s1 = work.data();
+  T* s2 = s1 + hh;
+  T* s3 = s2 + hh;
+  T* s4 = s3 + hh;
+  T* t1 = s4 + hh;
+  T* t2 = t1 + hh;
+  T* t3 = t2 + hh;
+  T* t4 = t3 + hh;
+  T* p1 = t4 + hh;
+  T* p2 = p1 + hh;
+  T* p3 = p2 + hh;
+  T* p4 = p3 + hh;
+  T* p5 = p4 + hh;
+  T* p6 = p5 + hh;
+  T* p7 = p6 + hh;
+
+  combine<T, false>(h, a21, lda, a22, lda, s1, h);  // S1 = A21 + A22
+  combine<T, true>(h, s1, h, a11, lda, s2, h);      // S2 = S1 - A11
+  combine<T, true>(h, a11, lda, a21, lda, s3, h);   // S3 = A11 - A21
+  combine<T, true>(h, a12, lda, s2, h, s4, h);      // S4 = A12 - S2
+  combine<T, true>(h, b12, ldb, b11, ldb, t1, h);   // T1 = B12 - B11
+  combine<T, true>(h, b22, ldb, t1, h, t2, h);      // T2 = B22 - T1
+  combine<T, true>(h, b22, ldb, b12, ldb, t3, h);   // T3 = B22 - B12
+  combine<T, true>(h, t2, h, b21, ldb, t4, h);      // T4 = T2 - B21
+
+  fork([&] { strassenRecurse(h, a11, lda, b11, ldb, p1, h, crossover, fork); },
+       [&] { strassenRecurse(h, a12, lda, b21, ldb, p2, h, crossover, fork); },
+       [&] { strassenRecurse(h, s4, h, b22, ldb, p3, h, crossover, fork); },
+       [&] { strassenRecurse(h, a22, lda, t4, h, p4, h, crossover, fork); },
+       [&] { strassenRecurse(h, s1, h, t1, h, p5, h, crossover, fork); },
+       [&] { strassenRecurse(h, s2, h, t2, h, p6, h, crossover, fork); },
+       [&] { strassenRecurse(h, s3, h, t3, h, p7, h, crossover, fork); });
+
+  for (std::size_t i = 0; i < h; i++) {
+    T* c11 = c + i * ldc;
+    T* c12 = c11 + h;
+    T* c21 = c + (i + h) * ldc;
+    T* c22 = c21 + h;
+    for (std::size_t j = 0; j < h; j++) {
+      const std::size_t idx = i * h + j;
+      const T u2 = p1[idx] + p6[idx];
+      const T u3 = u2 + p7[idx];
+      c11[j] = p1[idx] + p2[idx];
+      c12[j] = u2 + p5[idx] + p3[idx];
+      c21[j] = u3 - p4[idx];
+      c22[j] = u3 + p5[idx];
+    }
+  }
+}
+
+}  // namespace detail
+
+// C = A * B for contiguous row-major n x n matrices with Strassen-Winograd
+// recursion down to blocks of at most `crossover`, which go to gemm(). Sizes
+// that do not halve evenly down to the leaf are zero-padded once up front.
+// `fork` decides how the seven products of a level are run (see SerialFork).
+// For floating point T the result differs from matmul() by rounding, within
+// strassenErrorBound().
+template <class T, class Fork = SerialFork>
+void strassenMatmul(std::size_t n, const T* a, const T* b, T* c, std::size_t crossover = kStrassenCrossover,
+                    const Fork& fork = {}) {
+  const StrassenPlan plan = strassenPlan(n, crossover);
+  if (plan.padded == n) {
+    detail::strassenRecurse(n, a, n, b, n, c, n, crossover, fork);
+    return;
+  }
+  const std::size_t padded = plan.padded;
+  std::vector<T> a_padded(padded * padded, T{});
+  std::vector<T> b_padded(padded * padded, T{});
+  std::vector<T> c_padded(padded * padded);
+  for (std::size_t i = 0; i < n; i++) {
+    std::copy(a + i * n, a + (i + 1) * n, a_padded.begin() + static_cast<std::ptrdiff_t>(i * padded));
+    std::copy(b + i * n, b + (i + 1) * n, b_padded.begin() + static_cast<std::ptrdiff_t>(i * padded));
+  }
+  detail::strassenRecurse(padded, a_padded.data(), padded, b_padded.data(), padded, c_padded.data(), padded, crossover,
+                          fork);
+  for (std::size_t i = 0; i < n; i++) {
+    std::copy(c_padded.begin() + static_cast<std::ptrdiff_t>(i * padded),
+              c_padded.begin() + static_cast<std::ptrdiff_t>(i * padded + n), c + i * n);
+  }
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_STRASSEN_HPP_
@@ -0,0 +1,149 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_KERNELS_INCLUDE_TRANSPOSE_HPP_
+#define MODULES_CORE_KERNELS_INCLUDE_TRANSPOSE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "core/kernels/include/parallel.hpp"
+
+namespace ppc::core::kernels {
+
+// Side of the square tiles the leaves are transposed in: a tile is read row by
+// row into a local array small enough for the registers and written back
+// column by column, so both matrices are touched a full cache line at a time.
+constexpr std::size_t kTransposeTile = 8;
+// The recursion halves the longer side until both fit in this many elements,
+// at which point the blocks of both matrices sit in L1 whatever the cache size
+// (cache-oblivious: there is no tuning for a particular cache).
+constexpr std::size_t kTransposeLeaf = 64;
+
+namespace detail {
+
+template <class T>
+void transposeTile(const T* in, std::size_t ld_in, T* out, std::size_t ld_out) {
+  T tile[kTransposeTile][kTransposeTile];
+  for (std::size_t i = 0; i < kTransposeTile; i++) {
+    for (std::size_t j = 0; j < kTransposeTile; j++) {
+      tile[j][i] = in[i * ld_in + j];
+    }
+  }
+  for (std::size_t j = 0; j < kTransposeTile; j++) {
+    std::copy(tile[j], tile[j] + kTransposeTile, out + j * ld_out);
+  }
+}
+
+template <class T>
+void transposeLeaf(std::size_t rows, std::size_t cols, const T* in, std::size_t ld_in, T* out, std::size_t ld_out) {
+  const std::size_t full_rows = rows - rows % kTransposeTile;
+  const std::size_t full_cols = cols - cols % kTransposeTile;
+  for (std::size_t i = 0; i < full_rows; i += kTransposeTile) {
+    for (std::size_t j = 0; j < full_cols; j += kTransposeTile) {
+      transposeTile(in + i * ld_in + j, ld_in, out + j * ld_out + i, ld_out);
+    }
+  }
+  for (std::size_t i = 0; i < rows; i++) {
+    for (std::size_t j = i < full_rows ? full_cols : 0; j < cols; j++) {
+      out[j * ld_out + i] = in[i * ld_in + j];
+    }
+  }
+}
+
+// Split point of a dimension: the middle, rounded to whole tiles.
+inline std::size_t splitPoint(std::size_t size) {
+  return std::max(kTransposeTile, size / 2 / kTransposeTile * kTransposeTile);
+}
+
+template <class T>
+void transposeRecurse(std::size_t rows, std::size_t cols, const T* in, std::size_t ld_in, T* out,
+                      std::size_t ld_out) {
+  if (rows <= kTransposeLeaf && cols <= kTransposeLeaf) {
+    transposeLeaf(rows, cols, in, ld_in, out, ld_out);
+  } else if (rows >= cols) {
+    const std::size_t half = splitPoint(rows);
+    transposeRecurse(half, cols, in, ld_in, out, ld_out);
+    transposeRecurse(rows - half, cols, in + half * ld_in, ld_in, out + half, ld_out);
+  } else {
+    const std::size_t half = splitPoint(cols);
+    transposeRecurse(rows, half, in, ld_in, out, ld_out);
+    transposeRecurse(rows, cols - half, in + half, ld_in, out + half * ld_out, ld_out);
+  }
+}
+
+// Exchanges the rows x cols block `a` with the transpose of the cols x rows
+// block `b`: a[i][j] <-> b[j][i]. Both live in one matrix with row stride ld.
+template <class T>
+void swapTransposeRecurse(std::size_t rows, std::size_t cols, T* a, T* b, std::size_t ld) {
+  if (rows <= kTransposeLeaf && cols <= kTransposeLeaf) {
+    for (std::size_t i = 0; i < rows; i++) {
+      for (std::size_t j = 0; j < cols; j++) {
+        std::swap(a[i * ld + j], b[j * ld + i]);
+      }
+    }
+  } else if (rows >= cols) {
+    const std::size_t half = splitPoint(rows);
+    swapTransposeRecurse(half, cols, a, b, ld);
+    swapTransposeRecurse(rows - half, cols, a + half * ld, b + half, ld);
+  } else {
+    const std::size_t half = splitPoint(cols);
+    swapTransposeRecurse(rows, half, a, b, ld);
+    swapTransposeRecurse(rows, cols - half, a + half, b + half * ld, ld);
+  }
+}
+
+template <class T>
+void transposeInPlaceRecurse(std::size_t n, T* a, std::size_t ld) {
+  if (n <= kTransposeLeaf) {
+    for (std::size_t i = 0; i < n; i++) {
+      for (std::size_t j = i + 1; j < n; j++) {
+        std::swap(a[i * ld + j], a[j * ld + i]);
+      }
+    }
+    return;
+  }
+  const std::size_t half = splitPoint(n);
+  transposeInPlaceRecurse(half, a, ld);
+  transposeInPlaceRecurse(n - half, a + half * ld + half, ld);
+  swapTransposeRecurse(half, n - half, a + half, a + half * ld, ld);
+}
+
+}  // namespace detail
+
+// out = in^T for a row-major rows x cols matrix `in` (row stride ld_in) and the
+// cols x rows matrix `out` (row stride ld_out).
+template <class T>
+void transpose(std::size_t rows, std::size_t cols, const T* in, std::size_t ld_in, T* out, std::size_t ld_out) {
+  detail::transposeRecurse(rows, cols, in, ld_in, out, ld_out);
+}
+
+// Contiguous version: ld_in = cols, ld_out = rows.
+template <class T>
+void transpose(std::size_t rows, std::size_t cols, const T* in, T* out) {
+  detail::transposeRecurse(rows, cols, in, cols, out, rows);
+}
+
+// Transposes the square row-major n x n matrix `a` in place.
+template <class T>
+void transposeInPlace(std::size_t n, T* a) {
+  detail::transposeInPlaceRecurse(n, a, n);
+}
+
+// Multithreaded transpose(): every thread transposes a band of rows of `in`
+// into the matching band of columns of `out`.
+template <class T>
+void parallelTranspose(std::size_t rows, std::size_t cols, const T* in, T* out,
+                       int num_threads = detail::defaultThreads()) {
+  const std::size_t min_rows = std::max<std::size_t>(1, detail::kMinChunk / std::max<std::size_t>(cols, 1));
+  detail::forEachChunk(
+      rows, num_threads,
+      [&](std::size_t /*chunk*/, std::size_t begin, std::size_t end) {
+        detail::transposeRecurse(end - begin, cols, in + begin * cols, cols, out + begin, rows);
+      },
+      min_rows);
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_KERNELS_INCLUDE_TRANSPOSE_HPP_
@@ -155,3 +155,67 @@ TEST(perf_tests, check_perf_task_float) {
   ASSERT_LE(perfResults->time_sec, 10.0);
   EXPECT_EQ(out[0], in.size());
 }
+
+TEST(perf_tests, check_perf_task_bytes_processed) {
+  // Create data
+  std::vector<int16_t> in(2000, 1);
+  std::vector<int16_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<int16_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->bytes_per_run = in.size() * sizeof(int16_t);
+  perfAttr->data_type = "int16";
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+
+  ASSERT_LE(perfResults->time_sec, 10.0);
+  EXPECT_EQ(perfResults->bytes_processed, 10 * in.size() * sizeof(int16_t));
+  EXPECT_EQ(perfResults->data_type, "int16");
+}
+
+TEST(perf_tests, check_perf_task_flops) {
+  // Create data
+  std::vector<double> in(100, 1.0);
+  std::vector<double> out(1, 0.0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<double>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->flops_per_run = in.size();
+  perfAttr->data_type = "float64";
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->flops, 5 * in.size());
+  EXPECT_EQ(perfResults->bytes_processed, 0u);
+}
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "core/task/include/task.hpp"
@@ -17,11 +18,23 @@ struct PerfAttr {
   // count of task's running
   uint64_t num_running;
   std::function<double(void)> current_timer = [&] { return 0.0; };
+  // optional: bytes of input data processed by one run and the element type
+  // name, used to report throughput per element type
+  uint64_t bytes_per_run = 0;
+  std::string data_type;
+  // optional: floating point (or integer multiply-add) operations of one run,
+  // used to report GFLOP/s for compute bound kernels
+  uint64_t flops_per_run = 0;
 };
 
 struct PerfResults {
   // measurement of task's time (in seconds)
   double time_sec = 0.0;
+  // total bytes processed during the measurement (0 if not reported)
+  uint64_t bytes_processed = 0;
+  std::string data_type;
+  // total operations performed during the measurement (0 if not reported)
+  uint64_t flops = 0;
   enum TypeOfRunning { PIPELINE, TASK_RUN, NONE } type_of_running = NONE;
   constexpr const static double MAX_TIME = 10.0;
 };
@@ -53,6 +53,9 @@ void ppc::core::Perf::common_run(const std::shared_ptr<PerfAttr>& perfAttr, cons
   }
   auto end = perfAttr->current_timer();
   perfResults->time_sec = end - begin;
+  perfResults->bytes_processed = perfAttr->bytes_per_run * perfAttr->num_running;
+  perfResults->data_type = perfAttr->data_type;
+  perfResults->flops = perfAttr->flops_per_run * perfAttr->num_running;
 }
 
 void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults) {
@@ -89,4 +92,15 @@ void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& p
   }
 
   std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << std::endl;
+
+  if (perfResults->bytes_processed > 0 && time_secs > 0.0) {
+    auto gbytes_per_sec = static_cast<double>(perfResults->bytes_processed) / time_secs * 1e-9;
+    std::cout << relative_path << ":" << type_test_name << ":throughput[" << perfResults->data_type
+              << "]=" << std::fixed << std::setprecision(3) << gbytes_per_sec << " GB/s" << std::endl;
+  }
+  if (perfResults->flops > 0 && time_secs > 0.0) {
+    auto gflops_per_sec = static_cast<double>(perfResults->flops) / time_secs * 1e-9;
+    std::cout << relative_path << ":" << type_test_name << ":gflops[" << perfResults->data_type << "]=" << std::fixed
+              << std::setprecision(3) << gflops_per_sec << " GFLOP/s" << std::endl;
+  }
 }
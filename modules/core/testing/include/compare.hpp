@@ -0,0 +1,64 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_TESTING_INCLUDE_COMPARE_HPP_
+#define MODULES_CORE_TESTING_INCLUDE_COMPARE_HPP_
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core::testing {
+
+// `size` integers uniform in [-bound, bound], stored as T. Sums and products
+// of a few thousand such entries are exact in float and double as well, so
+// results computed in any order are compared for equality.
+template <class T>
+std::vector<T> getExactRandomVector(std::size_t size, int bound = 10, unsigned seed = std::random_device{}()) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-bound, bound);
+  std::vector<T> vec(size);
+  for (auto& value : vec) value = static_cast<T>(dist(gen));
+  return vec;
+}
+
+// Runs the four stages of `task` in order, each of which must succeed, with
+// run() repeated `runs` times as the perf harness does.
+template <class Task>
+void runTask(Task& task, int runs = 1) {
+  ASSERT_TRUE(task.validation());
+  ASSERT_TRUE(task.pre_processing());
+  for (int i = 0; i < runs; i++) ASSERT_TRUE(task.run());
+  ASSERT_TRUE(task.post_processing());
+}
+
+// Copy of `taskData` with the same inputs writing to `outputs`, for a
+// reference task run on the same problem.
+inline std::shared_ptr<TaskData> withOutputs(const std::shared_ptr<TaskData>& taskData,
+                                             std::vector<uint8_t*> outputs) {
+  auto copy = std::make_shared<TaskData>(*taskData);
+  copy->outputs = std::move(outputs);
+  return copy;
+}
+
+// Runs `Reference`, constructed with `args`, on the inputs of `taskData` after
+// a task has written its first output of T there, and expects the outputs to
+// be equal. Called on the root, where the task data is significant.
+template <class Reference, class T, class... Args>
+void expectSameAsReference(const std::shared_ptr<TaskData>& taskData, Args&&... args) {
+  std::vector<T> reference(taskData->outputs_count[0]);
+  Reference task(withOutputs(taskData, {reinterpret_cast<uint8_t*>(reference.data())}), std::forward<Args>(args)...);
+  runTask(task);
+  const auto* output = reinterpret_cast<const T*>(taskData->outputs[0]);
+  ASSERT_EQ(std::vector<T>(output, output + reference.size()), reference);
+}
+
+}  // namespace ppc::core::testing
+
+#endif  // MODULES_CORE_TESTING_INCLUDE_COMPARE_HPP_
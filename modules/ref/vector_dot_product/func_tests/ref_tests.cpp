@@ -185,3 +185,31 @@ TEST(vector_dot_product, check_float) {
   testTask.post_processing();
   EXPECT_NEAR(out[0], in1.size() * (-1.3f) * 1.2f, 1e-3f);
 }
+
+TEST(vector_dot_product, check_float_long_vector_sums_in_double) {
+  // Create data
+  const size_t count_data = 1 << 22;
+  std::vector<float> in1(count_data, 1.0f);
+  std::vector<float> in2(count_data, 0.1f);
+  std::vector<float> out(1, 0.f);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in1.data()));
+  taskData->inputs_count.emplace_back(in1.size());
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in2.data()));
+  taskData->inputs_count.emplace_back(in2.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::reference::VectorDotProduct<float> testTask(taskData);
+  bool isValid = testTask.validation();
+  ASSERT_EQ(isValid, true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  // Only the final rounding to float remains.
+  const auto expected = static_cast<float>(static_cast<double>(count_data) * static_cast<double>(0.1f));
+  EXPECT_EQ(out[0], expected);
+}
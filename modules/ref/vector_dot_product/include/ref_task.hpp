@@ -6,9 +6,10 @@
 #include <gtest/gtest.h>
 
 #include <memory>
-#include <numeric>
+#include <type_traits>
 #include <vector>
 
+#include "core/kernels/include/dot_product.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -43,7 +44,12 @@ class VectorDotProduct : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    dor_product = std::inner_product(input_[0].begin(), input_[0].end(), input_[1].begin(), 0.0);
+    // Floating-point data is summed in double: the other tasks are checked
+    // against this result.
+    using Acc = std::conditional_t<std::is_floating_point_v<InOutType>, double,
+                                   ppc::core::kernels::DotAccumulatorT<InOutType>>;
+    dor_product = static_cast<InOutType>(
+        ppc::core::kernels::dot<InOutType, Acc>(input_[0].data(), input_[1].data(), input_[0].size()));
     return true;
   }
 
@@ -0,0 +1,181 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <random>
+#include <vector>
+
+#include "mpi/adjacent_pairs/include/ops_mpi.hpp"
+#include "ref/most_different_neighbor_elements/include/ref_task.hpp"
+#include "ref/nearest_neighbor_elements/include/ref_task.hpp"
+#include "ref/num_of_alternations_signs/include/ref_task.hpp"
+
+namespace {
+
+std::vector<int> getRandomVector(int sz) {
+  std::random_device dev;
+  std::mt19937 gen(dev());
+  std::uniform_int_distribution<int> dist(-100, 100);
+  std::vector<int> vec(sz);
+  for (auto& value : vec) {
+    value = dist(gen);
+  }
+  return vec;
+}
+
+template <class ParallelTask, class ReferenceTask>
+void checkNeighborElements(std::vector<int> global_vec) {
+  boost::mpi::communicator world;
+  std::vector<int> out_elems(2, 0);
+  std::vector<int> out_indices(2, 0);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskDataPar->inputs_count.emplace_back(global_vec.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(out_elems.data()));
+    taskDataPar->outputs_count.emplace_back(out_elems.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(out_indices.data()));
+    taskDataPar->outputs_count.emplace_back(out_indices.size());
+  }
+
+  ParallelTask testMpiTaskParallel(taskDataPar);
+  ASSERT_EQ(testMpiTaskParallel.validation(), true);
+  testMpiTaskParallel.pre_processing();
+  testMpiTaskParallel.run();
+  testMpiTaskParallel.post_processing();
+
+  if (world.rank() == 0) {
+    std::vector<int> ref_elems(2, 0);
+    std::vector<int> ref_indices(2, 0);
+    std::shared_ptr<ppc::core::TaskData> taskDataRef = std::make_shared<ppc::core::TaskData>();
+    taskDataRef->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskDataRef->inputs_count.emplace_back(global_vec.size());
+    taskDataRef->outputs.emplace_back(reinterpret_cast<uint8_t*>(ref_elems.data()));
+    taskDataRef->outputs_count.emplace_back(ref_elems.size());
+    taskDataRef->outputs.emplace_back(reinterpret_cast<uint8_t*>(ref_indices.data()));
+    taskDataRef->outputs_count.emplace_back(ref_indices.size());
+
+    ReferenceTask referenceTask(taskDataRef);
+    ASSERT_EQ(referenceTask.validation(), true);
+    referenceTask.pre_processing();
+    referenceTask.run();
+    referenceTask.post_processing();
+
+    ASSERT_EQ(ref_elems, out_elems);
+    ASSERT_EQ(ref_indices, out_indices);
+  }
+}
+
+void checkAlternations(std::vector<int> global_vec) {
+  boost::mpi::communicator world;
+  std::vector<int> out(1, 0);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskDataPar->inputs_count.emplace_back(global_vec.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    taskDataPar->outputs_count.emplace_back(out.size());
+  }
+
+  adjacent_pairs_mpi::NumOfAlternationsSignsParallel<int, int> testMpiTaskParallel(taskDataPar);
+  ASSERT_EQ(testMpiTaskParallel.validation(), true);
+  testMpiTaskParallel.pre_processing();
+  testMpiTaskParallel.run();
+  testMpiTaskParallel.post_processing();
+
+  if (world.rank() == 0) {
+    std::vector<int> ref_out(1, 0);
+    std::shared_ptr<ppc::core::TaskData> taskDataRef = std::make_shared<ppc::core::TaskData>();
+    taskDataRef->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskDataRef->inputs_count.emplace_back(global_vec.size());
+    taskDataRef->outputs.emplace_back(reinterpret_cast<uint8_t*>(ref_out.data()));
+    taskDataRef->outputs_count.emplace_back(ref_out.size());
+
+    ppc::reference::NumOfAlternationsSigns<int, int> referenceTask(taskDataRef);
+    ASSERT_EQ(referenceTask.validation(), true);
+    referenceTask.pre_processing();
+    referenceTask.run();
+    referenceTask.post_processing();
+
+    ASSERT_EQ(ref_out[0], out[0]);
+  }
+}
+
+using NearestParallel = adjacent_pairs_mpi::NearestNeighborElementsParallel<int, int>;
+using NearestReference = ppc::reference::NearestNeighborElements<int, int>;
+using MostDifferentParallel = adjacent_pairs_mpi::MostDifferentNeighborElementsParallel<int, int>;
+using MostDifferentReference = ppc::reference::MostDifferentNeighborElements<int, int>;
+
+}  // namespace
+
+TEST(adjacent_pairs_mpi, nearest_neighbor_random) {
+  checkNeighborElements<NearestParallel, NearestReference>(getRandomVector(1000));
+}
+
+TEST(adjacent_pairs_mpi, nearest_neighbor_two_elements) {
+  checkNeighborElements<NearestParallel, NearestReference>({5, -3});
+}
+
+TEST(adjacent_pairs_mpi, nearest_neighbor_pair_on_block_boundary) {
+  // Every pair is far apart except the boundary of blocks of any size.
+  for (int n : {7, 12, 31}) {
+    for (int split = 1; split < n; split += 5) {
+      std::vector<int> vec(n);
+      for (int i = 0; i < n; i++) {
+        vec[i] = 100 * i;
+      }
+      vec[split] = vec[split - 1] + 1;
+      checkNeighborElements<NearestParallel, NearestReference>(vec);
+    }
+  }
+}
+
+TEST(adjacent_pairs_mpi, nearest_neighbor_ties_pick_first_pair) {
+  checkNeighborElements<NearestParallel, NearestReference>(std::vector<int>(50, 7));
+}
+
+TEST(adjacent_pairs_mpi, most_different_neighbor_random) {
+  checkNeighborElements<MostDifferentParallel, MostDifferentReference>(getRandomVector(1001));
+}
+
+TEST(adjacent_pairs_mpi, most_different_neighbor_pair_on_block_boundary) {
+  for (int n : {6, 13, 29}) {
+    for (int split = 1; split < n; split += 4) {
+      std::vector<int> vec(n, 1);
+      vec[split] = -1000;
+      checkNeighborElements<MostDifferentParallel, MostDifferentReference>(vec);
+    }
+  }
+}
+
+TEST(adjacent_pairs_mpi, alternations_random) { checkAlternations(getRandomVector(999)); }
+
+TEST(adjacent_pairs_mpi, alternations_every_pair) {
+  std::vector<int> vec(64);
+  for (size_t i = 0; i < vec.size(); i++) {
+    vec[i] = i % 2 == 0 ? 1 : -1;
+  }
+  checkAlternations(vec);
+}
+
+TEST(adjacent_pairs_mpi, alternations_with_zeros) { checkAlternations({1, 0, -1, 0, 2, -2, 3, 0, 0, -4, 4}); }
+
+TEST(adjacent_pairs_mpi, validation_fails_on_single_element) {
+  boost::mpi::communicator world;
+  std::vector<int> global_vec(1, 1);
+  std::vector<int> out(1, 0);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskDataPar->inputs_count.emplace_back(global_vec.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    taskDataPar->outputs_count.emplace_back(out.size());
+  }
+  adjacent_pairs_mpi::NumOfAlternationsSignsParallel<int, int> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    ASSERT_EQ(testMpiTaskParallel.validation(), false);
+  }
+}
@@ -0,0 +1,146 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+
+// Distributed reduction over the pairs (a[i], a[i + 1]) of a vector.
+//
+// The vector is scattered in disjoint blocks, so no element is sent twice. The
+// only pair that crosses a block boundary needs the first element of the next
+// block; it is fetched with one MPI_Irecv/MPI_Isend per neighbour while the
+// local pairs are processed. Partial results are merged by a single MPI_Reduce
+// with an MPI_Op built from the policy.
+//
+// A policy describes what is computed:
+//   using Result = ...;                              // trivially copyable
+//   Result identity() const;
+//   Result pair(const T& left, const T& right, int index) const;  // index of left
+//   static Result combine(const Result& lower, const Result& upper);
+// `lower` always covers smaller indices than `upper`, so combine does not have
+// to be commutative.
+namespace adjacent_pairs_mpi {
+
+using ppc::mpi::BlockPartition;
+using ppc::mpi::BytesType;
+
+// Scatters data[0..n) held by rank 0 according to `partition`.
+template <class T>
+std::vector<T> scatterBlocks(const boost::mpi::communicator& world, const T* data, const BlockPartition& partition) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  std::vector<T> local(partition.counts[world.rank()]);
+  const BytesType<T> type;
+  MPI_Scatterv(world.rank() == 0 ? data : nullptr, partition.counts.data(), partition.displs.data(), type.get(),
+               local.data(), static_cast<int>(local.size()), type.get(), 0, world);
+  return local;
+}
+
+template <class Policy>
+void combineResults(void* in, void* inout, int* len, MPI_Datatype* /*datatype*/) {
+  using Result = typename Policy::Result;
+  for (int i = 0; i < *len; i++) {
+    Result lower;
+    Result upper;
+    std::memcpy(&lower, static_cast<char*>(in) + i * sizeof(Result), sizeof(Result));
+    std::memcpy(&upper, static_cast<char*>(inout) + i * sizeof(Result), sizeof(Result));
+    const Result merged = Policy::combine(lower, upper);
+    std::memcpy(static_cast<char*>(inout) + i * sizeof(Result), &merged, sizeof(Result));
+  }
+}
+
+// Reduces all adjacent pairs of the distributed vector. `local` is the block of
+// the calling rank; the result is valid on rank 0.
+template <class T, class Policy>
+typename Policy::Result reduceAdjacentPairs(const boost::mpi::communicator& world, const std::vector<T>& local,
+                                            const BlockPartition& partition, const Policy& policy) {
+  using Result = typename Policy::Result;
+  static_assert(std::is_trivially_copyable_v<Result>);
+  const int rank = world.rank();
+  const int count = partition.counts[rank];
+  const int first = partition.displs[rank];
+  const bool has_next = count > 0 && rank + 1 < world.size() && partition.counts[rank + 1] > 0;
+  const bool has_prev = count > 0 && rank > 0;
+
+  // Halo of one: the first element of every block goes to the previous rank.
+  const BytesType<T> value_type;
+  const int tag = 0;
+  T halo{};
+  MPI_Request requests[2];
+  int num_requests = 0;
+  if (has_next) {
+    MPI_Irecv(&halo, 1, value_type.get(), rank + 1, tag, world, &requests[num_requests++]);
+  }
+  if (has_prev) {
+    MPI_Isend(local.data(), 1, value_type.get(), rank - 1, tag, world, &requests[num_requests++]);
+  }
+
+  Result acc = policy.identity();
+  for (int i = 0; i + 1 < count; i++) {
+    acc = Policy::combine(acc, policy.pair(local[i], local[i + 1], first + i));
+  }
+
+  MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+  if (has_next) {
+    acc = Policy::combine(acc, policy.pair(local[count - 1], halo, first + count - 1));
+  }
+
+  const BytesType<Result> result_type;
+  MPI_Op op;
+  MPI_Op_create(&combineResults<Policy>, 0, &op);
+  Result res = policy.identity();
+  MPI_Reduce(&acc, &res, 1, result_type.get(), op, 0, world);
+  MPI_Op_free(&op);
+  return res;
+}
+
+// Pair with the smallest (Less = true) or the largest |a[i] - a[i + 1]|, the
+// first such pair on ties.
+template <class T, bool Less>
+struct ExtremeDifferencePolicy {
+  struct Result {
+    T diff;
+    int index;
+  };
+
+  Result identity() const { return {T{}, -1}; }
+
+  Result pair(const T& left, const T& right, int index) const {
+    return {static_cast<T>(left > right ? left - right : right - left), index};
+  }
+
+  static Result combine(const Result& lower, const Result& upper) {
+    if (upper.index < 0) return lower;
+    if (lower.index < 0) return upper;
+    const bool better = Less ? upper.diff < lower.diff : upper.diff > lower.diff;
+    return better ? upper : lower;
+  }
+};
+
+template <class T>
+using NearestPairPolicy = ExtremeDifferencePolicy<T, true>;
+
+template <class T>
+using MostDifferentPairPolicy = ExtremeDifferencePolicy<T, false>;
+
+// Number of neighbours with strictly opposite signs.
+template <class T>
+struct SignAlternationsPolicy {
+  using Result = long long;
+
+  Result identity() const { return 0; }
+
+  Result pair(const T& left, const T& right, int /*index*/) const {
+    return ((left < 0 && right > 0) || (left > 0 && right < 0)) ? 1 : 0;
+  }
+
+  static Result combine(const Result& lower, const Result& upper) { return lower + upper; }
+};
+
+}  // namespace adjacent_pairs_mpi
@@ -0,0 +1,119 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "mpi/adjacent_pairs/include/adjacent_pairs.hpp"
+
+namespace adjacent_pairs_mpi {
+
+// Common part of the neighbour-pair tasks: pre_processing scatters disjoint
+// blocks, run exchanges the block boundaries and reduces the pairs. The input
+// and output layout is the one of the matching ppc::reference task.
+template <class InOutType, class Policy>
+class AdjacentPairsTask : public ppc::core::Task {
+ public:
+  explicit AdjacentPairsTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      size_ = static_cast<int>(taskData->inputs_count[0]);
+    }
+    broadcast(world, size_, 0);
+    partition_.emplace(size_, world.size());
+    const auto* data = world.rank() == 0 ? reinterpret_cast<InOutType*>(taskData->inputs[0]) : nullptr;
+    local_input_ = scatterBlocks(world, data, *partition_);
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    res_ = reduceAdjacentPairs(world, local_input_, *partition_, Policy{});
+    return true;
+  }
+
+ protected:
+  bool inputIsValid() const { return taskData->inputs.size() == 1 && taskData->inputs_count[0] >= 2; }
+
+  std::vector<InOutType> local_input_;
+  std::optional<BlockPartition> partition_;
+  typename Policy::Result res_{};
+  int size_{};
+  boost::mpi::communicator world;
+};
+
+// Pair of neighbours with the smallest (NearestNeighborElements) or the largest
+// (MostDifferentNeighborElements) absolute difference. outputs[0] receives the
+// two elements, outputs[1] their indices.
+template <class InOutType, class IndexType, class Policy>
+class ExtremeNeighborElementsParallel : public AdjacentPairsTask<InOutType, Policy> {
+ public:
+  explicit ExtremeNeighborElementsParallel(std::shared_ptr<ppc::core::TaskData> taskData_)
+      : AdjacentPairsTask<InOutType, Policy>(std::move(taskData_)) {}
+
+  bool validation() override {
+    this->internal_order_test();
+    if (this->world.rank() == 0) {
+      return this->inputIsValid() && this->taskData->outputs_count.size() == 2 &&
+             this->taskData->outputs_count[0] == 2 && this->taskData->outputs_count[1] == 2;
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    this->internal_order_test();
+    if (this->world.rank() == 0) {
+      const auto* input = reinterpret_cast<InOutType*>(this->taskData->inputs[0]);
+      const int index = this->res_.index;
+      reinterpret_cast<InOutType*>(this->taskData->outputs[0])[0] = input[index];
+      reinterpret_cast<InOutType*>(this->taskData->outputs[0])[1] = input[index + 1];
+      reinterpret_cast<IndexType*>(this->taskData->outputs[1])[0] = static_cast<IndexType>(index);
+      reinterpret_cast<IndexType*>(this->taskData->outputs[1])[1] = static_cast<IndexType>(index + 1);
+    }
+    return true;
+  }
+};
+
+template <class InOutType, class IndexType>
+using NearestNeighborElementsParallel =
+    ExtremeNeighborElementsParallel<InOutType, IndexType, NearestPairPolicy<InOutType>>;
+
+template <class InOutType, class IndexType>
+using MostDifferentNeighborElementsParallel =
+    ExtremeNeighborElementsParallel<InOutType, IndexType, MostDifferentPairPolicy<InOutType>>;
+
+// Number of neighbours with opposite signs, written to outputs[0][0].
+template <class InOutType, class CountType>
+class NumOfAlternationsSignsParallel : public AdjacentPairsTask<InOutType, SignAlternationsPolicy<InOutType>> {
+ public:
+  explicit NumOfAlternationsSignsParallel(std::shared_ptr<ppc::core::TaskData> taskData_)
+      : AdjacentPairsTask<InOutType, SignAlternationsPolicy<InOutType>>(std::move(taskData_)) {}
+
+  bool validation() override {
+    this->internal_order_test();
+    if (this->world.rank() == 0) {
+      return this->inputIsValid() && this->taskData->outputs_count.size() == 1 &&
+             this->taskData->outputs_count[0] == 1;
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    this->internal_order_test();
+    if (this->world.rank() == 0) {
+      reinterpret_cast<CountType*>(this->taskData->outputs[0])[0] = static_cast<CountType>(this->res_);
+    }
+    return true;
+  }
+};
+
+}  // namespace adjacent_pairs_mpi
@@ -0,0 +1,76 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "mpi/adjacent_pairs/include/ops_mpi.hpp"
+
+namespace {
+
+const int kCount = 20000000;
+
+// Alternating signs with one closest pair near the end of the vector.
+std::vector<int> makeVector() {
+  std::vector<int> vec(kCount);
+  for (int i = 0; i < kCount; i++) {
+    vec[i] = (i % 2 == 0 ? 1 : -1) * (1000 + i % 1000);
+  }
+  vec[kCount - 2] = 5;
+  vec[kCount - 1] = 6;
+  return vec;
+}
+
+void runPerf(bool pipeline) {
+  boost::mpi::communicator world;
+  std::vector<int> global_vec;
+  std::vector<int> out_elems(2, 0);
+  std::vector<int> out_indices(2, 0);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    global_vec = makeVector();
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskDataPar->inputs_count.emplace_back(global_vec.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(out_elems.data()));
+    taskDataPar->outputs_count.emplace_back(out_elems.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(out_indices.data()));
+    taskDataPar->outputs_count.emplace_back(out_indices.size());
+  }
+
+  auto testMpiTaskParallel =
+      std::make_shared<adjacent_pairs_mpi::NearestNeighborElementsParallel<int, int>>(taskDataPar);
+  ASSERT_EQ(testMpiTaskParallel->validation(), true);
+  testMpiTaskParallel->pre_processing();
+  testMpiTaskParallel->run();
+  testMpiTaskParallel->post_processing();
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    ASSERT_EQ(out_indices[0], kCount - 2);
+    ASSERT_EQ(out_elems[1], 6);
+  }
+}
+
+}  // namespace
+
+TEST(adjacent_pairs_mpi_perf_test, test_pipeline_run) { runPerf(true); }
+
+TEST(adjacent_pairs_mpi_perf_test, test_task_run) { runPerf(false); }
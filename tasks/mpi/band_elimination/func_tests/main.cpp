@@ -0,0 +1,210 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/testing/include/compare.hpp"
+#include "mpi/band_elimination/include/ops_mpi.hpp"
+
+namespace {
+
+// Dense n x n band matrix, nrhs right-hand sides and the known solution.
+// `boost` is added to the diagonal.
+struct System {
+  std::vector<double> a;
+  std::vector<double> b;
+  std::vector<double> solution;
+};
+
+System makeSystem(int n, int kl, int ku, int nrhs, double boost) {
+  std::random_device dev;
+  std::mt19937 gen(dev());
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  System system;
+  system.a.assign(static_cast<size_t>(n) * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = std::max(0, i - kl); j <= std::min(n - 1, i + ku); j++) system.a[i * n + j] = dist(gen);
+    system.a[i * n + i] += boost;
+  }
+  system.solution.resize(static_cast<size_t>(n) * nrhs);
+  for (auto& value : system.solution) value = dist(gen);
+  system.b.assign(system.solution.size(), 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      for (int r = 0; r < nrhs; r++) system.b[i * nrhs + r] += system.a[i * n + j] * system.solution[j * nrhs + r];
+    }
+  }
+  return system;
+}
+
+std::shared_ptr<ppc::core::TaskData> makeTaskData(int n, System& system, std::vector<double>& x) {
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs = {reinterpret_cast<uint8_t*>(system.a.data()), reinterpret_cast<uint8_t*>(system.b.data())};
+  taskData->inputs_count = {static_cast<uint32_t>(n), static_cast<uint32_t>(system.b.size())};
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+  taskData->outputs_count.emplace_back(x.size());
+  return taskData;
+}
+
+// Both tasks call run() `runs` times, as the perf harness does.
+void runAndCompare(int n, int kl, int ku, int nrhs = 1, double boost = 2.0, double tolerance = 1e-9, int runs = 1) {
+  boost::mpi::communicator world;
+  System system;
+  std::vector<double> x(static_cast<size_t>(n) * nrhs);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(n, kl, ku, nrhs, boost);
+    taskDataPar = makeTaskData(n, system, x);
+  }
+
+  band_elimination_mpi::BandParallel<double> testMpiTaskParallel(taskDataPar);
+  ppc::core::testing::runTask(testMpiTaskParallel, runs);
+
+  if (world.rank() == 0) {
+    std::vector<double> reference(x.size());
+    auto taskDataSeq = ppc::core::testing::withOutputs(taskDataPar, {reinterpret_cast<uint8_t*>(reference.data())});
+    band_elimination_mpi::BandSequential<double> testMpiTaskSequential(taskDataSeq);
+    ppc::core::testing::runTask(testMpiTaskSequential, runs);
+    EXPECT_EQ(testMpiTaskSequential.bandwidth().lower, static_cast<size_t>(kl));
+    EXPECT_EQ(testMpiTaskSequential.bandwidth().upper, static_cast<size_t>(ku));
+
+    for (size_t i = 0; i < x.size(); i++) {
+      ASSERT_NEAR(x[i], system.solution[i], tolerance);
+      ASSERT_NEAR(reference[i], system.solution[i], tolerance);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(band_elimination_mpi, tridiagonal) { runAndCompare(200, 1, 1); }
+
+TEST(band_elimination_mpi, wider_lower_band) { runAndCompare(150, 4, 1); }
+
+TEST(band_elimination_mpi, wider_upper_band) { runAndCompare(150, 1, 5); }
+
+TEST(band_elimination_mpi, upper_triangular_band) { runAndCompare(120, 0, 3); }
+
+TEST(band_elimination_mpi, lower_triangular_band) { runAndCompare(120, 3, 0); }
+
+TEST(band_elimination_mpi, diagonal) { runAndCompare(50, 0, 0); }
+
+TEST(band_elimination_mpi, several_right_hand_sides) { runAndCompare(100, 2, 3, 4); }
+
+TEST(band_elimination_mpi, fewer_rows_than_processes_need) { runAndCompare(9, 3, 2); }
+
+TEST(band_elimination_mpi, no_diagonal_boost) { runAndCompare(300, 2, 2, 1, 0.0, 1e-6); }
+
+TEST(band_elimination_mpi, repeated_runs) { runAndCompare(100, 2, 3, 2, 2.0, 1e-9, 2); }
+
+TEST(band_elimination_mpi, compact_band_input) {
+  boost::mpi::communicator world;
+  const int n = 64;
+  const int kl = 2;
+  const int ku = 1;
+  System system;
+  std::vector<double> rows;
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(n, kl, ku, 1, 2.0);
+    rows.assign(n * (kl + ku + 1), 0.0);
+    for (int i = 0; i < n; i++) {
+      for (int j = std::max(0, i - kl); j <= std::min(n - 1, i + ku); j++) {
+        rows[i * (kl + ku + 1) + j - i + kl] = system.a[i * n + j];
+      }
+    }
+    taskDataPar = makeTaskData(n, system, x);
+    taskDataPar->inputs[0] = reinterpret_cast<uint8_t*>(rows.data());
+    taskDataPar->inputs_count = {n, n, kl, ku};
+  }
+  band_elimination_mpi::BandParallel<double> testMpiTaskParallel(taskDataPar);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+  if (world.rank() == 0) {
+    for (int i = 0; i < n; i++) {
+      ASSERT_NEAR(x[i], system.solution[i], 1e-10);
+    }
+  }
+}
+
+TEST(band_elimination_mpi, falls_back_when_a_block_is_singular) {
+  // A swaps neighbouring pairs of unknowns: nonsingular, but a block that
+  // ends inside a pair has a zero row. n is even and, on more than one
+  // process, some block has an odd number of rows.
+  boost::mpi::communicator world;
+  const int n = 3 * world.size() + world.size() % 2;
+  System system;
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system.a.assign(n * n, 0.0);
+    system.b.resize(n);
+    for (int i = 0; i < n; i++) {
+      system.a[i * n + (i ^ 1)] = 1.0;
+      system.b[i] = i + 1.0;
+    }
+    taskDataPar = makeTaskData(n, system, x);
+  }
+  band_elimination_mpi::BandParallel<double> testMpiTaskParallel(taskDataPar);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+  EXPECT_EQ(testMpiTaskParallel.engine().gathered(), world.size() > 1);
+  if (world.rank() == 0) {
+    for (int i = 0; i < n; i++) {
+      ASSERT_DOUBLE_EQ(x[i], (i ^ 1) + 1.0);
+    }
+  }
+}
+
+TEST(band_elimination_mpi, run_fails_on_singular_matrix) {
+  boost::mpi::communicator world;
+  const int n = 40;
+  System system;
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(n, 1, 1, 1, 2.0);
+    for (int j = 0; j < n; j++) system.a[17 * n + j] = 0.0;
+    taskDataPar = makeTaskData(n, system, x);
+  }
+  band_elimination_mpi::BandParallel<double> testMpiTaskParallel(taskDataPar);
+  ASSERT_EQ(testMpiTaskParallel.validation(), true);
+  testMpiTaskParallel.pre_processing();
+  EXPECT_FALSE(testMpiTaskParallel.run());
+}
+
+TEST(band_elimination_mpi, validation_fails_on_bad_bandwidth) {
+  boost::mpi::communicator world;
+  System system;
+  std::vector<double> x(4);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(4, 1, 1, 1, 2.0);
+    taskDataPar = makeTaskData(4, system, x);
+    taskDataPar->inputs_count = {4, 4, 4, 1};
+  }
+  band_elimination_mpi::BandParallel<double> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    EXPECT_FALSE(testMpiTaskParallel.validation());
+  }
+}
+
+TEST(band_elimination_mpi, validation_fails_on_size_mismatch) {
+  boost::mpi::communicator world;
+  System system;
+  std::vector<double> x(5);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(4, 1, 1, 1, 2.0);
+    taskDataPar = makeTaskData(4, system, x);
+  }
+  band_elimination_mpi::BandParallel<double> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    EXPECT_FALSE(testMpiTaskParallel.validation());
+  }
+}
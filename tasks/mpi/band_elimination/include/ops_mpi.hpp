@@ -0,0 +1,157 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/band.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/band.hpp"
+
+namespace band_elimination_mpi {
+
+// Solves A X = B for a band matrix A. Two input forms:
+//  - dense: inputs[0] is A (n x n, row-major), inputs_count = {n, n * nrhs};
+//    the bandwidth is detected from the non-zeros;
+//  - band: inputs[0] holds the compact band rows (row i holds columns
+//    i - kl .. i + ku, entry (i, j) at i * (kl + ku + 1) + j - i + kl),
+//    inputs_count = {n, n * nrhs, kl, ku}.
+// inputs[1] is B (n x nrhs, row-major). Output: outputs[0] receives X,
+// outputs_count = {n * nrhs}. run() returns false if A is singular.
+inline bool isValidTaskData(const ppc::core::TaskData& taskData) {
+  const auto& counts = taskData.inputs_count;
+  if (taskData.inputs.size() != 2 || taskData.outputs.size() != 1 || taskData.outputs_count.size() != 1) return false;
+  if (counts.size() != 2 && counts.size() != 4) return false;
+  if (counts[0] == 0 || counts[1] == 0 || counts[1] % counts[0] != 0) return false;
+  if (counts.size() == 4 && (counts[2] >= counts[0] || counts[3] >= counts[0])) return false;
+  return taskData.outputs_count[0] == counts[1];
+}
+
+// A from the task data in band storage, with the bandwidth given or detected.
+template <class T>
+ppc::core::kernels::BandMatrix<T> readBandMatrix(const ppc::core::TaskData& taskData) {
+  const size_t n = taskData.inputs_count[0];
+  const auto* a = reinterpret_cast<T*>(taskData.inputs[0]);
+  if (taskData.inputs_count.size() == 4) {
+    return ppc::core::kernels::BandMatrix<T>::fromRows(n, a, {taskData.inputs_count[2], taskData.inputs_count[3]});
+  }
+  return ppc::core::kernels::BandMatrix<T>::fromDense(n, a, n, ppc::core::kernels::detectBandwidth(n, a, n));
+}
+
+template <class T>
+class BandSequential : public ppc::core::Task {
+ public:
+  explicit BandSequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    nrhs = taskData->inputs_count[1] / taskData->inputs_count[0];
+    pivots_.resize(taskData->inputs_count[0]);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return isValidTaskData(*taskData);
+  }
+
+  bool run() override {
+    internal_order_test();
+    // The band is factorised and X solved for in place, so every run starts
+    // again from A and B.
+    lu_ = readBandMatrix<T>(*taskData);
+    auto* b = reinterpret_cast<T*>(taskData->inputs[1]);
+    x_.assign(b, b + lu_.n * nrhs);
+    if (!ppc::core::kernels::bandFactor(lu_, pivots_.data())) return false;
+    ppc::core::kernels::bandSolve(lu_, pivots_.data(), x_.data(), nrhs);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(x_.begin(), x_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    return true;
+  }
+
+  [[nodiscard]] ppc::core::kernels::Bandwidth bandwidth() const { return lu_.band; }
+
+ private:
+  ppc::core::kernels::BandMatrix<T> lu_;
+  std::vector<int> pivots_;
+  size_t nrhs{};
+  std::vector<T> x_;
+};
+
+// Same contract; rank 0 detects the band and sends every process only its
+// rows of it, and ppc::mpi::BandEngine solves with neighbour-only exchanges
+// of boundary rows.
+template <class T>
+class BandParallel : public ppc::core::Task {
+ public:
+  explicit BandParallel(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    std::array<int, 4> sizes{};  // n, nrhs, kl, ku
+    std::vector<T> rows;
+    if (world.rank() == 0) {
+      const auto band = readBandMatrix<T>(*taskData);
+      const int n = static_cast<int>(band.n);
+      sizes = {n, static_cast<int>(taskData->inputs_count[1]) / n, static_cast<int>(band.band.lower),
+               static_cast<int>(band.band.upper)};
+      const size_t width = band.band.lower + band.band.upper + 1;
+      rows.resize(band.n * width);
+      for (size_t i = 0; i < band.n; i++) {
+        std::copy_n(&band.values[i * band.stride()], width, &rows[i * width]);
+      }
+    }
+    boost::mpi::broadcast(world, sizes.data(), 4, 0);
+    nrhs = sizes[1];
+    engine_.emplace(world, sizes[0], ppc::core::kernels::Bandwidth{static_cast<size_t>(sizes[2]),
+                                                                    static_cast<size_t>(sizes[3])});
+    engine_->distribute(rows.data());
+    if (world.rank() == 0) x_.resize(taskData->inputs_count[1]);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return isValidTaskData(*taskData);
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    if (!engine_->factorise()) return false;
+    engine_->solve(world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[1]) : nullptr, x_.data(), nrhs);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      std::copy(x_.begin(), x_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    }
+    return true;
+  }
+
+  [[nodiscard]] const ppc::mpi::BandEngine<T>& engine() const { return *engine_; }
+
+ private:
+  std::optional<ppc::mpi::BandEngine<T>> engine_;
+  int nrhs{};
+  std::vector<T> x_;
+  boost::mpi::communicator world;
+};
+
+}  // namespace band_elimination_mpi
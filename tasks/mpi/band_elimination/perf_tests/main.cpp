@@ -0,0 +1,81 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <boost/mpi/timer.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/band_elimination/include/ops_mpi.hpp"
+
+namespace {
+
+// 2^18 unknowns with 6 diagonals on each side, given as compact band rows (the
+// dense matrix would take 512 GiB).
+constexpr int kSize = 1 << 18;
+constexpr int kLower = 6;
+constexpr int kUpper = 6;
+
+void runPerf(bool pipeline) {
+  boost::mpi::communicator world;
+  constexpr int kWidth = kLower + kUpper + 1;
+  std::vector<double> rows;
+  std::vector<double> b;
+  std::vector<double> x(kSize);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    rows.resize(static_cast<size_t>(kSize) * kWidth);
+    for (auto& value : rows) value = dist(gen);
+    for (int i = 0; i < kSize; i++) rows[static_cast<size_t>(i) * kWidth + kLower] += 4.0;
+    // b = A * ones, so the solution is all ones.
+    b.assign(kSize, 0.0);
+    for (int i = 0; i < kSize; i++) {
+      for (int j = std::max(0, i - kLower); j <= std::min(kSize - 1, i + kUpper); j++) {
+        b[i] += rows[static_cast<size_t>(i) * kWidth + j - i + kLower];
+      }
+    }
+    taskDataPar->inputs = {reinterpret_cast<uint8_t*>(rows.data()), reinterpret_cast<uint8_t*>(b.data())};
+    taskDataPar->inputs_count = {kSize, kSize, kLower, kUpper};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+    taskDataPar->outputs_count.emplace_back(kSize);
+  }
+
+  auto testMpiTaskParallel = std::make_shared<band_elimination_mpi::BandParallel<double>>(taskDataPar);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->data_type = ppc::core::kernels::typeName<double>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    for (int i = 0; i < kSize; i++) {
+      ASSERT_NEAR(x[i], 1.0, 1e-9);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(band_elimination_mpi_perf_test, test_pipeline_run) { runPerf(true); }
+
+TEST(band_elimination_mpi_perf_test, test_task_run) { runPerf(false); }
@@ -0,0 +1,74 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "core/testing/include/compare.hpp"
+#include "mpi/batched_matrix_multiplication/include/ops_mpi.hpp"
+
+namespace {
+
+template <class T = int>
+void runAndCompare(uint32_t count, uint32_t m, uint32_t k, uint32_t n, int num_threads = 2) {
+  boost::mpi::communicator world;
+  std::vector<T> a;
+  std::vector<T> b;
+  std::vector<T> c(static_cast<size_t>(count) * m * n);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    a = ppc::core::testing::getExactRandomVector<T>(static_cast<size_t>(count) * m * k);
+    b = ppc::core::testing::getExactRandomVector<T>(static_cast<size_t>(count) * k * n);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+    taskDataPar->inputs_count = {count, m, k, n};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+    taskDataPar->outputs_count.emplace_back(c.size());
+  }
+
+  batched_matrix_multiplication_mpi::BatchedMatmulParallel<T> testMpiTaskParallel(taskDataPar, num_threads);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+
+  if (world.rank() == 0) {
+    ppc::core::testing::expectSameAsReference<batched_matrix_multiplication_mpi::BatchedMatmulSequential<T>, T>(
+        taskDataPar);
+  }
+}
+
+}  // namespace
+
+TEST(batched_matrix_multiplication_mpi, batch_4x4) { runAndCompare(1000, 4, 4, 4); }
+
+TEST(batched_matrix_multiplication_mpi, batch_8x8_float) { runAndCompare<float>(301, 8, 8, 8); }
+
+TEST(batched_matrix_multiplication_mpi, batch_16x16_double) { runAndCompare<double>(45, 16, 16, 16); }
+
+TEST(batched_matrix_multiplication_mpi, batch_32x32) { runAndCompare(13, 32, 32, 32); }
+
+TEST(batched_matrix_multiplication_mpi, rectangular_run_time_size) { runAndCompare(77, 3, 7, 5); }
+
+TEST(batched_matrix_multiplication_mpi, fewer_matrices_than_processes) { runAndCompare(2, 4, 4, 4); }
+
+TEST(batched_matrix_multiplication_mpi, single_thread) { runAndCompare<int64_t>(200, 6, 6, 6, 1); }
+
+TEST(batched_matrix_multiplication_mpi, validation_fails_on_wrong_output_size) {
+  boost::mpi::communicator world;
+  std::vector<int> a(32);
+  std::vector<int> b(32);
+  std::vector<int> c(16);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+    taskDataPar->inputs_count = {2, 4, 4, 4};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+    taskDataPar->outputs_count.emplace_back(c.size());
+  }
+  batched_matrix_multiplication_mpi::BatchedMatmulParallel<int> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    ASSERT_EQ(testMpiTaskParallel.validation(), false);
+  }
+}
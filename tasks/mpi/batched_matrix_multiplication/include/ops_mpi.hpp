@@ -0,0 +1,179 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/batched_gemm.hpp"
+#include "core/kernels/include/gemm.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+
+namespace batched_matrix_multiplication_mpi {
+
+inline bool isValidTaskData(const ppc::core::TaskData& taskData) {
+  return taskData.inputs.size() == 2 && taskData.inputs_count.size() == 4 && taskData.outputs_count.size() == 1 &&
+         taskData.inputs_count[0] > 0 && taskData.inputs_count[1] > 0 && taskData.inputs_count[2] > 0 &&
+         taskData.inputs_count[3] > 0 &&
+         taskData.outputs_count[0] == taskData.inputs_count[0] * taskData.inputs_count[1] * taskData.inputs_count[3];
+}
+
+// C[b] = A[b] * B[b] for a batch of small matrices, one Task for the whole batch.
+// Input: inputs[0] holds `count` row-major m x k matrices one after another,
+// inputs[1] holds `count` k x n matrices, inputs_count = {count, m, k, n}.
+// Output: outputs[0] receives `count` m x n matrices, outputs_count =
+// {count * m * n}. Each pair is multiplied with the GEMM kernel in turn.
+template <class T>
+class BatchedMatmulSequential : public ppc::core::Task {
+ public:
+  explicit BatchedMatmulSequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    count = taskData->inputs_count[0];
+    m = taskData->inputs_count[1];
+    k = taskData->inputs_count[2];
+    n = taskData->inputs_count[3];
+    auto* a = reinterpret_cast<T*>(taskData->inputs[0]);
+    auto* b = reinterpret_cast<T*>(taskData->inputs[1]);
+    a_.assign(a, a + count * m * k);
+    b_.assign(b, b + count * k * n);
+    c_.resize(count * m * n);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return isValidTaskData(*taskData);
+  }
+
+  bool run() override {
+    internal_order_test();
+    for (size_t matrix = 0; matrix < count; matrix++) {
+      ppc::core::kernels::matmul(m, n, k, a_.data() + matrix * m * k, b_.data() + matrix * k * n,
+                                 c_.data() + matrix * m * n);
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(c_.begin(), c_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    return true;
+  }
+
+ private:
+  std::vector<T> a_;
+  std::vector<T> b_;
+  std::vector<T> c_;
+  size_t count{};
+  size_t m{};
+  size_t k{};
+  size_t n{};
+};
+
+// Same contract as BatchedMatmulSequential. Rank 0 scatters whole matrices in
+// contiguous blocks (one element of the MPI datatype is one matrix), every rank
+// interleaves its block into SIMD packs (see core/kernels/batched_gemm.hpp)
+// and multiplies the packs on num_threads_ threads with the compile-time
+// kernels for square 4/8/16/32 sizes; the products are gathered back the same
+// way. The whole batch costs one scatter and one gather instead of a task run
+// with its own broadcasts per pair.
+template <class T>
+class BatchedMatmulParallel : public ppc::core::Task {
+ public:
+  explicit BatchedMatmulParallel(std::shared_ptr<ppc::core::TaskData> taskData_, int num_threads_ = 1)
+      : Task(std::move(taskData_)), num_threads(num_threads_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    std::array<int, 4> shape{};
+    if (world.rank() == 0) {
+      for (size_t i = 0; i < shape.size(); i++) {
+        shape[i] = static_cast<int>(taskData->inputs_count[i]);
+      }
+    }
+    MPI_Bcast(shape.data(), static_cast<int>(shape.size()), MPI_INT, 0, world);
+    m = shape[1];
+    k = shape[2];
+    n = shape[3];
+    partition_ = ppc::mpi::BlockPartition(shape[0], world.size());
+    local_count_ = partition_.counts[world.rank()];
+    packs_ = ppc::core::kernels::batchPacks<T>(local_count_);
+    const size_t lanes = ppc::core::kernels::kBatchLanes<T>;
+
+    std::vector<T> a_local(local_count_ * m * k);
+    std::vector<T> b_local(local_count_ * k * n);
+    scatterMatrices(world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[0]) : nullptr, m * k, a_local);
+    scatterMatrices(world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[1]) : nullptr, k * n, b_local);
+    a_packed_.resize(packs_ * lanes * m * k);
+    b_packed_.resize(packs_ * lanes * k * n);
+    ppc::core::kernels::interleaveBatch(local_count_, m, k, a_local.data(), a_packed_.data());
+    ppc::core::kernels::interleaveBatch(local_count_, k, n, b_local.data(), b_packed_.data());
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return isValidTaskData(*taskData) && num_threads > 0;
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    c_packed_.resize(packs_ * ppc::core::kernels::kBatchLanes<T> * m * n);
+    ppc::core::kernels::batchedGemm(m, n, k, packs_, a_packed_.data(), b_packed_.data(), c_packed_.data(),
+                                    num_threads);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::vector<T> c_local(local_count_ * m * n);
+    ppc::core::kernels::deinterleaveBatch(local_count_, m, n, c_packed_.data(), c_local.data());
+    MPI_Datatype matrix_type;
+    MPI_Type_contiguous(static_cast<int>(m * n), ppc::mpi::mpiTypeOf<T>(), &matrix_type);
+    MPI_Type_commit(&matrix_type);
+    T* c = world.rank() == 0 ? reinterpret_cast<T*>(taskData->outputs[0]) : nullptr;
+    MPI_Gatherv(c_local.data(), static_cast<int>(local_count_), matrix_type, c, partition_.counts.data(),
+                partition_.displs.data(), matrix_type, 0, world);
+    MPI_Type_free(&matrix_type);
+    return true;
+  }
+
+ private:
+  void scatterMatrices(const T* matrices, size_t size, std::vector<T>& local) {
+    MPI_Datatype matrix_type;
+    MPI_Type_contiguous(static_cast<int>(size), ppc::mpi::mpiTypeOf<T>(), &matrix_type);
+    MPI_Type_commit(&matrix_type);
+    MPI_Scatterv(matrices, partition_.counts.data(), partition_.displs.data(), matrix_type, local.data(),
+                 static_cast<int>(local_count_), matrix_type, 0, world);
+    MPI_Type_free(&matrix_type);
+  }
+
+  std::vector<T> a_packed_;
+  std::vector<T> b_packed_;
+  std::vector<T> c_packed_;
+  ppc::mpi::BlockPartition partition_{0, 1};
+  size_t local_count_{};
+  size_t packs_{};
+  size_t m{};
+  size_t k{};
+  size_t n{};
+  int num_threads;
+  boost::mpi::communicator world;
+};
+
+}  // namespace batched_matrix_multiplication_mpi
@@ -0,0 +1,73 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/batched_matrix_multiplication/include/ops_mpi.hpp"
+
+namespace {
+
+// Every A is all ones and B[p][j] = j + 1, so every entry of C[b] is
+// size * (j + 1) and the result is checked without a reference run.
+template <class T>
+void runPerf(uint32_t count, uint32_t size, bool pipeline) {
+  boost::mpi::communicator world;
+  const size_t matrix = static_cast<size_t>(size) * size;
+  std::vector<T> a;
+  std::vector<T> b;
+  std::vector<T> c;
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    a.assign(count * matrix, T{1});
+    b.resize(count * matrix);
+    for (size_t i = 0; i < b.size(); i++) {
+      b[i] = static_cast<T>(i % size + 1);
+    }
+    c.resize(count * matrix);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+    taskDataPar->inputs_count = {count, size, size, size};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+    taskDataPar->outputs_count.emplace_back(c.size());
+  }
+
+  auto testMpiTaskParallel = std::make_shared<batched_matrix_multiplication_mpi::BatchedMatmulParallel<T>>(taskDataPar);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->flops_per_run = 2ULL * count * matrix * size;
+  perfAttr->data_type = ppc::core::kernels::typeName<T>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    for (size_t index = 0; index < c.size(); index += c.size() / 64 + 1) {
+      ASSERT_EQ(c[index], static_cast<T>(size * (index % size + 1)));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(batched_matrix_multiplication_mpi_perf_test, test_pipeline_run_4x4_float) { runPerf<float>(400000, 4, true); }
+
+TEST(batched_matrix_multiplication_mpi_perf_test, test_task_run_4x4_float) { runPerf<float>(400000, 4, false); }
+
+TEST(batched_matrix_multiplication_mpi_perf_test, test_task_run_16x16_double) { runPerf<double>(40000, 16, false); }
@@ -0,0 +1,277 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/distributed_matrix.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/common/include/process_grid.hpp"
+#include "mpi/common/include/sparse.hpp"
+#include "mpi/common/include/transpose.hpp"
+
+namespace {
+
+template <class T>
+int mpiTypeSize() {
+  int size = 0;
+  MPI_Type_size(ppc::mpi::mpiTypeOf<T>(), &size);
+  return size;
+}
+
+std::vector<ppc::mpi::Layout1D> allLayouts(int n, int procs) {
+  return {ppc::mpi::Layout1D::block(n, procs), ppc::mpi::Layout1D::cyclic(n, procs),
+          ppc::mpi::Layout1D::blockCyclic(n, procs, 3)};
+}
+
+struct Point {
+  double x;
+  int id;
+};
+
+}  // namespace
+
+TEST(mpi_common, block_partition_covers_all_items) {
+  for (int size = 1; size <= 6; size++) {
+    for (int n = 0; n <= 20; n++) {
+      ppc::mpi::BlockPartition partition(n, size);
+      ASSERT_EQ(std::accumulate(partition.counts.begin(), partition.counts.end(), 0), n);
+      for (int proc = 1; proc < size; proc++) {
+        ASSERT_EQ(partition.displs[proc], partition.displs[proc - 1] + partition.counts[proc - 1]);
+        ASSERT_LE(partition.counts[proc], partition.counts[proc - 1]);
+        ASSERT_LE(partition.counts[0] - partition.counts[proc], 1);
+      }
+    }
+  }
+}
+
+TEST(mpi_common, block_partition_owner_skips_empty_blocks) {
+  ppc::mpi::BlockPartition partition(3, 5);
+  EXPECT_EQ(partition.owner(0), 0);
+  EXPECT_EQ(partition.owner(1), 1);
+  EXPECT_EQ(partition.owner(2), 2);
+
+  ppc::mpi::BlockPartition uneven(11, 3);
+  for (int index = 0; index < 11; index++) {
+    const int proc = uneven.owner(index);
+    ASSERT_GE(index, uneven.displs[proc]);
+    ASSERT_LT(index, uneven.displs[proc] + uneven.counts[proc]);
+  }
+}
+
+TEST(mpi_common, mpi_type_sizes_match_element_types) {
+  EXPECT_EQ(mpiTypeSize<int8_t>(), 1);
+  EXPECT_EQ(mpiTypeSize<uint8_t>(), 1);
+  EXPECT_EQ(mpiTypeSize<int16_t>(), 2);
+  EXPECT_EQ(mpiTypeSize<int32_t>(), 4);
+  EXPECT_EQ(mpiTypeSize<int64_t>(), 8);
+  EXPECT_EQ(mpiTypeSize<float>(), 4);
+  EXPECT_EQ(mpiTypeSize<double>(), 8);
+}
+
+TEST(mpi_common, bytes_type_broadcasts_struct) {
+  boost::mpi::communicator world;
+  Point point{0.0, 0};
+  if (world.rank() == 0) {
+    point = {2.5, 42};
+  }
+  const ppc::mpi::BytesType<Point> type;
+  MPI_Bcast(&point, 1, type.get(), 0, world);
+  EXPECT_EQ(point.x, 2.5);
+  EXPECT_EQ(point.id, 42);
+}
+
+TEST(mpi_common, layouts_map_every_index_once) {
+  for (int procs = 1; procs <= 5; procs++) {
+    for (int n = 0; n <= 17; n++) {
+      for (const auto& layout : allLayouts(n, procs)) {
+        int total = 0;
+        for (int proc = 0; proc < procs; proc++) {
+          const std::vector<int> indices = layout.indicesOf(proc);
+          total += static_cast<int>(indices.size());
+          for (int local = 0; local < static_cast<int>(indices.size()); local++) {
+            ASSERT_LT(indices[local], n);
+            ASSERT_EQ(layout.owner(indices[local]), proc);
+            ASSERT_EQ(layout.toLocal(indices[local]), local);
+          }
+        }
+        ASSERT_EQ(total, n);
+      }
+    }
+  }
+}
+
+TEST(mpi_common, block_cyclic_layout_deals_blocks_round_robin) {
+  const auto layout = ppc::mpi::Layout1D::blockCyclic(10, 2, 2);
+  EXPECT_EQ(layout.indicesOf(0), (std::vector<int>{0, 1, 4, 5, 8, 9}));
+  EXPECT_EQ(layout.indicesOf(1), (std::vector<int>{2, 3, 6, 7}));
+}
+
+TEST(mpi_common, distributed_matrix_scatter_gather_round_trip) {
+  boost::mpi::communicator world;
+  const auto grid = std::make_shared<const ppc::mpi::ProcessGrid>(world);
+  const int m = 11;
+  const int n = 7;
+  std::vector<int> matrix(m * n);
+  std::iota(matrix.begin(), matrix.end(), 0);
+  for (const auto& rows : allLayouts(m, grid->rows())) {
+    for (const auto& cols : allLayouts(n, grid->cols())) {
+      ppc::mpi::DistributedMatrix<int> distributed(grid, rows, cols);
+      distributed.scatter(matrix.data());
+      for (int i = 0; i < distributed.localRows(); i++) {
+        for (int j = 0; j < distributed.localCols(); j++) {
+          ASSERT_EQ(distributed(i, j), rows.toGlobal(grid->row(), i) * n + cols.toGlobal(grid->col(), j));
+        }
+      }
+      std::vector<int> gathered(world.rank() == 0 ? m * n : 0);
+      distributed.gather(gathered.data());
+      if (world.rank() == 0) {
+        ASSERT_EQ(gathered, matrix);
+      }
+    }
+  }
+}
+
+TEST(mpi_common, distributed_matrix_local_storage_is_aligned) {
+  boost::mpi::communicator world;
+  const auto grid = std::make_shared<const ppc::mpi::ProcessGrid>(world);
+  ppc::mpi::DistributedMatrix<double> distributed(grid, ppc::mpi::Layout1D::block(64, grid->rows()),
+                                                  ppc::mpi::Layout1D::block(64, grid->cols()));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(distributed.data()) % 64, 0U);
+}
+
+TEST(mpi_common, distributed_matrix_redistributes_between_layouts) {
+  boost::mpi::communicator world;
+  const auto grid = std::make_shared<const ppc::mpi::ProcessGrid>(world);
+  const int m = 13;
+  const int n = 9;
+  std::vector<double> matrix(m * n);
+  std::iota(matrix.begin(), matrix.end(), 1.0);
+  ppc::mpi::DistributedMatrix<double> source(grid, ppc::mpi::Layout1D::block(m, grid->rows()),
+                                             ppc::mpi::Layout1D::block(n, grid->cols()));
+  source.scatter(matrix.data());
+  for (const auto& rows : allLayouts(m, grid->rows())) {
+    for (const auto& cols : allLayouts(n, grid->cols())) {
+      ppc::mpi::DistributedMatrix<double> target(grid, rows, cols, 1);
+      source.redistributeTo(target);
+      std::vector<double> gathered(world.rank() == 0 ? m * n : 0);
+      target.gather(gathered.data());
+      if (world.rank() == 0) {
+        ASSERT_EQ(gathered, matrix);
+      }
+    }
+  }
+}
+
+TEST(mpi_common, distributed_vector_exchanges_ghost_rows) {
+  boost::mpi::communicator world;
+  const auto grid = std::make_shared<const ppc::mpi::ProcessGrid>(world, std::array<int, 2>{world.size(), 1}, false);
+  const int n = 4 * world.size();
+  std::vector<int> values(n);
+  std::iota(values.begin(), values.end(), 0);
+  auto vector = ppc::mpi::makeDistributedVector<int>(grid, ppc::mpi::Layout1D::block(n, world.size()), 2);
+  vector.scatter(values.data());
+  vector.exchangeGhosts();
+  const int first = vector.rowLayout().toGlobal(grid->row(), 0);
+  for (int i = -2; i < vector.localRows() + 2; i++) {
+    if (first + i < 0 || first + i >= n) continue;
+    ASSERT_EQ(vector(i, 0), first + i);
+  }
+}
+
+TEST(mpi_common, distributed_matrix_reads_own_part_from_file) {
+  boost::mpi::communicator world;
+  const auto grid = std::make_shared<const ppc::mpi::ProcessGrid>(world);
+  const int m = 10;
+  const int n = 12;
+  const std::string path = (std::filesystem::temp_directory_path() / "ppc_distributed_matrix.bin").string();
+  std::vector<float> matrix(m * n);
+  std::iota(matrix.begin(), matrix.end(), 0.0F);
+  if (world.rank() == 0) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(matrix.data()),
+               static_cast<std::streamsize>(matrix.size() * sizeof(float)));
+  }
+  world.barrier();
+  for (const auto& rows : allLayouts(m, grid->rows())) {
+    for (const auto& cols : allLayouts(n, grid->cols())) {
+      ppc::mpi::DistributedMatrix<float> distributed(grid, rows, cols);
+      ASSERT_TRUE(distributed.readFile(path));
+      for (int i = 0; i < distributed.localRows(); i++) {
+        for (int j = 0; j < distributed.localCols(); j++) {
+          ASSERT_EQ(distributed(i, j),
+                    matrix[rows.toGlobal(grid->row(), i) * n + cols.toGlobal(grid->col(), j)]);
+        }
+      }
+    }
+  }
+  world.barrier();
+  if (world.rank() == 0) {
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(mpi_common, transpose_block_rows_moves_columns_to_owners) {
+  boost::mpi::communicator world;
+  for (const auto& [m, n] : std::vector<std::pair<int, int>>{{11, 7}, {2, 9}, {64, 65}}) {
+    std::vector<int> matrix(m * n);
+    std::iota(matrix.begin(), matrix.end(), 0);
+    const ppc::mpi::BlockPartition rows(m, world.size());
+    const ppc::mpi::BlockPartition cols(n, world.size());
+    const int first_row = rows.displs[world.rank()];
+    const std::vector<int> local_a(matrix.begin() + first_row * n,
+                                   matrix.begin() + (first_row + rows.counts[world.rank()]) * n);
+    std::vector<int> local_at(cols.counts[world.rank()] * m, -1);
+    ppc::mpi::transposeBlockRows(world, m, n, local_a.data(), local_at.data());
+    for (int i = 0; i < cols.counts[world.rank()]; i++) {
+      for (int j = 0; j < m; j++) {
+        ASSERT_EQ(local_at[i * m + j], matrix[j * n + cols.displs[world.rank()] + i]) << m << "x" << n;
+      }
+    }
+  }
+}
+
+TEST(mpi_common, distributed_spmv_fetches_only_ghosts) {
+  boost::mpi::communicator world;
+  // Tridiagonal n x n matrix plus a long-range coupling of row 0 and row n - 1.
+  const int n = 40;
+  std::vector<double> dense(n * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    dense[i * n + i] = 4.0 + i;
+    if (i > 0) dense[i * n + i - 1] = -1.0;
+    if (i + 1 < n) dense[i * n + i + 1] = -2.0;
+  }
+  dense[n - 1] = dense[(n - 1) * n] = 0.5;
+  const auto a = ppc::core::kernels::CsrMatrix<double>::fromDense(n, n, dense.data());
+  std::vector<double> x(n);
+  for (int i = 0; i < n; i++) x[i] = 1.0 + 0.1 * i;
+  std::vector<double> expected(n);
+  ppc::core::kernels::spmv(a, x.data(), expected.data());
+
+  const ppc::mpi::BlockPartition part(n, world.size());
+  const int first = part.displs[world.rank()];
+  const int rows = part.counts[world.rank()];
+  for (const auto format : {ppc::mpi::SpmvFormat::Csr, ppc::mpi::SpmvFormat::Sell}) {
+    ppc::mpi::DistributedSpmv<double> spmv(
+        world, part,
+        ppc::mpi::scatterCsr(world, part, n, a.row_ptr.data(), a.col_idx.data(), a.values.data()), format);
+    EXPECT_EQ(spmv.rows(), static_cast<size_t>(rows));
+    EXPECT_LE(spmv.ghosts(), 3U);
+    EXPECT_LE(spmv.neighbours(), 3U);
+    EXPECT_EQ(spmv.local().at(0, 0), 4.0 + first);
+    std::vector<double> y(rows, -1.0);
+    spmv.multiply(x.data() + first, y.data(), 2);
+    for (int i = 0; i < rows; i++) {
+      EXPECT_DOUBLE_EQ(y[i], expected[first + i]) << first + i;
+    }
+  }
+}
@@ -0,0 +1,282 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "core/kernels/include/band.hpp"
+#include "core/kernels/include/lu.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+
+namespace ppc::mpi {
+
+// Distributed solver for an n x n band matrix with kl lower and ku upper
+// diagonals (a partitioned "spike" solver). Every process owns a contiguous
+// block of rows, so A = diag(A_i) plus couplings C_i (the top kl rows of block
+// i into the last kl columns of block i - 1) and B_i (the bottom ku rows into
+// the first ku columns of block i + 1), and
+//   x_i = A_i^-1 f_i - W_i s_{i-1} - V_i t_{i+1},
+// with the spikes W_i = A_i^-1 C_i, V_i = A_i^-1 B_i, s_{i-1} the last kl
+// unknowns of block i - 1 and t_{i+1} the first ku of block i + 1. Taking the
+// top ku and bottom kl rows of that equation gives a block tridiagonal system
+// in the kl + ku boundary unknowns of every block, solved by block
+// elimination along the chain of processes.
+//
+// Each process factorises its block with bandFactor() and forms its spikes
+// independently, in O((n / p) * (kl + ku)^2). The only messages are between
+// neighbouring ranks and hold boundary data: kl x ku values per rank in
+// factorise(), kl and ku values per right-hand side in solve(). Blocks must
+// have at least kl + ku rows, which caps the number of processes used; the
+// others stay idle. A block is factorised with pivoting inside it only, so a
+// nonsingular A can still give a singular A_i; then the band rows are gathered
+// and factorised on rank 0 instead.
+template <class T>
+class BandEngine {
+  static_assert(std::is_floating_point_v<T>);
+
+ public:
+  // Collective over `world`; n and band must be the same on every process.
+  BandEngine(const boost::mpi::communicator& world, int n, ppc::core::kernels::Bandwidth band)
+      : world_(world),
+        n_(n),
+        kl_(static_cast<int>(band.lower)),
+        ku_(static_cast<int>(band.upper)),
+        d_(kl_ + ku_),
+        active_(std::clamp(n / std::max(d_, 1), 1, world.size())),
+        row_counts_(world.size(), 0),
+        row_displs_(world.size(), n) {
+    const BlockPartition part(n, active_);
+    std::copy(part.counts.begin(), part.counts.end(), row_counts_.begin());
+    std::copy(part.displs.begin(), part.displs.end(), row_displs_.begin());
+    m_ = row_counts_[world.rank()];
+    first_ = row_displs_[world.rank()];
+  }
+
+  // Rank 0 sends every process its rows of the compact band rows `rows` (row
+  // i holds columns i - kl .. i + ku at rows[i * (kl + ku + 1) + j - i + kl],
+  // as BandMatrix::fromRows() takes them); ignored on other ranks.
+  void distribute(const T* rows) {
+    const int width = kl_ + ku_ + 1;
+    rows_.resize(static_cast<size_t>(m_) * width);
+    const auto counts = scaled(row_counts_, width);
+    const auto displs = scaled(row_displs_, width);
+    MPI_Scatterv(rows, counts.data(), displs.data(), mpiTypeOf<T>(), rows_.data(), m_ * width, mpiTypeOf<T>(), 0,
+                 world_);
+  }
+
+  // Factorises the blocks, forms the spikes and eliminates the boundary
+  // system down the chain. Returns false (on every process) if A is singular.
+  bool factorise() {
+    gathered_ = false;
+    bool regular = m_ == 0 || factoriseBlock();
+    if (isActive() && active_ > 1) regular = eliminateBoundary(regular) && regular;
+    if (boost::mpi::all_reduce(world_, regular, std::logical_and<>())) return true;
+    return factoriseGathered();
+  }
+
+  // X = A^-1 B for the n x nrhs row-major B on rank 0; X is written to `x` on
+  // rank 0 (both ignored on other ranks).
+  void solve(const T* b, T* x, int nrhs = 1) {
+    if (gathered_) {
+      if (world_.rank() == 0) {
+        std::copy(b, b + static_cast<size_t>(n_) * nrhs, x);
+        ppc::core::kernels::bandSolve(full_, full_pivots_.data(), x, nrhs);
+      }
+      return;
+    }
+    const auto counts = scaled(row_counts_, nrhs);
+    const auto displs = scaled(row_displs_, nrhs);
+    std::vector<T> local(static_cast<size_t>(m_) * nrhs);
+    MPI_Scatterv(b, counts.data(), displs.data(), mpiTypeOf<T>(), local.data(), m_ * nrhs, mpiTypeOf<T>(), 0, world_);
+    if (isActive()) solveBlock(local.data(), nrhs);
+    MPI_Gatherv(local.data(), m_ * nrhs, mpiTypeOf<T>(), x, counts.data(), displs.data(), mpiTypeOf<T>(), 0, world_);
+  }
+
+  // Number of processes holding rows (the first activeProcesses() ranks).
+  [[nodiscard]] int activeProcesses() const { return active_; }
+  // True if the last factorise() had to fall back to rank 0.
+  [[nodiscard]] bool gathered() const { return gathered_; }
+  [[nodiscard]] int localRows() const { return m_; }
+
+ private:
+  static std::vector<int> scaled(const std::vector<int>& values, int factor) {
+    std::vector<int> result(values.size());
+    std::transform(values.begin(), values.end(), result.begin(), [factor](int value) { return value * factor; });
+    return result;
+  }
+
+  [[nodiscard]] bool isActive() const { return world_.rank() < active_; }
+  [[nodiscard]] bool hasPrevious() const { return world_.rank() > 0; }
+  [[nodiscard]] bool hasNext() const { return world_.rank() + 1 < active_; }
+
+  // Entry (global row i, global column j) of the own band rows, zero outside
+  // the band.
+  [[nodiscard]] T entry(int i, int j) const {
+    if (j < i - kl_ || j > i + ku_ || j < 0 || j >= n_) return T{};
+    return rows_[static_cast<size_t>(i - first_) * (kl_ + ku_ + 1) + (j - i + kl_)];
+  }
+
+  // Row `r` of the boundary rows of a block: the top ku rows, then the bottom
+  // kl rows.
+  [[nodiscard]] int boundaryRow(int r) const { return r < ku_ ? r : m_ - d_ + r; }
+
+  // Rows r of `matrix` (m x cols) at the boundary rows, as a d x cols matrix.
+  std::vector<T> boundaryRows(const std::vector<T>& matrix, int cols) const {
+    std::vector<T> rows(static_cast<size_t>(d_) * cols);
+    for (int r = 0; r < d_; r++) {
+      std::copy_n(matrix.begin() + static_cast<ptrdiff_t>(boundaryRow(r)) * cols, cols,
+                  rows.begin() + static_cast<ptrdiff_t>(r) * cols);
+    }
+    return rows;
+  }
+
+  bool factoriseBlock() {
+    const ppc::core::kernels::Bandwidth band{static_cast<size_t>(kl_), static_cast<size_t>(ku_)};
+    local_ = ppc::core::kernels::BandMatrix<T>(m_, band);
+    for (int li = 0; li < m_; li++) {
+      const int i = first_ + li;
+      for (int j = std::max(i - kl_, first_); j <= std::min(i + ku_, first_ + m_ - 1); j++) {
+        local_.at(li, j - first_) = entry(i, j);
+      }
+    }
+    local_pivots_.resize(m_);
+    const bool regular = ppc::core::kernels::bandFactor(local_, local_pivots_.data());
+
+    // C_i: columns first - kl .. first - 1; B_i: columns first + m .. first + m + ku - 1.
+    w_.assign(static_cast<size_t>(m_) * kl_, T{});
+    v_.assign(static_cast<size_t>(m_) * ku_, T{});
+    for (int li = 0; li < std::min(kl_, m_); li++) {
+      for (int c = 0; c < kl_; c++) w_[li * kl_ + c] = entry(first_ + li, first_ - kl_ + c);
+    }
+    for (int li = std::max(m_ - ku_, 0); li < m_; li++) {
+      for (int c = 0; c < ku_; c++) v_[li * ku_ + c] = entry(first_ + li, first_ + m_ + c);
+    }
+    if (regular) {
+      ppc::core::kernels::bandSolve(local_, local_pivots_.data(), w_.data(), kl_);
+      ppc::core::kernels::bandSolve(local_, local_pivots_.data(), v_.data(), ku_);
+    }
+    return regular;
+  }
+
+  // Block elimination of the boundary system: S_i = I - W_i' E_{i-1}, with W_i'
+  // the boundary rows of W_i and E_{i-1} the bottom kl rows of
+  // S_{i-1}^-1 V_{i-1}', received from the previous rank. Sends the same rows
+  // of S_i^-1 V_i' on. `regular` false poisons the chain instead of leaving
+  // the neighbours waiting.
+  bool eliminateBoundary(bool regular) {
+    previous_e_.assign(static_cast<size_t>(kl_) * ku_, T{});
+    if (hasPrevious()) {
+      MPI_Recv(previous_e_.data(), kl_ * ku_, mpiTypeOf<T>(), world_.rank() - 1, 0, world_, MPI_STATUS_IGNORE);
+    }
+    s_.assign(static_cast<size_t>(d_) * d_, T{});
+    for (int r = 0; r < d_; r++) s_[r * d_ + r] = T{1};
+    if (hasPrevious()) {
+      const auto w_boundary = boundaryRows(w_, kl_);
+      ppc::core::kernels::gemmSubtract(d_, ku_, kl_, w_boundary.data(), kl_, previous_e_.data(), ku_, s_.data(), d_);
+    }
+    s_pivots_.resize(d_);
+    regular = ppc::core::kernels::luFactor(d_, s_.data(), d_, s_pivots_.data()) && regular;
+    e_ = boundaryRows(v_, ku_);
+    if (regular) ppc::core::kernels::luSolve(d_, s_.data(), d_, s_pivots_.data(), e_.data(), ku_, ku_, 1);
+    if (hasNext()) {
+      MPI_Send(e_.data() + static_cast<size_t>(ku_) * ku_, kl_ * ku_, mpiTypeOf<T>(), world_.rank() + 1, 0, world_);
+    }
+    return regular;
+  }
+
+  // Replaces the own rows of B (m x nrhs) by those of X.
+  void solveBlock(T* x, int nrhs) {
+    ppc::core::kernels::bandSolve(local_, local_pivots_.data(), x, nrhs);  // g = A_i^-1 f_i
+    if (active_ == 1) return;
+    std::vector<T> g(x, x + static_cast<size_t>(m_) * nrhs);
+
+    // Forward: q_i = S_i^-1 (g_i' - W_i' q_{i-1}''), q'' the bottom kl rows.
+    std::vector<T> previous_q(static_cast<size_t>(kl_) * nrhs, T{});
+    if (hasPrevious()) {
+      MPI_Recv(previous_q.data(), kl_ * nrhs, mpiTypeOf<T>(), world_.rank() - 1, 1, world_, MPI_STATUS_IGNORE);
+    }
+    auto q = boundaryRows(g, nrhs);
+    if (hasPrevious()) {
+      const auto w_boundary = boundaryRows(w_, kl_);
+      ppc::core::kernels::gemmSubtract(d_, nrhs, kl_, w_boundary.data(), kl_, previous_q.data(), nrhs, q.data(), nrhs);
+    }
+    ppc::core::kernels::luSolve(d_, s_.data(), d_, s_pivots_.data(), q.data(), nrhs, nrhs, 1);
+    if (hasNext()) {
+      MPI_Send(q.data() + static_cast<size_t>(ku_) * nrhs, kl_ * nrhs, mpiTypeOf<T>(), world_.rank() + 1, 1, world_);
+    }
+
+    // Backward: u_i = q_i - E_i t_{i+1}; t_i (the top ku rows) goes back.
+    std::vector<T> next_t(static_cast<size_t>(ku_) * nrhs, T{});
+    if (hasNext()) {
+      MPI_Recv(next_t.data(), ku_ * nrhs, mpiTypeOf<T>(), world_.rank() + 1, 2, world_, MPI_STATUS_IGNORE);
+      ppc::core::kernels::gemmSubtract(d_, nrhs, ku_, e_.data(), ku_, next_t.data(), nrhs, q.data(), nrhs);
+    }
+    if (hasPrevious()) {
+      MPI_Send(q.data(), ku_ * nrhs, mpiTypeOf<T>(), world_.rank() - 1, 2, world_);
+    }
+
+    // s_{i-1} = q_{i-1}'' - E_{i-1} t_i, from data already here.
+    if (hasPrevious()) {
+      ppc::core::kernels::gemmSubtract(kl_, nrhs, ku_, previous_e_.data(), ku_, q.data(), nrhs, previous_q.data(),
+                                       nrhs);
+      ppc::core::kernels::gemmSubtract(m_, nrhs, kl_, w_.data(), kl_, previous_q.data(), nrhs, x, nrhs);
+    }
+    if (hasNext()) {
+      ppc::core::kernels::gemmSubtract(m_, nrhs, ku_, v_.data(), ku_, next_t.data(), nrhs, x, nrhs);
+    }
+  }
+
+  // Fallback: rank 0 factorises the whole band.
+  bool factoriseGathered() {
+    gathered_ = true;
+    const int width = kl_ + ku_ + 1;
+    std::vector<T> all;
+    if (world_.rank() == 0) all.resize(static_cast<size_t>(n_) * width);
+    const auto counts = scaled(row_counts_, width);
+    const auto displs = scaled(row_displs_, width);
+    MPI_Gatherv(rows_.data(), m_ * width, mpiTypeOf<T>(), all.data(), counts.data(), displs.data(), mpiTypeOf<T>(), 0,
+                world_);
+    bool regular = true;
+    if (world_.rank() == 0) {
+      full_ = ppc::core::kernels::BandMatrix<T>::fromRows(
+          n_, all.data(), {static_cast<size_t>(kl_), static_cast<size_t>(ku_)});
+      full_pivots_.resize(n_);
+      regular = ppc::core::kernels::bandFactor(full_, full_pivots_.data());
+    }
+    boost::mpi::broadcast(world_, regular, 0);
+    return regular;
+  }
+
+  boost::mpi::communicator world_;
+  int n_;
+  int kl_;
+  int ku_;
+  int d_;  // boundary unknowns per block, kl + ku
+  int active_;
+  std::vector<int> row_counts_;
+  std::vector<int> row_displs_;
+  int m_{};
+  int first_{};
+  std::vector<T> rows_;  // own compact band rows
+  ppc::core::kernels::BandMatrix<T> local_;
+  std::vector<int> local_pivots_;
+  std::vector<T> w_;           // A_i^-1 C_i, m x kl
+  std::vector<T> v_;           // A_i^-1 B_i, m x ku
+  std::vector<T> s_;           // LU of the boundary block S_i, d x d
+  std::vector<int> s_pivots_;
+  std::vector<T> e_;           // S_i^-1 V_i', d x ku
+  std::vector<T> previous_e_;  // bottom kl rows of the previous rank's e_
+  bool gathered_{};
+  ppc::core::kernels::BandMatrix<T> full_;  // fallback factors, rank 0
+  std::vector<int> full_pivots_;
+};
+
+}  // namespace ppc::mpi
@@ -0,0 +1,34 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "core/kernels/include/scan.hpp"
+
+namespace ppc::mpi {
+
+// Even split of n items between `size` processes: the first n % size ranks get
+// one item more. Block sizes never increase with the rank, so the non-empty
+// blocks are always held by ranks 0..k-1. counts/displs can be passed straight
+// to MPI_Scatterv/MPI_Gatherv.
+struct BlockPartition {
+  std::vector<int> counts;
+  std::vector<int> displs;
+
+  BlockPartition(int n, int size) : counts(size, n / size), displs(size, 0) {
+    for (int proc = 0; proc < n % size; proc++) {
+      counts[proc]++;
+    }
+    ppc::core::kernels::exclusiveScan(counts.data(), static_cast<std::size_t>(size), displs.data());
+  }
+
+  // Rank holding item `index` (0 <= index < n).
+  [[nodiscard]] int owner(int index) const {
+    return static_cast<int>(std::distance(displs.begin(), std::upper_bound(displs.begin(), displs.end(), index))) - 1;
+  }
+};
+
+}  // namespace ppc::mpi
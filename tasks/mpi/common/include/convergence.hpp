@@ -0,0 +1,83 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include "mpi/common/include/mpi_types.hpp"
+
+namespace ppc::mpi {
+
+// When an iterative solver looks at its global stopping test. Checking after
+// every sweep makes every process wait for the slowest one on every sweep; a
+// ConvergenceCheck instead reduces the local criterion with MPI_Iallreduce
+// and overlaps the reduction with the next sweep.
+//  Exact       - the solver waits for the reduction at the end of the next
+//                sweep; if it reports convergence, that sweep is discarded and
+//                the checked iterate is returned, as with a blocking check.
+//  Speculative - the reduction is only completed when the next check is due,
+//                `interval` sweeps later, by which time it has normally
+//                arrived; the solver keeps those sweeps and stops with its
+//                latest iterate. Every process completes the reduction after
+//                the same sweep, so they all stop together.
+enum class CheckMode { Exact, Speculative };
+
+// `interval`: a check is started every `interval` sweeps (when none is in
+// flight).
+struct ConvergencePolicy {
+  int interval = 1;
+  CheckMode mode = CheckMode::Exact;
+};
+
+// What one solve did. `iterations` counts the sweeps reflected in the returned
+// solution; `wasted_sweeps` counts those run after the iterate the successful
+// check was made on (discarded in Exact mode, kept in Speculative mode).
+struct SolveStats {
+  int iterations = 0;
+  int wasted_sweeps = 0;
+  int checks = 0;
+  double seconds = 0.0;
+  bool converged = false;
+};
+
+// One non-blocking MAX reduction of a scalar criterion at a time over `comm`.
+template <class T>
+class ConvergenceCheck {
+ public:
+  explicit ConvergenceCheck(MPI_Comm comm) : comm_(comm) {}
+
+  ConvergenceCheck(const ConvergenceCheck&) = delete;
+  ConvergenceCheck& operator=(const ConvergenceCheck&) = delete;
+
+  ~ConvergenceCheck() { cancel(); }
+
+  [[nodiscard]] bool pending() const { return request_ != MPI_REQUEST_NULL; }
+  // Sweep whose criterion is being reduced.
+  [[nodiscard]] int sweep() const { return sweep_; }
+
+  // Starts reducing `local`, the criterion of this process after `sweep`.
+  void start(T local, int sweep) {
+    value_ = local;
+    sweep_ = sweep;
+    MPI_Iallreduce(MPI_IN_PLACE, &value_, 1, mpiTypeOf<T>(), MPI_MAX, comm_, &request_);
+  }
+
+  // Global maximum of the criteria passed to start().
+  T wait() {
+    MPI_Wait(&request_, MPI_STATUS_IGNORE);
+    return value_;
+  }
+
+  // Completes a reduction that is no longer needed (e.g. after the last
+  // sweep). Every process must call it at the same point.
+  void cancel() {
+    if (pending()) MPI_Wait(&request_, MPI_STATUS_IGNORE);
+  }
+
+ private:
+  MPI_Comm comm_;
+  MPI_Request request_ = MPI_REQUEST_NULL;
+  T value_{};
+  int sweep_ = 0;
+};
+
+}  // namespace ppc::mpi
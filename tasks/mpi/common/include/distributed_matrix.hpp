@@ -0,0 +1,322 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/aligned_allocator.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/file_io.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/common/include/process_grid.hpp"
+
+namespace ppc::mpi {
+
+// How the indices of one matrix dimension are dealt to the processes of one
+// grid dimension.
+//  Block       - contiguous blocks as in BlockPartition.
+//  Cyclic      - index i goes to process i % procs.
+//  BlockCyclic - blocks of `block` indices dealt round-robin (ScaLAPACK style).
+enum class LayoutKind { Block, Cyclic, BlockCyclic };
+
+// Map between global indices and (owner, local index) pairs. Local indices of
+// a process follow the global order.
+class Layout1D {
+ public:
+  Layout1D(LayoutKind kind, int n, int procs, int block = 1)
+      : kind_(kind), n_(n), procs_(procs), block_(kind == LayoutKind::BlockCyclic ? block : 1), part_(n, procs) {}
+
+  static Layout1D block(int n, int procs) { return {LayoutKind::Block, n, procs}; }
+  static Layout1D cyclic(int n, int procs) { return {LayoutKind::Cyclic, n, procs}; }
+  static Layout1D blockCyclic(int n, int procs, int block) { return {LayoutKind::BlockCyclic, n, procs, block}; }
+
+  [[nodiscard]] LayoutKind kind() const { return kind_; }
+  [[nodiscard]] int size() const { return n_; }
+  [[nodiscard]] int procs() const { return procs_; }
+
+  [[nodiscard]] int owner(int global) const {
+    if (kind_ == LayoutKind::Block) return part_.owner(global);
+    return (global / block_) % procs_;
+  }
+
+  [[nodiscard]] int toLocal(int global) const {
+    if (kind_ == LayoutKind::Block) return global - part_.displs[owner(global)];
+    return (global / block_ / procs_) * block_ + global % block_;
+  }
+
+  [[nodiscard]] int toGlobal(int proc, int local) const {
+    if (kind_ == LayoutKind::Block) return part_.displs[proc] + local;
+    return ((local / block_) * procs_ + proc) * block_ + local % block_;
+  }
+
+  [[nodiscard]] int localSize(int proc) const {
+    if (kind_ == LayoutKind::Block) return part_.counts[proc];
+    const int blocks = (n_ + block_ - 1) / block_;
+    int size = (blocks / procs_ + (proc < blocks % procs_ ? 1 : 0)) * block_;
+    if (blocks > 0 && (blocks - 1) % procs_ == proc) {
+      size -= blocks * block_ - n_;  // the last block may be short
+    }
+    return size;
+  }
+
+  // Global indices owned by `proc`, ascending.
+  [[nodiscard]] std::vector<int> indicesOf(int proc) const {
+    std::vector<int> indices(localSize(proc));
+    for (int local = 0; local < static_cast<int>(indices.size()); local++) {
+      indices[local] = toGlobal(proc, local);
+    }
+    return indices;
+  }
+
+ private:
+  LayoutKind kind_;
+  int n_;
+  int procs_;
+  int block_;
+  BlockPartition part_;
+};
+
+// m x n matrix spread over a ProcessGrid: rows follow `row_layout` over the grid
+// rows and columns follow `col_layout` over the grid columns, so the process at
+// (r, c) owns every (i, j) with row_layout.owner(i) == r and
+// col_layout.owner(j) == c. A vector is a matrix with one column on a p x 1
+// grid. The local part is a row-major localRows() x localCols() block in
+// cache-line aligned storage, optionally framed by `ghost_rows` copies of the
+// neighbouring rows above and below for stencil-like solvers.
+//
+// Every transfer describes the scattered local indices with derived datatypes,
+// so scatter/gather/redistribute never pack into intermediate buffers.
+template <class T>
+class DistributedMatrix {
+ public:
+  using Storage = ppc::core::kernels::AlignedVector<T>;
+
+  // Every process of the grid's communicator must be a member of the grid.
+  DistributedMatrix(std::shared_ptr<const ProcessGrid> grid, Layout1D row_layout, Layout1D col_layout,
+                    int ghost_rows = 0)
+      : grid_(std::move(grid)),
+        row_layout_(std::move(row_layout)),
+        col_layout_(std::move(col_layout)),
+        local_rows_(row_layout_.localSize(grid_->row())),
+        local_cols_(col_layout_.localSize(grid_->col())),
+        ghost_rows_(ghost_rows),
+        storage_(static_cast<size_t>(local_rows_ + 2 * ghost_rows) * local_cols_, T{}) {}
+
+  [[nodiscard]] const ProcessGrid& grid() const { return *grid_; }
+  [[nodiscard]] const Layout1D& rowLayout() const { return row_layout_; }
+  [[nodiscard]] const Layout1D& colLayout() const { return col_layout_; }
+  [[nodiscard]] int rows() const { return row_layout_.size(); }
+  [[nodiscard]] int cols() const { return col_layout_.size(); }
+  [[nodiscard]] int localRows() const { return local_rows_; }
+  [[nodiscard]] int localCols() const { return local_cols_; }
+  [[nodiscard]] int ghostRows() const { return ghost_rows_; }
+
+  // First owned element; owned rows are contiguous with stride localCols().
+  // Ghost rows sit at local row indices -ghostRows() .. -1 and
+  // localRows() .. localRows() + ghostRows() - 1.
+  [[nodiscard]] T* data() { return storage_.data() + static_cast<size_t>(ghost_rows_) * local_cols_; }
+  [[nodiscard]] const T* data() const { return storage_.data() + static_cast<size_t>(ghost_rows_) * local_cols_; }
+  [[nodiscard]] T* row(int local_row) { return data() + static_cast<ptrdiff_t>(local_row) * local_cols_; }
+  [[nodiscard]] const T* row(int local_row) const { return data() + static_cast<ptrdiff_t>(local_row) * local_cols_; }
+  T& operator()(int local_row, int local_col) { return row(local_row)[local_col]; }
+  const T& operator()(int local_row, int local_col) const { return row(local_row)[local_col]; }
+
+  // Rank 0 of the grid sends every process its part of the row-major m x n
+  // `matrix` (ignored on other ranks).
+  void scatter(const T* matrix) {
+    std::vector<std::pair<int, MPI_Datatype>> types;
+    std::vector<MPI_Request> requests;
+    if (isRoot()) {
+      types = partTypes();
+      requests.resize(types.size());
+      for (size_t i = 0; i < types.size(); i++) {
+        MPI_Isend(matrix, 1, types[i].second, types[i].first, 0, grid_->cart(), &requests[i]);
+      }
+    }
+    if (local_rows_ > 0 && local_cols_ > 0) {
+      MPI_Recv(data(), local_rows_ * local_cols_, mpiTypeOf<T>(), 0, 0, grid_->cart(), MPI_STATUS_IGNORE);
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    for (auto& part : types) {
+      MPI_Type_free(&part.second);
+    }
+  }
+
+  // Inverse of scatter(): rank 0 receives every part in place into `matrix`.
+  void gather(T* matrix) const {
+    std::vector<std::pair<int, MPI_Datatype>> types;
+    std::vector<MPI_Request> requests;
+    if (isRoot()) {
+      types = partTypes();
+      requests.resize(types.size());
+      for (size_t i = 0; i < types.size(); i++) {
+        MPI_Irecv(matrix, 1, types[i].second, types[i].first, 1, grid_->cart(), &requests[i]);
+      }
+    }
+    if (local_rows_ > 0 && local_cols_ > 0) {
+      MPI_Send(data(), local_rows_ * local_cols_, mpiTypeOf<T>(), 0, 1, grid_->cart());
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    for (auto& part : types) {
+      MPI_Type_free(&part.second);
+    }
+  }
+
+  // Alternative to scatter() for matrices stored in a file (see file_io.hpp):
+  // every process reads its own part straight into local storage with one
+  // collective MPI_File_read_at_all; rank 0 never holds the whole matrix.
+  // Returns false if the file cannot be opened.
+  bool readFile(const std::string& path) {
+    const std::vector<int> rows = row_layout_.indicesOf(grid_->row());
+    const std::vector<int> cols = col_layout_.indicesOf(grid_->col());
+    const bool owns = !rows.empty() && !cols.empty();
+    MPI_Datatype filetype = owns ? makeType(rows, cols, col_layout_.size()) : mpiTypeOf<T>();
+    const bool read = readView<T>(grid_->cart(), path, 0, filetype, data(), owns ? local_rows_ * local_cols_ : 0,
+                                  mpiTypeOf<T>());
+    if (owns) MPI_Type_free(&filetype);
+    return read;
+  }
+
+  // Refreshes the ghost rows from the neighbouring grid rows (column
+  // communicator). Needs a Block row layout in which every process owns at
+  // least ghostRows() rows; the ghosts at the global top and bottom are left
+  // untouched.
+  void exchangeGhosts() {
+    if (ghost_rows_ == 0 || local_cols_ == 0) return;
+    const int up = grid_->row() > 0 ? grid_->row() - 1 : MPI_PROC_NULL;
+    const int down = grid_->row() + 1 < grid_->rows() ? grid_->row() + 1 : MPI_PROC_NULL;
+    const int count = ghost_rows_ * local_cols_;
+    MPI_Sendrecv(row(0), count, mpiTypeOf<T>(), up, 0, row(local_rows_), count, mpiTypeOf<T>(), down, 0,
+                 grid_->col_comm(), MPI_STATUS_IGNORE);
+    MPI_Sendrecv(row(local_rows_ - ghost_rows_), count, mpiTypeOf<T>(), down, 1, row(-ghost_rows_), count,
+                 mpiTypeOf<T>(), up, 1, grid_->col_comm(), MPI_STATUS_IGNORE);
+  }
+
+  // Copies this matrix into `target`, another matrix of the same shape on the
+  // same grid that may use other layouts (and ghost rows). Every pair of processes exchanges
+  // the elements in the intersection of their parts, all in one
+  // MPI_Alltoallw.
+  void redistributeTo(DistributedMatrix& target) const {
+    const int size = grid_->size();
+    const std::vector<int> my_rows = row_layout_.indicesOf(grid_->row());
+    const std::vector<int> my_cols = col_layout_.indicesOf(grid_->col());
+    const std::vector<int> target_rows = target.row_layout_.indicesOf(grid_->row());
+    const std::vector<int> target_cols = target.col_layout_.indicesOf(grid_->col());
+
+    std::vector<int> send_counts(size, 0);
+    std::vector<int> recv_counts(size, 0);
+    const std::vector<int> displs(size, 0);
+    std::vector<MPI_Datatype> send_types(size, mpiTypeOf<T>());
+    std::vector<MPI_Datatype> recv_types(size, mpiTypeOf<T>());
+    for (int proc = 0; proc < size; proc++) {
+      const auto [r, c] = grid_->coordsOf(proc);
+      // What this process holds of proc's target part, in local source indices.
+      const auto send_rows = localIndices(intersect(my_rows, target.row_layout_.indicesOf(r)), row_layout_);
+      const auto send_cols = localIndices(intersect(my_cols, target.col_layout_.indicesOf(c)), col_layout_);
+      if (!send_rows.empty() && !send_cols.empty()) {
+        send_types[proc] = makeType(send_rows, send_cols, local_cols_);
+        send_counts[proc] = 1;
+      }
+      // What proc holds of this process's target part, in local target indices.
+      const auto recv_rows = localIndices(intersect(row_layout_.indicesOf(r), target_rows), target.row_layout_);
+      const auto recv_cols = localIndices(intersect(col_layout_.indicesOf(c), target_cols), target.col_layout_);
+      if (!recv_rows.empty() && !recv_cols.empty()) {
+        recv_types[proc] = makeType(recv_rows, recv_cols, target.local_cols_);
+        recv_counts[proc] = 1;
+      }
+    }
+    MPI_Alltoallw(data(), send_counts.data(), displs.data(), send_types.data(), target.data(), recv_counts.data(),
+                  displs.data(), recv_types.data(), grid_->cart());
+    for (int proc = 0; proc < size; proc++) {
+      if (send_counts[proc] != 0) MPI_Type_free(&send_types[proc]);
+      if (recv_counts[proc] != 0) MPI_Type_free(&recv_types[proc]);
+    }
+  }
+
+ private:
+  static std::vector<int> intersect(const std::vector<int>& a, const std::vector<int>& b) {
+    std::vector<int> common;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+    return common;
+  }
+
+  static std::vector<int> localIndices(std::vector<int> global, const Layout1D& layout) {
+    for (auto& index : global) {
+      index = layout.toLocal(index);
+    }
+    return global;
+  }
+
+  // Datatype selecting rows x cols (ascending indices) of a row-major matrix
+  // with `ld` columns: an indexed block of columns, resized to the extent of a
+  // full row, repeated as an indexed block of rows. Contiguous index runs
+  // (block layouts) collapse to a vector datatype.
+  static MPI_Datatype makeType(const std::vector<int>& rows, const std::vector<int>& cols, int ld) {
+    const auto contiguous = [](const std::vector<int>& indices) {
+      return indices.back() - indices.front() + 1 == static_cast<int>(indices.size());
+    };
+    MPI_Datatype type;
+    if (contiguous(rows) && contiguous(cols)) {
+      MPI_Datatype tile;
+      MPI_Type_vector(static_cast<int>(rows.size()), static_cast<int>(cols.size()), ld, mpiTypeOf<T>(), &tile);
+      const MPI_Aint offset = (static_cast<MPI_Aint>(rows.front()) * ld + cols.front()) * sizeof(T);
+      const int one = 1;
+      MPI_Type_create_struct(1, &one, &offset, &tile, &type);
+      MPI_Type_free(&tile);
+    } else {
+      MPI_Datatype row_part;
+      MPI_Datatype row_type;
+      MPI_Type_create_indexed_block(static_cast<int>(cols.size()), 1, cols.data(), mpiTypeOf<T>(), &row_part);
+      MPI_Type_create_resized(row_part, 0, static_cast<MPI_Aint>(ld) * sizeof(T), &row_type);
+      MPI_Type_create_indexed_block(static_cast<int>(rows.size()), 1, rows.data(), row_type, &type);
+      MPI_Type_free(&row_type);
+      MPI_Type_free(&row_part);
+    }
+    MPI_Type_commit(&type);
+    return type;
+  }
+
+  // Datatype of every non-empty part inside the full row-major matrix, with
+  // the rank owning it.
+  [[nodiscard]] std::vector<std::pair<int, MPI_Datatype>> partTypes() const {
+    std::vector<std::pair<int, MPI_Datatype>> types;
+    for (int proc = 0; proc < grid_->size(); proc++) {
+      const auto [r, c] = grid_->coordsOf(proc);
+      const std::vector<int> rows = row_layout_.indicesOf(r);
+      const std::vector<int> cols = col_layout_.indicesOf(c);
+      if (rows.empty() || cols.empty()) continue;
+      types.emplace_back(proc, makeType(rows, cols, col_layout_.size()));
+    }
+    return types;
+  }
+
+  [[nodiscard]] bool isRoot() const {
+    int rank = 0;
+    MPI_Comm_rank(grid_->cart(), &rank);
+    return rank == 0;
+  }
+
+  std::shared_ptr<const ProcessGrid> grid_;
+  Layout1D row_layout_;
+  Layout1D col_layout_;
+  int local_rows_;
+  int local_cols_;
+  int ghost_rows_;
+  Storage storage_;
+};
+
+// Vector of n elements in `layout` over the processes of a p x 1 grid.
+template <class T>
+DistributedMatrix<T> makeDistributedVector(std::shared_ptr<const ProcessGrid> grid, const Layout1D& layout,
+                                           int ghost = 0) {
+  return DistributedMatrix<T>(std::move(grid), layout, Layout1D::block(1, 1), ghost);
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,118 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/communicator.hpp>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "core/kernels/include/echelon.hpp"
+#include "core/kernels/include/lu.hpp"
+#include "mpi/common/include/distributed_matrix.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/common/include/process_grid.hpp"
+
+namespace ppc::mpi {
+
+// Number of transpositions in the permutation taking position j to perm[j]:
+// n minus the number of cycles.
+inline std::size_t permutationSwaps(const std::vector<int>& perm) {
+  std::vector<char> seen(perm.size(), 0);
+  std::size_t swaps = 0;
+  for (std::size_t start = 0; start < perm.size(); start++) {
+    if (seen[start] != 0) continue;
+    for (auto j = start; seen[j] == 0; j = static_cast<std::size_t>(perm[j])) {
+      seen[j] = 1;
+      swaps++;
+    }
+    swaps--;
+  }
+  return swaps;
+}
+
+// ppc::core::kernels::rowEchelon() over `world`, collective: rank 0 passes the
+// row-major m x n matrix `a` (ignored on other ranks), every process gets the
+// rank and, for a square full-rank A, the determinant. Rows are dealt
+// cyclically, so the rows still to be reduced stay spread evenly as pivot rows
+// drop out. Nothing is swapped: pivot rows and columns are only marked. Per
+// step one MPI_MAXLOC reduction elects the largest remaining entry of all
+// processes and its owner broadcasts that row, two collectives per pivot and
+// O(m n / p) flops per process. m n must fit in an int. `tolerance` as in
+// rowEchelon().
+template <class T>
+ppc::core::kernels::EchelonResult rowEchelon(const boost::mpi::communicator& world, int m, int n, const T* a,
+                                             double tolerance = -1.0) {
+  const int procs = world.size();
+  auto grid = std::make_shared<const ProcessGrid>(world, std::array<int, 2>{procs, 1}, false);
+  DistributedMatrix<T> rows(grid, Layout1D::cyclic(m, procs), Layout1D::block(n, 1));
+  rows.scatter(a);
+  const std::vector<int> globals = rows.rowLayout().indicesOf(world.rank());
+  if (tolerance < 0.0) {
+    double sum_squares = 0.0;
+    for (int i = 0; i < rows.localRows(); i++) {
+      for (int j = 0; j < n; j++) sum_squares += static_cast<double>(rows(i, j)) * static_cast<double>(rows(i, j));
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &sum_squares, 1, MPI_DOUBLE, MPI_SUM, world);
+    tolerance = ppc::core::kernels::rankTolerance<T>(m, n, sum_squares);
+  }
+
+  std::vector<char> reduced(rows.localRows(), 0);
+  std::vector<char> used_cols(n, 0);
+  std::vector<int> pivot_rows;
+  std::vector<int> pivot_cols;
+  std::vector<T> pivots;
+  std::vector<T> pivot_row(n);
+  struct {
+    double value;
+    int index;  // i * n + j
+  } best{};
+  while (static_cast<int>(pivots.size()) < std::min(m, n)) {
+    best = {-1.0, -1};
+    for (int i = 0; i < rows.localRows(); i++) {
+      if (reduced[i] != 0) continue;
+      for (int j = 0; j < n; j++) {
+        const double value = std::abs(static_cast<double>(rows(i, j)));
+        if (used_cols[j] == 0 && value > best.value) best = {value, globals[i] * n + j};
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &best, 1, MPI_DOUBLE_INT, MPI_MAXLOC, world);
+    if (!(best.value > tolerance)) break;
+    const int row = best.index / n;
+    const int col = best.index % n;
+    const int owner = rows.rowLayout().owner(row);
+    if (owner == world.rank()) {
+      const int local = rows.rowLayout().toLocal(row);
+      reduced[local] = 1;
+      std::copy(rows.row(local), rows.row(local) + n, pivot_row.begin());
+    }
+    MPI_Bcast(pivot_row.data(), n, mpiTypeOf<T>(), owner, world);
+    // Entries of the remaining rows in used columns are already zero, and so
+    // are those of the pivot row, so whole rows can be updated.
+    for (int i = 0; i < rows.localRows(); i++) {
+      if (reduced[i] != 0) continue;
+      T* row_i = rows.row(i);
+      const T factor = row_i[col] / pivot_row[col];
+      for (int j = 0; j < n; j++) row_i[j] -= factor * pivot_row[j];
+      row_i[col] = T{};
+    }
+    used_cols[col] = 1;
+    pivot_rows.push_back(row);
+    pivot_cols.push_back(col);
+    pivots.push_back(pivot_row[col]);
+  }
+
+  ppc::core::kernels::EchelonResult result{pivots.size(), {}};
+  if (m == n && static_cast<int>(pivots.size()) == n) {
+    // Step j eliminates with entry (pivot_rows[j], pivot_cols[j]) of A.
+    result.determinant = ppc::core::kernels::diagonalDeterminant(
+        n, [&](std::size_t i) { return pivots[i]; }, permutationSwaps(pivot_rows) + permutationSwaps(pivot_cols));
+  }
+  return result;
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,63 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#include "mpi/common/include/mpi_types.hpp"
+
+namespace ppc::mpi {
+
+// Operands too large for one process live in raw binary files: the row-major
+// elements of T, native byte order, no header. Every process reads only the
+// elements it owns, with one collective MPI_File_read_at_all, so no rank has to
+// hold or send the whole matrix.
+
+// True if `path` is a regular file of exactly `bytes` bytes.
+inline bool fileHolds(const std::string& path, std::uintmax_t bytes) {
+  std::error_code error;
+  return std::filesystem::is_regular_file(path, error) && std::filesystem::file_size(path, error) == bytes && !error;
+}
+
+// Collective over `comm`. The file is viewed through `filetype` (in units of
+// T, starting `displacement` bytes into the file) and `count` elements of
+// `memtype` are read into `buffer`; count may be 0 on processes that own
+// nothing. Returns false if the file cannot be opened.
+template <class T>
+bool readView(MPI_Comm comm, const std::string& path, MPI_Offset displacement, MPI_Datatype filetype, void* buffer,
+              int count, MPI_Datatype memtype) {
+  MPI_File file;
+  if (MPI_File_open(comm, path.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+    return false;
+  }
+  char datarep[] = "native";
+  MPI_File_set_view(file, displacement, mpiTypeOf<T>(), filetype, datarep, MPI_INFO_NULL);
+  const int status = MPI_File_read_at_all(file, 0, buffer, count, memtype, MPI_STATUS_IGNORE);
+  MPI_File_close(&file);
+  return status == MPI_SUCCESS;
+}
+
+// Collective read of the rows x cols tile at (row0, col0) of the file matrix
+// with `ld` columns into `tile`, whose rows are `tile_ld` elements apart (so
+// the tile may land in a padded buffer).
+template <class T>
+bool readTile(MPI_Comm comm, const std::string& path, int ld, int row0, int col0, int rows, int cols, T* tile,
+              int tile_ld) {
+  MPI_Datatype filetype;
+  MPI_Datatype memtype;
+  MPI_Type_vector(rows, cols, ld, mpiTypeOf<T>(), &filetype);
+  MPI_Type_vector(rows, cols, tile_ld, mpiTypeOf<T>(), &memtype);
+  MPI_Type_commit(&filetype);
+  MPI_Type_commit(&memtype);
+  const MPI_Offset displacement = (static_cast<MPI_Offset>(row0) * ld + col0) * static_cast<MPI_Offset>(sizeof(T));
+  const bool read = readView<T>(comm, path, displacement, filetype, tile, rows > 0 && cols > 0 ? 1 : 0, memtype);
+  MPI_Type_free(&memtype);
+  MPI_Type_free(&filetype);
+  return read;
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,251 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <boost/mpi/communicator.hpp>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/aligned_allocator.hpp"
+#include "core/kernels/include/dot_product.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/convergence.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/common/include/sparse.hpp"
+
+namespace ppc::mpi {
+
+// Distributed Jacobi iteration x' = x + D^-1 (b - A x) for an n x n system.
+// Every process owns a block of rows (BlockPartition(n, size)), stored once as
+// one contiguous row-major array, and keeps two preallocated iterates that are
+// swapped after every sweep, so the iteration itself allocates nothing.
+//
+// The new values are exchanged with a single MPI_Allgatherv per sweep, after
+// which every process holds both full iterates and evaluates the stopping
+// test max |x' - x| <= eps itself, without another collective. For a band
+// matrix (a[i][j] == 0 whenever |i - j| > bandwidth) only the columns within the
+// band of the own rows are stored, and when every block has at least
+// `bandwidth` rows the sweep exchanges just `bandwidth` boundary values with
+// each neighbouring rank. A sparse matrix given as CSR (distributeCsr())
+// is multiplied by a DistributedSpmv, which fetches only the remote entries of
+// x its rows touch. In both cases the stopping test needs a reduction, which
+// runs through a ConvergenceCheck: started every policy.interval sweeps and
+// overlapped with the following sweep(s).
+template <class T>
+class JacobiEngine {
+  static_assert(std::is_floating_point_v<T>);
+
+ public:
+  // Collective over `world`; n and bandwidth must be the same on every
+  // process. A negative bandwidth means a dense matrix.
+  JacobiEngine(const boost::mpi::communicator& world, int n, int bandwidth = -1)
+      : world_(world), n_(n), band_(bandwidth < 0 ? n : std::min(bandwidth, n)), part_(n, world.size()) {
+    first_row_ = part_.displs[world.rank()];
+    local_rows_ = part_.counts[world.rank()];
+    std::tie(window_begin_, window_end_) = window(world.rank());
+    // Block sizes never increase with the rank, so the last block is the smallest.
+    neighbour_exchange_ = bandwidth >= 0 && world.size() > 1 && part_.counts.back() >= band_;
+
+    b_.resize(local_rows_);
+    inv_diagonal_.resize(local_rows_);
+    ax_.resize(local_rows_);
+    x_.assign(n, T{});
+    x_next_.assign(n, T{});
+  }
+
+  // Rank 0 sends every process the band window of its rows of the row-major
+  // n x n matrix `a` and its part of `b` (both ignored on other ranks).
+  void distribute(const T* a, const T* b) {
+    spmv_.reset();
+    a_.resize(static_cast<std::size_t>(local_rows_) * (window_end_ - window_begin_));
+    std::vector<MPI_Datatype> types;
+    std::vector<MPI_Request> requests;
+    if (world_.rank() == 0) {
+      types.resize(world_.size());
+      requests.resize(world_.size());
+      for (int proc = 0; proc < world_.size(); proc++) {
+        const auto [begin, end] = window(proc);
+        MPI_Type_vector(part_.counts[proc], end - begin, n_, mpiTypeOf<T>(), &types[proc]);
+        MPI_Type_commit(&types[proc]);
+        const T* rows = a + static_cast<std::size_t>(part_.displs[proc]) * n_ + begin;
+        MPI_Isend(rows, part_.counts[proc] > 0 ? 1 : 0, types[proc], proc, 0, world_, &requests[proc]);
+      }
+    }
+    MPI_Recv(a_.data(), static_cast<int>(a_.size()), mpiTypeOf<T>(), 0, 0, world_, MPI_STATUS_IGNORE);
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    for (auto& type : types) {
+      MPI_Type_free(&type);
+    }
+    MPI_Scatterv(b, part_.counts.data(), part_.displs.data(), mpiTypeOf<T>(), b_.data(), local_rows_, mpiTypeOf<T>(),
+                 0, world_);
+    const int width = window_end_ - window_begin_;
+    for (int i = 0; i < local_rows_; i++) {
+      inv_diagonal_[i] = T{1} / a_[static_cast<std::size_t>(i) * width + first_row_ + i - window_begin_];
+    }
+  }
+
+  // Alternative to distribute() for a sparse matrix held by rank 0 in CSR form
+  // (row_ptr, col_idx, values; see ppc::core::kernels::CsrMatrix). Only the
+  // own rows are stored; the bandwidth given to the constructor is ignored.
+  void distributeCsr(const int* row_ptr, const int* col_idx, const T* values, const T* b,
+                     SpmvFormat format = SpmvFormat::Csr) {
+    a_.clear();
+    spmv_.emplace(world_, part_, scatterCsr(world_, part_, n_, row_ptr, col_idx, values), format);
+    MPI_Scatterv(b, part_.counts.data(), part_.displs.data(), mpiTypeOf<T>(), b_.data(), local_rows_, mpiTypeOf<T>(),
+                 0, world_);
+    for (int i = 0; i < local_rows_; i++) {
+      inv_diagonal_[i] = T{1} / spmv_->local().at(i, i);
+    }
+  }
+
+  // Iterates from x = 0 until max |x' - x| <= eps (tested every
+  // policy.interval sweeps) or `max_iterations` sweeps. A check still in
+  // flight after the last sweep is completed and counted.
+  SolveStats solve(T eps, int max_iterations, ConvergencePolicy policy = {}) {
+    const double start = MPI_Wtime();
+    const int interval = std::max(1, policy.interval);
+    std::fill(x_.begin(), x_.end(), T{});
+    stats_ = {};
+    ConvergenceCheck<T> check(world_);
+    for (int sweep = 1; sweep <= max_iterations; sweep++) {
+      const T local_change = computeSweep();
+      const bool due = sweep % interval == 0;
+      if (!distributedTest()) {
+        // Both full iterates are on every process: the test is local.
+        std::swap(x_, x_next_);
+        stats_.iterations = sweep;
+        if (due) {
+          stats_.checks++;
+          if (maxChange() <= eps) {
+            stats_.converged = true;
+            break;
+          }
+        }
+        continue;
+      }
+      if (check.pending() && policy.mode == CheckMode::Exact && check.wait() <= eps) {
+        // x_ still holds the checked iterate; this sweep is dropped.
+        stats_.converged = true;
+        stats_.wasted_sweeps = sweep - check.sweep();
+        break;
+      }
+      std::swap(x_, x_next_);
+      stats_.iterations = sweep;
+      if (due) {
+        if (check.pending() && check.wait() <= eps) {
+          stats_.converged = true;
+          stats_.wasted_sweeps = sweep - check.sweep();
+          break;
+        }
+        stats_.checks++;
+        check.start(local_change, sweep);
+      }
+    }
+    if (check.pending() && check.wait() <= eps) {
+      stats_.converged = true;
+      stats_.wasted_sweeps = stats_.iterations - check.sweep();
+    }
+    stats_.seconds = MPI_Wtime() - start;
+    return stats_;
+  }
+
+  // Statistics of the last solve().
+  [[nodiscard]] const SolveStats& stats() const { return stats_; }
+  [[nodiscard]] int iterations() const { return stats_.iterations; }
+  [[nodiscard]] bool neighbourExchange() const { return neighbour_exchange_; }
+  [[nodiscard]] bool sparse() const { return spmv_.has_value(); }
+
+  // Collects the last iterate on rank 0 (`x` ignored on other ranks).
+  void gather(T* x) const {
+    MPI_Gatherv(x_.data() + first_row_, local_rows_, mpiTypeOf<T>(), x, part_.counts.data(), part_.displs.data(),
+                mpiTypeOf<T>(), 0, world_);
+  }
+
+ private:
+  // Columns [begin, end) that the rows of `proc` can have non-zeros in.
+  [[nodiscard]] std::pair<int, int> window(int proc) const {
+    return {std::max(0, part_.displs[proc] - band_), std::min(n_, part_.displs[proc] + part_.counts[proc] + band_)};
+  }
+
+  // True when no process holds both full iterates after a sweep.
+  [[nodiscard]] bool distributedTest() const { return neighbour_exchange_ || spmv_.has_value(); }
+
+  // Computes the own part of x_next_ from x_ and completes x_next_ as far as
+  // the next sweep needs it (nothing for a sparse matrix: the product fetches
+  // its ghosts). Returns max |x' - x| over the own rows.
+  T computeSweep() {
+    using Acc = ppc::core::kernels::DotAccumulatorT<T>;
+    if (spmv_) {
+      spmv_->multiply(x_.data() + first_row_, ax_.data());
+    } else {
+      ppc::core::kernels::dotMany(x_.data() + window_begin_, a_.data(), window_end_ - window_begin_, local_rows_,
+                                  ax_.data());
+    }
+    T change{};
+    for (int i = 0; i < local_rows_; i++) {
+      const T current = x_[first_row_ + i];
+      const T next = current + static_cast<T>((static_cast<Acc>(b_[i]) - ax_[i]) * inv_diagonal_[i]);
+      change = std::max(change, std::abs(next - current));
+      x_next_[first_row_ + i] = next;
+    }
+    if (spmv_) {
+      return change;
+    }
+    if (neighbour_exchange_) {
+      exchangeBoundaries();
+    } else {
+      MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, x_next_.data(), part_.counts.data(), part_.displs.data(),
+                     mpiTypeOf<T>(), world_);
+    }
+    return change;
+  }
+
+  // max |x' - x| over the whole vector, for the all-gather exchange.
+  [[nodiscard]] T maxChange() const {
+    T change{};
+    for (int i = 0; i < n_; i++) {
+      change = std::max(change, std::abs(x_next_[i] - x_[i]));
+    }
+    return change;
+  }
+
+  // Sends the first and last band_ own values of x_next_ to the previous and
+  // next rank and receives theirs just outside the own block.
+  void exchangeBoundaries() {
+    const int rank = world_.rank();
+    const int prev = rank > 0 ? rank - 1 : MPI_PROC_NULL;
+    const int next = rank + 1 < world_.size() ? rank + 1 : MPI_PROC_NULL;
+    T* own = x_next_.data() + first_row_;
+    MPI_Sendrecv(own, band_, mpiTypeOf<T>(), prev, 0, own + local_rows_, band_, mpiTypeOf<T>(), next, 0, world_,
+                 MPI_STATUS_IGNORE);
+    MPI_Sendrecv(own + local_rows_ - band_, band_, mpiTypeOf<T>(), next, 1, own - band_, band_, mpiTypeOf<T>(), prev, 1,
+                 world_, MPI_STATUS_IGNORE);
+  }
+
+  boost::mpi::communicator world_;
+  int n_;
+  int band_;
+  BlockPartition part_;
+  int first_row_{};
+  int local_rows_{};
+  int window_begin_{};
+  int window_end_{};
+  bool neighbour_exchange_{};
+  SolveStats stats_;
+  ppc::core::kernels::AlignedVector<T> a_;
+  std::optional<DistributedSpmv<T>> spmv_;
+  std::vector<T> b_;
+  std::vector<T> inv_diagonal_;
+  std::vector<ppc::core::kernels::DotAccumulatorT<T>> ax_;
+  std::vector<T> x_;
+  std::vector<T> x_next_;
+};
+
+}  // namespace ppc::mpi
@@ -0,0 +1,606 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/lu.hpp"
+#include "mpi/common/include/distributed_matrix.hpp"
+#include "mpi/common/include/matvec.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/common/include/process_grid.hpp"
+
+namespace ppc::mpi {
+
+// Distributed blocked right-looking LU with partial pivoting, P A = L U, of an
+// n x n matrix on a 2D process grid (MPI_Dims_create shape). Rows and columns
+// are dealt in blocks of `block` indices round-robin over the grid rows and
+// columns (2D block-cyclic, as ScaLAPACK), so the shrinking trailing matrix
+// stays spread over every process until the last few steps.
+//
+// Step k works on the block column k (the panel):
+//  1. the grid column owning it all-gathers the panel (one MPI_Allgatherv on
+//     the column communicator) and every member factorises it with
+//     luPanel(); each keeps its own rows of L;
+//  2. each member broadcasts its rows of L and the panel pivots along its grid
+//     row (MPI_Ibcast on the row communicator);
+//  3. the row swaps are applied to the other columns with one MPI_Alltoallv on
+//     each column communicator;
+//  4. the grid row owning block row k solves for its part of U and broadcasts
+//     it down the grid columns;
+//  5. every process updates its part of the trailing matrix with one GEMM.
+// That is O(n / block) collectives, each moving a whole block, instead of a
+// pivot search and a row broadcast per column. With look-ahead the grid column
+// owning panel k + 1 updates those columns first, factorises the panel and
+// starts its broadcast before the rest of its step-k update, so the panel
+// is on its way while every process is still busy with the GEMM.
+template <class T>
+class LuEngine {
+  static_assert(std::is_floating_point_v<T>);
+
+ public:
+  // Collective over `world`; n and block must be the same on every process.
+  LuEngine(const boost::mpi::communicator& world, int n, int block = static_cast<int>(ppc::core::kernels::kLuBlock))
+      : world_(world),
+        n_(n),
+        nb_(std::max(block, 1)),
+        grid_(std::make_shared<const ProcessGrid>(world)),
+        row_layout_(Layout1D::blockCyclic(n, grid_->rows(), nb_)),
+        col_layout_(Layout1D::blockCyclic(n, grid_->cols(), nb_)),
+        a_(grid_, row_layout_, col_layout_),
+        pivots_(n) {
+    for (int r = 0; r < grid_->rows(); r++) {
+      row_indices_.push_back(row_layout_.indicesOf(r));
+    }
+    my_cols_ = col_layout_.indicesOf(grid_->col());
+  }
+
+  // Rank 0 sends every process its part of the row-major n x n matrix `a`
+  // (ignored on other ranks). ||A||_1 is taken on the way, for
+  // conditionEstimate().
+  void distribute(const T* a) {
+    a_.scatter(a);
+    std::vector<double> sums(n_, 0.0);
+    for (int i = 0; i < a_.localRows(); i++) {
+      for (int j = 0; j < a_.localCols(); j++) sums[my_cols_[j]] += std::abs(static_cast<double>(a_(i, j)));
+    }
+    MPI_Allreduce(MPI_IN_PLACE, sums.data(), n_, MPI_DOUBLE, MPI_SUM, world_);
+    a_norm_ = sums.empty() ? 0.0 : *std::max_element(sums.begin(), sums.end());
+  }
+
+  // Factorises the distributed matrix in place. Returns false (on every
+  // process) if it is singular, i.e. a pivot is exactly zero.
+  bool factorise(bool lookahead = true) {
+    const int blocks = (n_ + nb_ - 1) / nb_;
+    bool regular = true;
+    next_started_ = false;
+    for (int k = 0; k < blocks; k++) {
+      if (!next_started_) {
+        if (grid_->col() == k % grid_->cols()) regular = factorPanel(k) && regular;
+        startPanelBroadcast(k);
+      }
+      finishPanelBroadcast();
+      std::copy(panel_pivots_.begin(), panel_pivots_.end(), pivots_.begin() + k * nb_);
+      applySwaps(k);
+      computeU(k);
+
+      const int begin = firstLocalCol((k + 1) * nb_);
+      if (lookahead && k + 1 < blocks && grid_->col() == (k + 1) % grid_->cols()) {
+        const int next_end = begin + blockWidth(k + 1);
+        update(k, begin, next_end);
+        regular = factorPanel(k + 1) && regular;
+        startPanelBroadcast(k + 1);
+        update(k, next_end, a_.localCols());
+      } else {
+        update(k, begin, a_.localCols());
+      }
+    }
+    regular_ = boost::mpi::all_reduce(world_, regular, std::logical_and<>());
+    return regular_;
+  }
+
+  // X = A^-1 B with the factors of factorise() for the n x nrhs row-major
+  // matrix B; B is needed on every process and X is returned on every
+  // process. Each block of the forward and the back substitution costs one
+  // reduction along a grid row and one broadcast whatever nrhs is, so a batch
+  // of right-hand sides pays the latency of a single one.
+  void solve(const T* b, T* x, int nrhs = 1) {
+    std::copy(b, b + static_cast<size_t>(n_) * nrhs, x);
+    ppc::core::kernels::swapRows(nrhs, x, nrhs, pivots_.data(), 0, n_);
+    const int blocks = (n_ + nb_ - 1) / nb_;
+    std::vector<T> partial(static_cast<size_t>(a_.localRows()) * nrhs, T{});
+    for (int k = 0; k < blocks; k++) {
+      solveBlock(k, partial, x, nrhs, false);
+    }
+    std::fill(partial.begin(), partial.end(), T{});
+    for (int k = blocks; k-- > 0;) {
+      solveBlock(k, partial, x, nrhs, true);
+    }
+  }
+
+  // Y = A^-T C (A^T Y = C) with the factors of factorise(), same conventions
+  // as solve(). A^T = U^T L^T P: the forward substitution runs over U^T and
+  // the back substitution over L^T, each block summing its contributions
+  // down a grid column.
+  void solveTransposed(const T* c, T* y, int nrhs = 1) {
+    std::copy(c, c + static_cast<size_t>(n_) * nrhs, y);
+    const int blocks = (n_ + nb_ - 1) / nb_;
+    std::vector<T> partial(static_cast<size_t>(a_.localCols()) * nrhs, T{});
+    for (int k = 0; k < blocks; k++) {
+      solveBlockTransposed(k, partial, y, nrhs, true);
+    }
+    std::fill(partial.begin(), partial.end(), T{});
+    for (int k = blocks; k-- > 0;) {
+      solveBlockTransposed(k, partial, y, nrhs, false);
+    }
+    for (int i = n_; i-- > 0;) {
+      std::swap_ranges(y + static_cast<size_t>(i) * nrhs, y + static_cast<size_t>(i + 1) * nrhs,
+                       y + static_cast<size_t>(pivots_[i]) * nrhs);
+    }
+  }
+
+  // det A from the factors of factorise(): every process multiplies the
+  // diagonal entries of U it holds and one reduction combines them.
+  [[nodiscard]] ppc::core::kernels::Determinant determinant() const {
+    std::array<double, 3> parts{};  // log |product|, negative entries, zero entries
+    const auto& rows = row_indices_[grid_->row()];
+    for (int i = 0; i < a_.localRows(); i++) {
+      if (col_layout_.owner(rows[i]) != grid_->col()) continue;
+      const auto value = static_cast<double>(a_(i, col_layout_.toLocal(rows[i])));
+      if (value == 0.0) {
+        parts[2]++;
+      } else {
+        parts[0] += std::log(std::abs(value));
+        parts[1] += value < 0.0 ? 1 : 0;
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, parts.data(), 3, MPI_DOUBLE, MPI_SUM, world_);
+    if (parts[2] > 0.0) return {};
+    auto negatives = static_cast<int>(parts[1]);
+    for (int i = 0; i < n_; i++) negatives += pivots_[i] != i ? 1 : 0;
+    return {negatives % 2 == 0 ? 1 : -1, parts[0]};
+  }
+
+  // Estimate of the 1-norm condition number ||A||_1 ||A^-1||_1 from the
+  // factors (ppc::core::kernels::estimateInverseNorm1(): at most 11 solves,
+  // O(n^2) each); infinite for a singular A. Collective.
+  [[nodiscard]] double conditionEstimate() {
+    if (!regular_) return std::numeric_limits<double>::infinity();
+    std::vector<T> rhs(n_);
+    const auto solve_with = [&](T* v, bool transposed) {
+      std::copy(v, v + n_, rhs.begin());
+      if (transposed) {
+        solveTransposed(rhs.data(), v);
+      } else {
+        solve(rhs.data(), v);
+      }
+    };
+    return a_norm_ * ppc::core::kernels::estimateInverseNorm1<T>(
+                         n_, [&](T* v) { solve_with(v, false); }, [&](T* v) { solve_with(v, true); });
+  }
+
+  // Global row swapped with row i during the factorisation, on every process.
+  [[nodiscard]] const std::vector<int>& pivots() const { return pivots_; }
+  // Result of the last factorise().
+  [[nodiscard]] bool regular() const { return regular_; }
+  // L (below the diagonal) and U after factorise().
+  [[nodiscard]] const DistributedMatrix<T>& factors() const { return a_; }
+  [[nodiscard]] const ProcessGrid& grid() const { return *grid_; }
+  [[nodiscard]] int size() const { return n_; }
+  [[nodiscard]] int blockSize() const { return nb_; }
+
+ private:
+  [[nodiscard]] int blockWidth(int k) const { return std::min(nb_, n_ - k * nb_); }
+
+  // Number of rows of grid row r (of columns of this process) with a global
+  // index below `global`: the local index of the first one at or after it.
+  [[nodiscard]] int firstLocalRow(int r, int global) const {
+    const auto& rows = row_indices_[r];
+    return static_cast<int>(std::lower_bound(rows.begin(), rows.end(), global) - rows.begin());
+  }
+  [[nodiscard]] int firstLocalCol(int global) const {
+    return static_cast<int>(std::lower_bound(my_cols_.begin(), my_cols_.end(), global) - my_cols_.begin());
+  }
+
+  // On the grid column owning panel k: gathers the panel, factorises it and
+  // leaves the own rows of the result both in the matrix and in next_l_, and
+  // the pivots (global rows) in next_pivots_.
+  bool factorPanel(int k) {
+    const int k0 = k * nb_;
+    const int kb = blockWidth(k);
+    const int col = col_layout_.toLocal(k0);
+    const int me = grid_->row();
+    std::vector<int> counts(grid_->rows());
+    std::vector<int> displs(grid_->rows());
+    int total = 0;
+    for (int r = 0; r < grid_->rows(); r++) {
+      counts[r] = (static_cast<int>(row_indices_[r].size()) - firstLocalRow(r, k0)) * kb;
+      displs[r] = total;
+      total += counts[r];
+    }
+    const int first = firstLocalRow(me, k0);
+    const int own = static_cast<int>(row_indices_[me].size()) - first;
+    next_l_.resize(static_cast<size_t>(own) * kb);
+    for (int i = 0; i < own; i++) {
+      std::copy(a_.row(first + i) + col, a_.row(first + i) + col + kb, next_l_.data() + static_cast<size_t>(i) * kb);
+    }
+    std::vector<T> gathered(total);
+    MPI_Allgatherv(next_l_.data(), own * kb, mpiTypeOf<T>(), gathered.data(), counts.data(), displs.data(),
+                   mpiTypeOf<T>(), grid_->col_comm());
+
+    std::vector<T> panel(static_cast<size_t>(n_ - k0) * kb);
+    for (int r = 0; r < grid_->rows(); r++) {
+      const int first_r = firstLocalRow(r, k0);
+      for (int i = first_r; i < static_cast<int>(row_indices_[r].size()); i++) {
+        const T* source = gathered.data() + displs[r] + static_cast<size_t>(i - first_r) * kb;
+        std::copy(source, source + kb, panel.data() + static_cast<size_t>(row_indices_[r][i] - k0) * kb);
+      }
+    }
+    next_pivots_.resize(kb);
+    const bool regular = ppc::core::kernels::luPanel(n_ - k0, kb, panel.data(), kb, next_pivots_.data());
+    for (auto& pivot : next_pivots_) pivot += k0;
+
+    for (int i = 0; i < own; i++) {
+      const T* source = panel.data() + static_cast<size_t>(row_indices_[me][first + i] - k0) * kb;
+      std::copy(source, source + kb, next_l_.data() + static_cast<size_t>(i) * kb);
+      std::copy(source, source + kb, a_.row(first + i) + col);
+    }
+    return regular;
+  }
+
+  // Broadcasts the rows of L of panel k (next_l_) and its pivots along every
+  // grid row from the grid column owning it.
+  void startPanelBroadcast(int k) {
+    const int k0 = k * nb_;
+    const int kb = blockWidth(k);
+    const int own = static_cast<int>(row_indices_[grid_->row()].size()) - firstLocalRow(grid_->row(), k0);
+    const int root = k % grid_->cols();
+    next_l_.resize(static_cast<size_t>(own) * kb);
+    next_pivots_.resize(kb);
+    MPI_Ibcast(next_l_.data(), own * kb, mpiTypeOf<T>(), root, grid_->row_comm(), &next_requests_[0]);
+    MPI_Ibcast(next_pivots_.data(), kb, MPI_INT, root, grid_->row_comm(), &next_requests_[1]);
+    next_started_ = true;
+  }
+
+  void finishPanelBroadcast() {
+    MPI_Waitall(2, next_requests_.data(), MPI_STATUSES_IGNORE);
+    std::swap(panel_l_, next_l_);
+    std::swap(panel_pivots_, next_pivots_);
+    next_started_ = false;
+  }
+
+  // Applies the swaps of panel k to every local column outside the panel. The
+  // swaps are composed into one permutation of the rows they touch first, so
+  // each moved row travels once, in one MPI_Alltoallv per grid column.
+  void applySwaps(int k) {
+    const int k0 = k * nb_;
+    const int kb = blockWidth(k);
+    std::map<int, int> source;  // row position -> row that ends up there
+    const auto at = [&](int position) -> int& { return source.try_emplace(position, position).first->second; };
+    for (int j = 0; j < kb; j++) {
+      std::swap(at(k0 + j), at(panel_pivots_[j]));
+    }
+    const int me = grid_->row();
+    std::vector<std::vector<int>> sends(grid_->rows());  // local rows to send, per grid row
+    std::vector<std::vector<int>> recvs(grid_->rows());  // local rows to fill, per grid row
+    bool moves = false;
+    for (const auto& [position, row] : source) {
+      if (position == row) continue;
+      moves = true;
+      const int to = row_layout_.owner(position);
+      const int from = row_layout_.owner(row);
+      if (from == me) sends[to].push_back(row_layout_.toLocal(row));
+      if (to == me) recvs[from].push_back(row_layout_.toLocal(position));
+    }
+    const int ld = a_.localCols();
+    const bool panel_here = grid_->col() == k % grid_->cols();
+    const int skip_begin = panel_here ? col_layout_.toLocal(k0) : ld;
+    const int skip_end = panel_here ? skip_begin + kb : ld;
+    const int width = ld - (skip_end - skip_begin);
+    if (!moves || width == 0) return;
+
+    const auto counts = [&](const std::vector<std::vector<int>>& rows, std::vector<int>& count,
+                            std::vector<int>& displ) {
+      int total = 0;
+      for (size_t r = 0; r < rows.size(); r++) {
+        count[r] = static_cast<int>(rows[r].size()) * width;
+        displ[r] = total;
+        total += count[r];
+      }
+      return total;
+    };
+    std::vector<int> send_counts(grid_->rows());
+    std::vector<int> send_displs(grid_->rows());
+    std::vector<int> recv_counts(grid_->rows());
+    std::vector<int> recv_displs(grid_->rows());
+    std::vector<T> send(counts(sends, send_counts, send_displs));
+    std::vector<T> recv(counts(recvs, recv_counts, recv_displs));
+    T* out = send.data();
+    for (const auto& rows : sends) {
+      for (const int row : rows) {
+        out = std::copy(a_.row(row), a_.row(row) + skip_begin, out);
+        out = std::copy(a_.row(row) + skip_end, a_.row(row) + ld, out);
+      }
+    }
+    MPI_Alltoallv(send.data(), send_counts.data(), send_displs.data(), mpiTypeOf<T>(), recv.data(),
+                  recv_counts.data(), recv_displs.data(), mpiTypeOf<T>(), grid_->col_comm());
+    const T* in = recv.data();
+    for (const auto& rows : recvs) {
+      for (const int row : rows) {
+        std::copy(in, in + skip_begin, a_.row(row));
+        std::copy(in + skip_begin, in + width, a_.row(row) + skip_end);
+        in += width;
+      }
+    }
+  }
+
+  // Block row k of U right of the panel: L11^-1 A12 on the grid row owning it,
+  // then broadcast down every grid column into u_panel_.
+  void computeU(int k) {
+    const int k0 = k * nb_;
+    const int kb = blockWidth(k);
+    const int ld = a_.localCols();
+    const int begin = firstLocalCol(k0 + kb);
+    const int width = ld - begin;
+    const int owner = k % grid_->rows();
+    u_panel_.resize(static_cast<size_t>(kb) * width);
+    if (width == 0) return;
+    if (grid_->row() == owner) {
+      T* a12 = a_.row(row_layout_.toLocal(k0)) + begin;
+      // Block row k comes first among the own rows of panel k.
+      ppc::core::kernels::solveLowerUnit(kb, width, panel_l_.data(), kb, a12, ld);
+      for (int i = 0; i < kb; i++) {
+        std::copy(a12 + static_cast<size_t>(i) * ld, a12 + static_cast<size_t>(i) * ld + width,
+                  u_panel_.data() + static_cast<size_t>(i) * width);
+      }
+    }
+    MPI_Bcast(u_panel_.data(), kb * width, mpiTypeOf<T>(), owner, grid_->col_comm());
+  }
+
+  // A22 -= L21 * U12 on the local columns [col_begin, col_end).
+  void update(int k, int col_begin, int col_end) {
+    const int k0 = k * nb_;
+    const int kb = blockWidth(k);
+    const int ld = a_.localCols();
+    const int trailing = firstLocalCol(k0 + kb);
+    const int first = firstLocalRow(grid_->row(), k0 + kb);
+    const int offset = first - firstLocalRow(grid_->row(), k0);
+    ppc::core::kernels::gemmSubtract<T>(a_.localRows() - first, col_end - col_begin, kb,
+                                        panel_l_.data() + static_cast<size_t>(offset) * kb, kb,
+                                        u_panel_.data() + (col_begin - trailing), ld - trailing,
+                                        a_.row(first) + col_begin, ld);
+  }
+
+  // One block of the forward (L, in block order) or back (U, in reverse block
+  // order) substitution for the nrhs columns of x. `partial` holds, per local
+  // row, the contributions of the solved blocks in this process's columns;
+  // they are summed along the grid row owning block k, the diagonal block is
+  // solved and the result broadcast.
+  void solveBlock(int k, std::vector<T>& partial, T* x, int nrhs, bool upper) {
+    const int k0 = k * nb_;
+    const int kb = blockWidth(k);
+    const int owner_row = k % grid_->rows();
+    const int owner_col = k % grid_->cols();
+    const bool diagonal_here = grid_->row() == owner_row && grid_->col() == owner_col;
+    T* x_block = x + static_cast<size_t>(k0) * nrhs;
+    if (grid_->row() == owner_row) {
+      T* sums = partial.data() + static_cast<size_t>(row_layout_.toLocal(k0)) * nrhs;
+      MPI_Reduce(diagonal_here ? MPI_IN_PLACE : sums, sums, kb * nrhs, mpiTypeOf<T>(), MPI_SUM, owner_col,
+                 grid_->row_comm());
+      if (diagonal_here) {
+        for (int j = 0; j < kb * nrhs; j++) x_block[j] -= sums[j];
+        const T* block = a_.row(row_layout_.toLocal(k0)) + col_layout_.toLocal(k0);
+        if (upper) {
+          ppc::core::kernels::solveUpper(kb, nrhs, block, a_.localCols(), x_block, nrhs);
+        } else {
+          ppc::core::kernels::solveLowerUnit(kb, nrhs, block, a_.localCols(), x_block, nrhs);
+        }
+      }
+    }
+    MPI_Bcast(x_block, kb * nrhs, mpiTypeOf<T>(), grid_->rankOf(owner_row, owner_col), grid_->cart());
+    if (grid_->col() != owner_col) return;
+    const int begin = upper ? 0 : firstLocalRow(grid_->row(), k0 + kb);
+    const int end = upper ? firstLocalRow(grid_->row(), k0) : a_.localRows();
+    if (begin >= end) return;
+    ppc::core::kernels::gemm(end - begin, nrhs, kb, a_.row(begin) + col_layout_.toLocal(k0), a_.localCols(), x_block,
+                             nrhs, partial.data() + static_cast<size_t>(begin) * nrhs, nrhs);
+  }
+
+  // solveBlock() for A^T: block k of the forward (U^T, upper = true) or back
+  // (L^T) substitution. `partial` holds, per local column, the contributions
+  // of the solved blocks in this process's rows, summed down the grid column
+  // owning block k.
+  void solveBlockTransposed(int k, std::vector<T>& partial, T* y, int nrhs, bool upper) {
+    const int k0 = k * nb_;
+    const int kb = blockWidth(k);
+    const int owner_row = k % grid_->rows();
+    const int owner_col = k % grid_->cols();
+    const bool diagonal_here = grid_->row() == owner_row && grid_->col() == owner_col;
+    T* y_block = y + static_cast<size_t>(k0) * nrhs;
+    if (grid_->col() == owner_col) {
+      T* sums = partial.data() + static_cast<size_t>(col_layout_.toLocal(k0)) * nrhs;
+      MPI_Reduce(diagonal_here ? MPI_IN_PLACE : sums, sums, kb * nrhs, mpiTypeOf<T>(), MPI_SUM, owner_row,
+                 grid_->col_comm());
+      if (diagonal_here) {
+        for (int j = 0; j < kb * nrhs; j++) y_block[j] -= sums[j];
+        const T* block = a_.row(row_layout_.toLocal(k0)) + col_layout_.toLocal(k0);
+        if (upper) {
+          ppc::core::kernels::solveUpperTransposed(kb, nrhs, block, a_.localCols(), y_block, nrhs);
+        } else {
+          ppc::core::kernels::solveLowerUnitTransposed(kb, nrhs, block, a_.localCols(), y_block, nrhs);
+        }
+      }
+    }
+    MPI_Bcast(y_block, kb * nrhs, mpiTypeOf<T>(), grid_->rankOf(owner_row, owner_col), grid_->cart());
+    if (grid_->row() != owner_row) return;
+    const int first_row = row_layout_.toLocal(k0);
+    const int begin = upper ? firstLocalCol(k0 + kb) : 0;
+    const int end = upper ? a_.localCols() : firstLocalCol(k0);
+    for (int i = 0; i < kb; i++) {
+      const T* row = a_.row(first_row + i);
+      const T* y_i = y_block + static_cast<size_t>(i) * nrhs;
+      for (int col = begin; col < end; col++) {
+        T* sum = partial.data() + static_cast<size_t>(col) * nrhs;
+        for (int r = 0; r < nrhs; r++) sum[r] += row[col] * y_i[r];
+      }
+    }
+  }
+
+  boost::mpi::communicator world_;
+  int n_;
+  int nb_;
+  std::shared_ptr<const ProcessGrid> grid_;
+  Layout1D row_layout_;
+  Layout1D col_layout_;
+  DistributedMatrix<T> a_;
+  std::vector<int> pivots_;
+  bool regular_{};
+  double a_norm_{};  // ||A||_1
+  std::vector<std::vector<int>> row_indices_;  // global rows of every grid row
+  std::vector<int> my_cols_;
+  // L rows and pivots of the current panel, and of the one being broadcast.
+  std::vector<T> panel_l_;
+  std::vector<int> panel_pivots_;
+  std::vector<T> next_l_;
+  std::vector<int> next_pivots_;
+  std::array<MPI_Request, 2> next_requests_{MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+  bool next_started_{};
+  std::vector<T> u_panel_;
+};
+
+// Keeps the factors of the last `capacity` matrices factorised through it, so
+// a stream of solves against the same A pays for the O(n^3) factorisation
+// once. Entries are keyed by n, the block size and a fingerprint of A
+// computed on rank 0 and broadcast, so every process takes the same hit/miss
+// decision. One cache serves one communicator.
+template <class T>
+class LuEngineCache {
+ public:
+  explicit LuEngineCache(std::size_t capacity = 4) : capacity_(std::max<std::size_t>(capacity, 1)) {}
+
+  // Collective over `world`. Rank 0 passes the row-major n x n matrix `a`
+  // (ignored on other ranks). Returns the engine holding the factors of A,
+  // distributing and factorising it first on a miss; regular() tells whether
+  // A is singular.
+  std::shared_ptr<LuEngine<T>> factorise(const boost::mpi::communicator& world, int n, const T* a,
+                                         int block = static_cast<int>(ppc::core::kernels::kLuBlock),
+                                         bool lookahead = true) {
+    std::uint64_t key = 0;
+    if (world.rank() == 0) {
+      key = ppc::core::kernels::fingerprint(a, static_cast<size_t>(n) * n);
+    }
+    boost::mpi::broadcast(world, key, 0);
+    const auto hit = std::find_if(entries_.begin(), entries_.end(), [&](const Entry& entry) {
+      return entry.key == key && entry.engine->size() == n && entry.engine->blockSize() == block;
+    });
+    if (hit != entries_.end()) {
+      hits_++;
+      std::rotate(entries_.begin(), hit, hit + 1);
+      return entries_.front().engine;
+    }
+    misses_++;
+    auto engine = std::make_shared<LuEngine<T>>(world, n, block);
+    engine->distribute(a);
+    engine->factorise(lookahead);
+    if (entries_.size() == capacity_) entries_.pop_back();
+    entries_.insert(entries_.begin(), Entry{key, engine});
+    return engine;
+  }
+
+  [[nodiscard]] std::size_t hits() const { return hits_; }
+  [[nodiscard]] std::size_t misses() const { return misses_; }
+  [[nodiscard]] std::size_t size() const { return entries_.size(); }
+  void clear() { entries_.clear(); }
+
+ private:
+  struct Entry {
+    std::uint64_t key;
+    std::shared_ptr<LuEngine<T>> engine;
+  };
+
+  std::size_t capacity_;
+  std::vector<Entry> entries_;  // most recently used first
+  std::size_t hits_{};
+  std::size_t misses_{};
+};
+
+// Distributed ppc::core::kernels::luSolveMixed(): A is factorised in Low by a
+// LuEngine<Low> and the residuals of the refinement are formed in T by a
+// MatvecEngine<T> holding A in 2D blocks, one product and one allgather per
+// right-hand side. Falls back to a LuEngine<T> when the refinement does not
+// converge. Collective over `world`; rank 0 passes the row-major n x n matrix
+// `a` (ignored elsewhere), every process passes B and gets X (n x nrhs).
+// Returns false (on every process) only if A is singular in T.
+template <class Low, class T>
+bool luSolveMixed(const boost::mpi::communicator& world, int n, const T* a, const T* b, T* x, int nrhs,
+                  ppc::core::kernels::RefinementResult& result, const ppc::core::kernels::RefinementParams& params = {},
+                  int block = static_cast<int>(ppc::core::kernels::kLuBlock), bool lookahead = true) {
+  const auto count = static_cast<size_t>(n) * nrhs;
+  double a_norm = 0.0;
+  LuEngine<Low> engine(world, n, block);
+  {
+    std::vector<Low> low;
+    if (world.rank() == 0) {
+      a_norm = ppc::core::kernels::infinityNorm(n, n, a, n);
+      low.assign(a, a + static_cast<size_t>(n) * n);
+    }
+    boost::mpi::broadcast(world, a_norm, 0);
+    engine.distribute(low.data());
+  }
+  MatvecEngine<T> product(world, MatvecScheme::Block2D, n, n);
+  product.distributeMatrix(a);
+
+  std::vector<Low> low_b(count);
+  std::vector<Low> low_x(count);
+  const auto solve_low = [&](T* v) {
+    std::copy(v, v + count, low_b.begin());
+    engine.solve(low_b.data(), low_x.data(), nrhs);
+    std::copy(low_x.begin(), low_x.end(), v);
+  };
+  std::vector<T> column(n);
+  std::vector<T> product_column(n);
+  const auto residual = [&](const T* xs, T* r) {
+    for (int c = 0; c < nrhs; c++) {
+      for (int i = 0; i < n; i++) column[i] = xs[static_cast<size_t>(i) * nrhs + c];
+      product.multiplyReplicated(column.data());
+      product.allgather(product_column.data());
+      for (int i = 0; i < n; i++) {
+        const auto at = static_cast<size_t>(i) * nrhs + c;
+        r[at] = b[at] - product_column[i];
+      }
+    }
+  };
+
+  result = {};
+  if (engine.factorise(lookahead)) {
+    std::copy(b, b + count, x);
+    solve_low(x);
+    result = ppc::core::kernels::refineSolution(n, nrhs, a_norm, x, residual, solve_low, params);
+    if (result.converged) return true;
+  }
+  result.fell_back = true;
+  LuEngine<T> full(world, n, block);
+  full.distribute(a);
+  if (!full.factorise(lookahead)) return false;
+  full.solve(b, x, nrhs);
+  std::vector<T> r(count);
+  residual(x, r.data());
+  result.residual = ppc::core::kernels::backwardError(n, nrhs, a_norm, x, r.data());
+  return true;
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,149 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/kernels/include/dot_product.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/distributed_matrix.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/common/include/process_grid.hpp"
+
+namespace ppc::mpi {
+
+// How the m x n matrix of a distributed y = A * x is split between processes.
+//  RowRibbon    - blocks of rows; every process needs the whole x.
+//  ColumnRibbon - blocks of columns; every process needs one block of x and
+//                 produces a partial y of full length.
+//  Block2D      - r x c grid of tiles (MPI_Dims_create); a process needs one
+//                 block of x and produces a partial block of y.
+enum class MatvecScheme { RowRibbon, ColumnRibbon, Block2D };
+
+// Distributed matrix-vector product. All three schemes are the same algorithm
+// on differently shaped process grids (p x 1, 1 x p and r x c): the process at
+// (i, j) holds tile (i, j) of A and block j of x, computes tile * x block and
+// the partial results of a grid row are summed with one MPI_Reduce_scatter on
+// the row communicator. After multiply() every process owns one segment of y:
+// segment j of rows block i. The matrix is distributed once and reused by every
+// multiply(), as iterative solvers need.
+template <class T>
+class MatvecEngine {
+ public:
+  // Collective over `world`; m and n must be the same on every process.
+  MatvecEngine(const boost::mpi::communicator& world, MatvecScheme scheme, int m, int n)
+      : world_(world),
+        m_(m),
+        n_(n),
+        grid_(makeGrid(world, scheme)),
+        matrix_(grid_, Layout1D::block(m, grid_->rows()), Layout1D::block(n, grid_->cols())) {
+    rows_part_ = BlockPartition(m, grid_->rows());
+    cols_part_ = BlockPartition(n, grid_->cols());
+    segment_part_ = BlockPartition(rows_part_.counts[grid_->row()], grid_->cols());
+
+    // Segment of y owned by every world rank, for the final gather.
+    y_counts_.resize(world.size());
+    y_displs_.resize(world.size());
+    for (int proc = 0; proc < world.size(); proc++) {
+      const auto [r, c] = grid_->coordsOf(proc);
+      const BlockPartition segments(rows_part_.counts[r], grid_->cols());
+      y_counts_[proc] = segments.counts[c];
+      y_displs_[proc] = rows_part_.displs[r] + segments.displs[c];
+    }
+  }
+
+  // Sends every process its tile of the row-major m x n matrix held by rank 0
+  // (vector datatypes, no repacking on the root). `a` is ignored on other ranks.
+  void distributeMatrix(const T* a) { matrix_.scatter(a); }
+
+  // Collective alternative to distributeMatrix(): every process reads its tile
+  // of the m x n matrix from a binary file with MPI-IO.
+  bool readMatrix(const std::string& path) { return matrix_.readFile(path); }
+
+  // y = A * x for x held by rank 0 (ignored on other ranks). Block j of x is
+  // scattered along grid row 0 and broadcast down the grid columns.
+  void multiply(const T* x) {
+    x_block_.resize(cols_part_.counts[grid_->col()]);
+    if (grid_->row() == 0) {
+      MPI_Scatterv(x, cols_part_.counts.data(), cols_part_.displs.data(), mpiTypeOf<T>(), x_block_.data(),
+                   static_cast<int>(x_block_.size()), mpiTypeOf<T>(), 0, grid_->row_comm());
+    }
+    MPI_Bcast(x_block_.data(), static_cast<int>(x_block_.size()), mpiTypeOf<T>(), 0, grid_->col_comm());
+    multiplyLocal(x_block_.data());
+  }
+
+  // y = A * x where every process already holds the whole x (e.g. the previous
+  // iterate gathered with allgather()); nothing is sent before the reduction.
+  void multiplyReplicated(const T* x) { multiplyLocal(x + cols_part_.displs[grid_->col()]); }
+
+  // Segment of y owned by this process after multiply().
+  [[nodiscard]] const std::vector<T>& segment() const { return y_segment_; }
+  [[nodiscard]] int segmentOffset() const { return y_displs_[world_.rank()]; }
+
+  // Collects y on rank 0 (`y` ignored on other ranks).
+  void gather(T* y) const {
+    MPI_Gatherv(y_segment_.data(), static_cast<int>(y_segment_.size()), mpiTypeOf<T>(), y, y_counts_.data(),
+                y_displs_.data(), mpiTypeOf<T>(), 0, world_);
+  }
+
+  // Collects y on every process with one MPI_Allgatherv.
+  void allgather(T* y) const {
+    MPI_Allgatherv(y_segment_.data(), static_cast<int>(y_segment_.size()), mpiTypeOf<T>(), y, y_counts_.data(),
+                   y_displs_.data(), mpiTypeOf<T>(), world_);
+  }
+
+  [[nodiscard]] int rows() const { return m_; }
+  [[nodiscard]] int cols() const { return n_; }
+
+ private:
+  static std::shared_ptr<const ProcessGrid> makeGrid(const boost::mpi::communicator& world, MatvecScheme scheme) {
+    if (scheme == MatvecScheme::RowRibbon) {
+      return std::make_shared<const ProcessGrid>(world, std::array<int, 2>{world.size(), 1}, false);
+    }
+    if (scheme == MatvecScheme::ColumnRibbon) {
+      return std::make_shared<const ProcessGrid>(world, std::array<int, 2>{1, world.size()}, false);
+    }
+    return std::make_shared<const ProcessGrid>(world);
+  }
+
+  void multiplyLocal(const T* x_block) {
+    const int local_m = rows_part_.counts[grid_->row()];
+    const int local_n = cols_part_.counts[grid_->col()];
+    partial_.resize(local_m);
+    ppc::core::kernels::dotMany(x_block, matrix_.data(), local_n, local_m, partial_.data());
+    partial_y_.resize(local_m);
+    std::transform(partial_.begin(), partial_.end(), partial_y_.begin(),
+                   [](ppc::core::kernels::DotAccumulatorT<T> value) { return static_cast<T>(value); });
+
+    y_segment_.resize(segment_part_.counts[grid_->col()]);
+    if (grid_->cols() == 1) {
+      y_segment_ = partial_y_;
+      return;
+    }
+    MPI_Reduce_scatter(partial_y_.data(), y_segment_.data(), segment_part_.counts.data(), mpiTypeOf<T>(), MPI_SUM,
+                       grid_->row_comm());
+  }
+
+  boost::mpi::communicator world_;
+  int m_;
+  int n_;
+  std::shared_ptr<const ProcessGrid> grid_;
+  DistributedMatrix<T> matrix_;
+  BlockPartition rows_part_{0, 1};
+  BlockPartition cols_part_{0, 1};
+  BlockPartition segment_part_{0, 1};
+  std::vector<int> y_counts_;
+  std::vector<int> y_displs_;
+  std::vector<T> x_block_;
+  std::vector<ppc::core::kernels::DotAccumulatorT<T>> partial_;
+  std::vector<T> partial_y_;
+  std::vector<T> y_segment_;
+};
+
+}  // namespace ppc::mpi
@@ -0,0 +1,159 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <array>
+#include <boost/mpi/communicator.hpp>
+#include <vector>
+
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+
+namespace ppc::mpi {
+
+// Processes of `world` arranged in a rows x cols Cartesian grid, with one
+// communicator per grid row and per grid column. Ranks are not reordered, so
+// world rank 0 sits at (0, 0) and stays the root that owns the full matrices.
+// When the grid is smaller than `world` (e.g. a square grid for a process count
+// that is not a square) the ranks past rows * cols are not members and must not
+// use the accessors below.
+class ProcessGrid {
+ public:
+  // Grid shape chosen by MPI_Dims_create (as square as the process count allows).
+  explicit ProcessGrid(const boost::mpi::communicator& world, bool periodic = false)
+      : ProcessGrid(world, dimsFor(world.size()), periodic) {}
+
+  ProcessGrid(const boost::mpi::communicator& world, std::array<int, 2> dims, bool periodic) : dims_(dims) {
+    const std::array<int, 2> periods = {periodic ? 1 : 0, periodic ? 1 : 0};
+    MPI_Cart_create(world, 2, dims_.data(), periods.data(), 0, &cart_);
+    if (cart_ == MPI_COMM_NULL) {
+      return;
+    }
+    int rank = 0;
+    MPI_Comm_rank(cart_, &rank);
+    MPI_Cart_coords(cart_, rank, 2, coords_.data());
+    const std::array<int, 2> keep_col = {0, 1};
+    const std::array<int, 2> keep_row = {1, 0};
+    MPI_Cart_sub(cart_, keep_col.data(), &row_comm_);
+    MPI_Cart_sub(cart_, keep_row.data(), &col_comm_);
+  }
+
+  ProcessGrid(const ProcessGrid&) = delete;
+  ProcessGrid& operator=(const ProcessGrid&) = delete;
+
+  ~ProcessGrid() {
+    if (cart_ != MPI_COMM_NULL) {
+      MPI_Comm_free(&col_comm_);
+      MPI_Comm_free(&row_comm_);
+      MPI_Comm_free(&cart_);
+    }
+  }
+
+  [[nodiscard]] bool member() const { return cart_ != MPI_COMM_NULL; }
+
+  [[nodiscard]] int rows() const { return dims_[0]; }
+  [[nodiscard]] int cols() const { return dims_[1]; }
+  [[nodiscard]] int row() const { return coords_[0]; }
+  [[nodiscard]] int col() const { return coords_[1]; }
+  [[nodiscard]] MPI_Comm cart() const { return cart_; }
+  // Processes of this grid row, ranked by their column; and the other way round.
+  [[nodiscard]] MPI_Comm row_comm() const { return row_comm_; }
+  [[nodiscard]] MPI_Comm col_comm() const { return col_comm_; }
+
+  [[nodiscard]] std::array<int, 2> coordsOf(int rank) const {
+    std::array<int, 2> coords{};
+    MPI_Cart_coords(cart_, rank, 2, coords.data());
+    return coords;
+  }
+
+  // Rank in cart() of the process at (row, col).
+  [[nodiscard]] int rankOf(int row, int col) const {
+    const std::array<int, 2> coords = {row, col};
+    int rank = 0;
+    MPI_Cart_rank(cart_, coords.data(), &rank);
+    return rank;
+  }
+
+  [[nodiscard]] int size() const { return dims_[0] * dims_[1]; }
+
+ private:
+  static std::array<int, 2> dimsFor(int size) {
+    std::array<int, 2> dims = {0, 0};
+    MPI_Dims_create(size, 2, dims.data());
+    return dims;
+  }
+
+  std::array<int, 2> dims_;
+  std::array<int, 2> coords_{};
+  MPI_Comm cart_ = MPI_COMM_NULL;
+  MPI_Comm row_comm_ = MPI_COMM_NULL;
+  MPI_Comm col_comm_ = MPI_COMM_NULL;
+};
+
+// Rank 0 sends every process the tile (rows_part block of its grid row) x
+// (cols_part block of its grid column) of the row-major matrix with `ld` columns.
+// The tile is described by a vector datatype and sent straight from the matrix;
+// it arrives as a compact row-major tile.
+template <class T>
+void scatterTiles(const ProcessGrid& grid, const T* matrix, int ld, const BlockPartition& rows_part,
+                  const BlockPartition& cols_part, std::vector<T>& tile) {
+  tile.resize(static_cast<size_t>(rows_part.counts[grid.row()]) * cols_part.counts[grid.col()]);
+  std::vector<MPI_Request> requests;
+  std::vector<MPI_Datatype> tile_types;
+  int rank = 0;
+  MPI_Comm_rank(grid.cart(), &rank);
+  if (rank == 0) {
+    for (int proc = 0; proc < grid.size(); proc++) {
+      const auto [r, c] = grid.coordsOf(proc);
+      if (rows_part.counts[r] == 0 || cols_part.counts[c] == 0) continue;
+      MPI_Datatype tile_type;
+      MPI_Type_vector(rows_part.counts[r], cols_part.counts[c], ld, mpiTypeOf<T>(), &tile_type);
+      MPI_Type_commit(&tile_type);
+      tile_types.push_back(tile_type);
+      requests.emplace_back();
+      MPI_Isend(matrix + static_cast<size_t>(rows_part.displs[r]) * ld + cols_part.displs[c], 1, tile_type, proc, 0,
+                grid.cart(), &requests.back());
+    }
+  }
+  if (!tile.empty()) {
+    MPI_Recv(tile.data(), static_cast<int>(tile.size()), mpiTypeOf<T>(), 0, 0, grid.cart(),
+             MPI_STATUS_IGNORE);
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+  for (auto& tile_type : tile_types) {
+    MPI_Type_free(&tile_type);
+  }
+}
+
+// Inverse of scatterTiles: rank 0 receives every tile in place into `matrix`.
+template <class T>
+void gatherTiles(const ProcessGrid& grid, const std::vector<T>& tile, T* matrix, int ld,
+                 const BlockPartition& rows_part, const BlockPartition& cols_part) {
+  std::vector<MPI_Request> requests;
+  std::vector<MPI_Datatype> tile_types;
+  int rank = 0;
+  MPI_Comm_rank(grid.cart(), &rank);
+  if (rank == 0) {
+    for (int proc = 0; proc < grid.size(); proc++) {
+      const auto [r, c] = grid.coordsOf(proc);
+      if (rows_part.counts[r] == 0 || cols_part.counts[c] == 0) continue;
+      MPI_Datatype tile_type;
+      MPI_Type_vector(rows_part.counts[r], cols_part.counts[c], ld, mpiTypeOf<T>(), &tile_type);
+      MPI_Type_commit(&tile_type);
+      tile_types.push_back(tile_type);
+      requests.emplace_back();
+      MPI_Irecv(matrix + static_cast<size_t>(rows_part.displs[r]) * ld + cols_part.displs[c], 1, tile_type, proc, 1,
+                grid.cart(), &requests.back());
+    }
+  }
+  if (!tile.empty()) {
+    MPI_Send(tile.data(), static_cast<int>(tile.size()), mpiTypeOf<T>(), 0, 1, grid.cart());
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+  for (auto& tile_type : tile_types) {
+    MPI_Type_free(&tile_type);
+  }
+}
+
+}  // namespace ppc::mpi
@@ -0,0 +1,85 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/kernels/include/reduce.hpp"
+#include "core/kernels/include/scan.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+
+namespace ppc::mpi {
+
+// Distributed scans over a sequence that is split into consecutive blocks, one
+// block per rank in rank order. Every rank sums its block, a single MPI_Exscan
+// turns the block sums into the offset of every block, and the block is then
+// scanned locally starting from that offset. Only one value per rank goes over
+// the network. All functions are collective.
+
+// Sum of all blocks on lower ranks (zero on rank 0).
+template <class Out>
+Out exscanOffset(const boost::mpi::communicator& world, Out local_total) {
+  Out offset{};
+  MPI_Exscan(&local_total, &offset, 1, mpiTypeOf<Out>(), MPI_SUM, world);
+  // The receive buffer of rank 0 is undefined after MPI_Exscan.
+  return world.rank() == 0 ? Out{} : offset;
+}
+
+template <class T, class Out>
+void inclusiveScan(const boost::mpi::communicator& world, const T* local, std::size_t n, Out* out) {
+  const Out local_total = ppc::core::kernels::foldLanes<Out>(local, n, Out{}, [](Out a, Out b) { return a + b; });
+  ppc::core::kernels::inclusiveScan(local, n, out, exscanOffset(world, local_total));
+}
+
+template <class T, class Out>
+void exclusiveScan(const boost::mpi::communicator& world, const T* local, std::size_t n, Out* out) {
+  const Out local_total = ppc::core::kernels::foldLanes<Out>(local, n, Out{}, [](Out a, Out b) { return a + b; });
+  ppc::core::kernels::exclusiveScan(local, n, out, exscanOffset(world, local_total));
+}
+
+namespace detail {
+
+template <class Out>
+void combineSegmentCarries(void* invec, void* inoutvec, int* len, MPI_Datatype* /*datatype*/) {
+  // MPI passes the lower ranks' partial result in `invec`.
+  auto* lower = static_cast<ppc::core::kernels::SegmentCarry<Out>*>(invec);
+  auto* upper = static_cast<ppc::core::kernels::SegmentCarry<Out>*>(inoutvec);
+  for (int i = 0; i < *len; i++) {
+    upper[i] = ppc::core::kernels::combineSegments(lower[i], upper[i]);
+  }
+}
+
+}  // namespace detail
+
+// Segmented inclusive scan; heads[i] != 0 starts a new segment. Segments may
+// span several ranks: the carry of every block is combined with MPI_Exscan and
+// a non-commutative user operation.
+template <class T, class Out>
+void segmentedInclusiveScan(const boost::mpi::communicator& world, const T* local, const std::uint8_t* heads,
+                            std::size_t n, Out* out) {
+  using Carry = ppc::core::kernels::SegmentCarry<Out>;
+  Carry local_carry;
+  for (std::size_t i = 0; i < n; i++) {
+    if (heads[i] != 0) {
+      local_carry = {static_cast<Out>(local[i]), 1};
+    } else {
+      local_carry.value = local_carry.value + static_cast<Out>(local[i]);
+    }
+  }
+
+  const BytesType<Carry> carry_type;
+  MPI_Op op;
+  MPI_Op_create(&detail::combineSegmentCarries<Out>, 0, &op);
+  Carry incoming;
+  MPI_Exscan(&local_carry, &incoming, 1, carry_type.get(), op, world);
+  MPI_Op_free(&op);
+  if (world.rank() == 0) {
+    incoming = {};
+  }
+  ppc::core::kernels::segmentedInclusiveScan(local, heads, n, out, incoming);
+}
+
+}  // namespace ppc::mpi
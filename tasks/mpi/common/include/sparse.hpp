@@ -0,0 +1,185 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/sparse.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+
+namespace ppc::mpi {
+
+// Sends every process its block of rows (part.counts/displs) of the n x n CSR
+// matrix held by rank 0: the root cuts row_ptr at the block boundaries, every
+// process receives its row starts and its run of col_idx/values and rebases
+// the row starts. Column indices stay global. The arrays are ignored on other
+// ranks. Collective over `comm`.
+template <class T>
+ppc::core::kernels::CsrMatrix<T> scatterCsr(MPI_Comm comm, const BlockPartition& part, int n, const int* row_ptr,
+                                            const int* col_idx, const T* values) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  std::vector<int> nnz_counts(size);
+  std::vector<int> nnz_displs(size);
+  if (rank == 0) {
+    for (int proc = 0; proc < size; proc++) {
+      nnz_displs[proc] = row_ptr[part.displs[proc]];
+      nnz_counts[proc] = row_ptr[part.displs[proc] + part.counts[proc]] - nnz_displs[proc];
+    }
+  }
+  int nnz = 0;
+  MPI_Scatter(nnz_counts.data(), 1, MPI_INT, &nnz, 1, MPI_INT, 0, comm);
+
+  const int rows = part.counts[rank];
+  ppc::core::kernels::CsrMatrix<T> local;
+  local.rows = rows;
+  local.cols = n;
+  local.row_ptr.resize(rows + 1);
+  local.col_idx.resize(nnz);
+  local.values.resize(nnz);
+  MPI_Scatterv(row_ptr, part.counts.data(), part.displs.data(), MPI_INT, local.row_ptr.data(), rows, MPI_INT, 0, comm);
+  MPI_Scatterv(col_idx, nnz_counts.data(), nnz_displs.data(), MPI_INT, local.col_idx.data(), nnz, MPI_INT, 0, comm);
+  MPI_Scatterv(values, nnz_counts.data(), nnz_displs.data(), mpiTypeOf<T>(), local.values.data(), nnz, mpiTypeOf<T>(),
+               0, comm);
+  const int base = rows > 0 ? local.row_ptr[0] : 0;
+  for (int i = 0; i < rows; i++) {
+    local.row_ptr[i] -= base;
+  }
+  local.row_ptr[rows] = nnz;
+  return local;
+}
+
+// Storage used for the local product of a DistributedSpmv.
+//  Csr  - the rows as given; threads split them by non-zeros.
+//  Sell - SELL-C-sigma with C = kSimdLanes<T> and sigma = 32 C, which keeps
+//         the SIMD lanes busy on rows of similar length.
+enum class SpmvFormat { Csr, Sell };
+
+// y = A x for an n x n sparse matrix and vectors split into blocks of rows
+// (BlockPartition(n, size)); every process holds its rows of A and its block
+// of x and y.
+//
+// The columns of the own rows are renumbered once: own columns first, in
+// global order, then the ghosts - the remote entries of x the rows actually
+// touch, grouped by owner. Each process learns from the others which of its
+// entries they need (one MPI_Alltoall and one MPI_Alltoallv at setup), so a
+// product sends every process only those entries, and only to the processes
+// that need them, instead of gathering the whole vector. For a banded or
+// mesh-like matrix that is a few boundary values per neighbour.
+template <class T>
+class DistributedSpmv {
+ public:
+  // `rows` holds the own rows of A with global column indices (for example
+  // from scatterCsr()). Collective over `comm`.
+  DistributedSpmv(MPI_Comm comm, const BlockPartition& part, ppc::core::kernels::CsrMatrix<T> rows,
+                  SpmvFormat format = SpmvFormat::Csr)
+      : comm_(comm), format_(format), local_(std::move(rows)) {
+    int rank = 0;
+    int size = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    const int first = part.displs[rank];
+    const int own = part.counts[rank];
+
+    std::vector<int> ghosts;
+    for (const int col : local_.col_idx) {
+      if (col < first || col >= first + own) ghosts.push_back(col);
+    }
+    std::sort(ghosts.begin(), ghosts.end());
+    ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+    for (int& col : local_.col_idx) {
+      col = col >= first && col < first + own
+                ? col - first
+                : own + static_cast<int>(std::lower_bound(ghosts.begin(), ghosts.end(), col) - ghosts.begin());
+    }
+    local_.cols = own + ghosts.size();
+
+    // Ghosts are sorted, so those of one owner are contiguous.
+    std::vector<int> recv_counts(size, 0);
+    for (const int col : ghosts) recv_counts[part.owner(col)]++;
+    std::vector<int> send_counts(size);
+    MPI_Alltoall(recv_counts.data(), 1, MPI_INT, send_counts.data(), 1, MPI_INT, comm);
+    std::vector<int> recv_displs(size, 0);
+    std::vector<int> send_displs(size, 0);
+    for (int proc = 1; proc < size; proc++) {
+      recv_displs[proc] = recv_displs[proc - 1] + recv_counts[proc - 1];
+      send_displs[proc] = send_displs[proc - 1] + send_counts[proc - 1];
+    }
+    send_index_.resize(send_displs.back() + send_counts.back());
+    MPI_Alltoallv(ghosts.data(), recv_counts.data(), recv_displs.data(), MPI_INT, send_index_.data(),
+                  send_counts.data(), send_displs.data(), MPI_INT, comm);
+    for (int& index : send_index_) index -= first;
+
+    for (int proc = 0; proc < size; proc++) {
+      if (recv_counts[proc] > 0) recvs_.push_back({proc, recv_counts[proc], own + recv_displs[proc]});
+      if (send_counts[proc] > 0) sends_.push_back({proc, send_counts[proc], send_displs[proc]});
+    }
+    x_.resize(local_.cols);
+    send_buffer_.resize(send_index_.size());
+    requests_.resize(recvs_.size() + sends_.size());
+    if (format_ == SpmvFormat::Sell) {
+      constexpr std::size_t kChunk = ppc::core::kernels::kSimdLanes<T>;
+      sell_ = ppc::core::kernels::SellMatrix<T>::fromCsr(local_, kChunk, 32 * kChunk);
+    }
+  }
+
+  // y = A x for the own block of x; y receives the own block of the product.
+  // The local product runs on num_threads threads. Collective over the
+  // communicator.
+  void multiply(const T* x, T* y, int num_threads = 1) {
+    std::copy(x, x + local_.rows, x_.begin());
+    std::size_t r = 0;
+    for (const auto& peer : recvs_) {
+      MPI_Irecv(x_.data() + peer.offset, peer.count, mpiTypeOf<T>(), peer.proc, 0, comm_, &requests_[r++]);
+    }
+    for (std::size_t i = 0; i < send_index_.size(); i++) {
+      send_buffer_[i] = x[send_index_[i]];
+    }
+    for (const auto& peer : sends_) {
+      MPI_Isend(send_buffer_.data() + peer.offset, peer.count, mpiTypeOf<T>(), peer.proc, 0, comm_, &requests_[r++]);
+    }
+    MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+    if (format_ == SpmvFormat::Sell) {
+      ppc::core::kernels::parallelSpmv(sell_, x_.data(), y, num_threads);
+    } else {
+      ppc::core::kernels::parallelSpmv(local_, x_.data(), y, num_threads);
+    }
+  }
+
+  // Own rows with local column numbers: column j < rows() is own row j, so the
+  // diagonal entry of row i is local().at(i, i).
+  [[nodiscard]] const ppc::core::kernels::CsrMatrix<T>& local() const { return local_; }
+  [[nodiscard]] std::size_t rows() const { return local_.rows; }
+  [[nodiscard]] std::size_t ghosts() const { return local_.cols - local_.rows; }
+  // Processes this one receives ghost values from.
+  [[nodiscard]] std::size_t neighbours() const { return recvs_.size(); }
+
+ private:
+  // `count` values exchanged with `proc`, at `offset` in x_ (receives) or
+  // send_buffer_ (sends).
+  struct Peer {
+    int proc;
+    int count;
+    int offset;
+  };
+
+  MPI_Comm comm_;
+  SpmvFormat format_;
+  ppc::core::kernels::CsrMatrix<T> local_;
+  ppc::core::kernels::SellMatrix<T> sell_;
+  std::vector<int> send_index_;
+  std::vector<Peer> recvs_;
+  std::vector<Peer> sends_;
+  std::vector<T> x_;
+  std::vector<T> send_buffer_;
+  std::vector<MPI_Request> requests_;
+};
+
+}  // namespace ppc::mpi
@@ -0,0 +1,73 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "core/kernels/include/transpose.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+
+namespace ppc::mpi {
+
+// Distributed transpose of a row-major m x n matrix split into block rows
+// (BlockPartition(m, size)): on return every process holds its block rows of
+// the n x m transpose (BlockPartition(n, size)), so a process that owned rows
+// now owns contiguous columns. Collective over `comm`.
+//
+// Each process transposes the piece of its rows that goes to each target with
+// the cache-oblivious kernel into one send buffer, and a single MPI_Alltoallw
+// lands every incoming piece directly in its column range of `local_at`
+// through a strided receive type. No process ever holds the whole matrix.
+//
+// local_a:  counts[rank] x n elements for BlockPartition(m, size).
+// local_at: counts[rank] x m elements for BlockPartition(n, size).
+template <class T>
+void transposeBlockRows(MPI_Comm comm, int m, int n, const T* local_a, T* local_at) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const BlockPartition rows(m, size);
+  const BlockPartition cols(n, size);
+  const int my_rows = rows.counts[rank];
+  const int my_cols = cols.counts[rank];
+
+  std::vector<T> send(static_cast<std::size_t>(my_rows) * n);
+  std::vector<int> send_counts(size);
+  std::vector<int> send_displs(size);
+  std::vector<int> recv_counts(size, 0);
+  const std::vector<int> recv_displs = [&] {
+    std::vector<int> bytes(size);
+    for (int proc = 0; proc < size; proc++) {
+      bytes[proc] = rows.displs[proc] * static_cast<int>(sizeof(T));
+    }
+    return bytes;
+  }();
+  const std::vector<MPI_Datatype> send_types(size, mpiTypeOf<T>());
+  std::vector<MPI_Datatype> recv_types(size, mpiTypeOf<T>());
+
+  for (int proc = 0; proc < size; proc++) {
+    // Columns cols.displs[proc].. of my rows become proc's rows, as a
+    // contiguous cols.counts[proc] x my_rows block.
+    T* piece = send.data() + static_cast<std::size_t>(cols.displs[proc]) * my_rows;
+    ppc::core::kernels::transpose<T>(my_rows, cols.counts[proc], local_a + cols.displs[proc], n, piece, my_rows);
+    send_counts[proc] = cols.counts[proc] * my_rows;
+    send_displs[proc] = cols.displs[proc] * my_rows * static_cast<int>(sizeof(T));
+    // proc's rows become my columns rows.displs[proc]..
+    if (my_cols > 0 && rows.counts[proc] > 0) {
+      MPI_Type_vector(my_cols, rows.counts[proc], m, mpiTypeOf<T>(), &recv_types[proc]);
+      MPI_Type_commit(&recv_types[proc]);
+      recv_counts[proc] = 1;
+    }
+  }
+  MPI_Alltoallw(send.data(), send_counts.data(), send_displs.data(), send_types.data(), local_at, recv_counts.data(),
+                recv_displs.data(), recv_types.data(), comm);
+  for (int proc = 0; proc < size; proc++) {
+    if (recv_counts[proc] != 0) MPI_Type_free(&recv_types[proc]);
+  }
+}
+
+}  // namespace ppc::mpi
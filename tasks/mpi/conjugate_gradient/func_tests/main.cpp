@@ -0,0 +1,218 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/kernels/include/sparse.hpp"
+#include "core/testing/include/compare.hpp"
+#include "mpi/conjugate_gradient/include/ops_mpi.hpp"
+
+namespace {
+
+std::vector<double> getRandomVector(size_t size, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> vec(size);
+  for (auto& value : vec) value = dist(gen);
+  return vec;
+}
+
+// A = M M^T + n I: dense and well conditioned.
+std::vector<double> makeDenseSpd(int n) {
+  const auto m = getRandomVector(static_cast<size_t>(n) * n, 5);
+  std::vector<double> a(static_cast<size_t>(n) * n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      double sum = i == j ? n : 0.0;
+      for (int k = 0; k < n; k++) sum += m[i * n + k] * m[j * n + k];
+      a[i * n + j] = sum;
+    }
+  }
+  return a;
+}
+
+// 5-point Laplacian on a side x side grid.
+ppc::core::kernels::CsrMatrix<double> makeLaplacian(int side) {
+  const int n = side * side;
+  std::vector<double> dense(static_cast<size_t>(n) * n, 0.0);
+  for (int i = 0; i < side; i++) {
+    for (int j = 0; j < side; j++) {
+      const int row = i * side + j;
+      dense[row * n + row] = 4.0;
+      if (i > 0) dense[row * n + row - side] = -1.0;
+      if (i + 1 < side) dense[row * n + row + side] = -1.0;
+      if (j > 0) dense[row * n + row - 1] = -1.0;
+      if (j + 1 < side) dense[row * n + row + 1] = -1.0;
+    }
+  }
+  return ppc::core::kernels::CsrMatrix<double>::fromDense(n, n, dense.data());
+}
+
+std::vector<double> multiply(const ppc::core::kernels::CsrMatrix<double>& a, const std::vector<double>& x) {
+  std::vector<double> y(a.rows);
+  ppc::core::kernels::spmv(a, x.data(), y.data());
+  return y;
+}
+
+struct System {
+  ppc::core::kernels::CsrMatrix<double> csr;
+  std::vector<double> dense;
+  std::vector<double> b;
+  std::vector<double> solution;
+};
+
+System denseSystem(int n) {
+  System system;
+  system.dense = makeDenseSpd(n);
+  system.csr = ppc::core::kernels::CsrMatrix<double>::fromDense(n, n, system.dense.data());
+  system.solution = getRandomVector(n, 7);
+  system.b = multiply(system.csr, system.solution);
+  return system;
+}
+
+System laplacianSystem(int side) {
+  System system;
+  system.csr = makeLaplacian(side);
+  system.solution = getRandomVector(system.csr.rows, 9);
+  system.b = multiply(system.csr, system.solution);
+  return system;
+}
+
+std::shared_ptr<ppc::core::TaskData> makeTaskData(System& system, bool csr, std::vector<double>& x) {
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  const auto n = static_cast<uint32_t>(system.b.size());
+  if (csr) {
+    const auto nnz = static_cast<uint32_t>(system.csr.nnz());
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(system.csr.row_ptr.data()));
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(system.csr.col_idx.data()));
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(system.csr.values.data()));
+    taskData->inputs_count = {n + 1, nnz, nnz, n};
+  } else {
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(system.dense.data()));
+    taskData->inputs_count = {n, n};
+  }
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(system.b.data()));
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+  taskData->outputs_count.emplace_back(n);
+  return taskData;
+}
+
+void runAndCompare(System system, bool csr, conjugate_gradient_mpi::PcgParams params, int num_threads = 1) {
+  boost::mpi::communicator world;
+  const size_t n = system.solution.size();
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(system, csr, x);
+  }
+  conjugate_gradient_mpi::PcgParallel<double> testMpiTaskParallel(taskDataPar, params, num_threads);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+
+  if (world.rank() == 0) {
+    std::vector<double> reference(n);
+    auto taskDataSeq = ppc::core::testing::withOutputs(taskDataPar, {reinterpret_cast<uint8_t*>(reference.data())});
+    conjugate_gradient_mpi::PcgSequential<double> testMpiTaskSequential(taskDataSeq, params, num_threads);
+    ppc::core::testing::runTask(testMpiTaskSequential);
+
+    EXPECT_TRUE(testMpiTaskParallel.result().converged);
+    EXPECT_TRUE(testMpiTaskSequential.result().converged);
+    EXPECT_LE(testMpiTaskParallel.result().residual, params.tolerance);
+    for (size_t i = 0; i < n; i++) {
+      ASSERT_NEAR(x[i], system.solution[i], 1e-7);
+      ASSERT_NEAR(reference[i], system.solution[i], 1e-7);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(conjugate_gradient_mpi, dense_jacobi) { runAndCompare(denseSystem(40), false, {1e-12, 500}); }
+
+TEST(conjugate_gradient_mpi, dense_block_jacobi) { runAndCompare(denseSystem(40), false, {1e-12, 500, 4}); }
+
+TEST(conjugate_gradient_mpi, dense_input_as_csr) { runAndCompare(denseSystem(30), true, {1e-12, 500}); }
+
+TEST(conjugate_gradient_mpi, laplacian_csr_jacobi) { runAndCompare(laplacianSystem(20), true, {1e-12, 1000}); }
+
+TEST(conjugate_gradient_mpi, laplacian_csr_block_jacobi) {
+  runAndCompare(laplacianSystem(20), true, {1e-12, 1000, 20});
+}
+
+TEST(conjugate_gradient_mpi, laplacian_threaded) { runAndCompare(laplacianSystem(16), true, {1e-12, 1000}, 3); }
+
+TEST(conjugate_gradient_mpi, fewer_rows_than_processes) { runAndCompare(denseSystem(2), false, {1e-12, 50}); }
+
+TEST(conjugate_gradient_mpi, zero_right_hand_side) {
+  boost::mpi::communicator world;
+  System system = laplacianSystem(4);
+  std::fill(system.b.begin(), system.b.end(), 0.0);
+  std::vector<double> x(system.b.size(), 1.0);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(system, true, x);
+  }
+  conjugate_gradient_mpi::PcgParallel<double> testMpiTaskParallel(taskDataPar, {1e-12, 10});
+  ppc::core::testing::runTask(testMpiTaskParallel);
+  if (world.rank() == 0) {
+    EXPECT_EQ(testMpiTaskParallel.result().iterations, 0);
+    EXPECT_EQ(x, std::vector<double>(x.size(), 0.0));
+  }
+}
+
+// Whole-grid-row blocks capture the strong coupling along a row, so
+// block-Jacobi needs fewer iterations than the diagonal alone.
+TEST(conjugate_gradient_mpi, block_jacobi_saves_iterations) {
+  System system = laplacianSystem(24);
+  std::vector<double> x(system.b.size());
+  auto taskData = makeTaskData(system, true, x);
+  conjugate_gradient_mpi::PcgSequential<double> jacobi(taskData, {1e-10, 1000, 1});
+  ppc::core::testing::runTask(jacobi);
+  conjugate_gradient_mpi::PcgSequential<double> block_jacobi(taskData, {1e-10, 1000, 24});
+  ppc::core::testing::runTask(block_jacobi);
+  EXPECT_LT(block_jacobi.result().iterations, jacobi.result().iterations);
+}
+
+TEST(conjugate_gradient_mpi, validation_fails_on_unsorted_csr) {
+  System system = laplacianSystem(3);
+  std::swap(system.csr.col_idx[0], system.csr.col_idx[1]);
+  std::vector<double> x(system.b.size());
+  conjugate_gradient_mpi::PcgSequential<double> testTask(makeTaskData(system, true, x), {1e-9, 10});
+  EXPECT_FALSE(testTask.validation());
+}
+
+TEST(conjugate_gradient_mpi, validation_fails_on_non_positive_diagonal) {
+  System system = denseSystem(4);
+  system.dense[5] = -1.0;
+  std::vector<double> x(system.b.size());
+  conjugate_gradient_mpi::PcgSequential<double> testTask(makeTaskData(system, false, x), {1e-9, 10});
+  EXPECT_FALSE(testTask.validation());
+}
+
+TEST(conjugate_gradient_mpi, validation_fails_on_bad_params) {
+  System system = denseSystem(4);
+  std::vector<double> x(system.b.size());
+  auto taskData = makeTaskData(system, false, x);
+  conjugate_gradient_mpi::PcgSequential<double> zero_tolerance(taskData, {0.0, 10});
+  conjugate_gradient_mpi::PcgSequential<double> zero_block(taskData, {1e-9, 10, 0});
+  conjugate_gradient_mpi::PcgSequential<double> no_threads(taskData, {1e-9, 10}, 0);
+  EXPECT_FALSE(zero_tolerance.validation());
+  EXPECT_FALSE(zero_block.validation());
+  EXPECT_FALSE(no_threads.validation());
+}
+
+// [[2, 3], [3, 2]] has a positive diagonal but is indefinite, which the 2 x 2
+// block factorisation detects.
+TEST(conjugate_gradient_mpi, pre_processing_fails_on_indefinite_block) {
+  System system;
+  system.dense = {2.0, 3.0, 3.0, 2.0};
+  system.b = {1.0, 1.0};
+  std::vector<double> x(2);
+  conjugate_gradient_mpi::PcgSequential<double> testTask(makeTaskData(system, false, x), {1e-9, 10, 2});
+  ASSERT_TRUE(testTask.validation());
+  EXPECT_FALSE(testTask.pre_processing());
+}
@@ -0,0 +1,305 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/aligned_allocator.hpp"
+#include "core/kernels/include/cg.hpp"
+#include "core/kernels/include/dot_product.hpp"
+#include "core/kernels/include/parallel.hpp"
+#include "core/kernels/include/sparse.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/common/include/sparse.hpp"
+
+namespace conjugate_gradient_mpi {
+
+// Solves A x = b for a symmetric positive definite n x n matrix A, given
+// either dense or in CSR form:
+//  dense: inputs = {A (row-major), b}, inputs_count = {n, n};
+//  CSR:   inputs = {row_ptr (n + 1 int32), col_idx (nnz int32), values (nnz),
+//         b}, inputs_count = {n + 1, nnz, nnz, n}.
+// Output: outputs[0] receives x (n values).
+//
+// block_size selects the preconditioner: 1 is Jacobi (the diagonal), larger
+// values block-Jacobi with diagonal blocks of that many rows (never spanning
+// two processes). Iteration stops when ||b - A x|| <= tolerance * ||b||.
+struct PcgParams {
+  double tolerance;
+  int max_iterations;
+  size_t block_size = 1;
+};
+
+template <class T>
+bool isValidTaskData(const ppc::core::TaskData& taskData, const PcgParams& params) {
+  if (!(params.tolerance > 0.0) || params.max_iterations <= 0 || params.block_size == 0 ||
+      taskData.outputs.size() != 1 || taskData.outputs_count.size() != 1) {
+    return false;
+  }
+  if (taskData.inputs.size() == 2 && taskData.inputs_count.size() == 2) {
+    const size_t n = taskData.inputs_count[0];
+    const auto* a = reinterpret_cast<const T*>(taskData.inputs[0]);
+    if (n == 0 || taskData.inputs_count[1] != n || taskData.outputs_count[0] != n) return false;
+    for (size_t i = 0; i < n; i++) {
+      if (!(a[i * n + i] > T{})) return false;
+    }
+    return true;
+  }
+  if (taskData.inputs.size() == 4 && taskData.inputs_count.size() == 4) {
+    const size_t n = taskData.inputs_count[3];
+    const size_t nnz = taskData.inputs_count[1];
+    return n > 0 && taskData.inputs_count[0] == n + 1 && taskData.inputs_count[2] == nnz &&
+           taskData.outputs_count[0] == n &&
+           ppc::core::kernels::isValidCsr(n, n, nnz, reinterpret_cast<const int*>(taskData.inputs[0]),
+                                          reinterpret_cast<const int*>(taskData.inputs[1]));
+  }
+  return false;
+}
+
+// Rows [first_row, first_row + rows) of an n x n matrix, stored densely or as
+// CSR with global column indices.
+template <class T>
+class RowBlock {
+  static_assert(std::is_floating_point_v<T>);
+
+ public:
+  static RowBlock dense(size_t n, size_t first_row, size_t rows, const T* values) {
+    RowBlock block(n, first_row, rows);
+    block.dense_.assign(values, values + rows * n);
+    return block;
+  }
+
+  static RowBlock csr(size_t n, size_t first_row, ppc::core::kernels::CsrMatrix<T> local) {
+    RowBlock block(n, first_row, local.rows);
+    block.is_csr_ = true;
+    block.csr_ = std::move(local);
+    return block;
+  }
+
+  [[nodiscard]] size_t rows() const { return rows_; }
+  [[nodiscard]] size_t firstRow() const { return first_row_; }
+
+  // y = (A x) restricted to the own rows, for the full-length x.
+  void multiply(const T* x, T* y, int num_threads) const {
+    if (is_csr_) {
+      ppc::core::kernels::parallelSpmv(csr_, x, y, num_threads);
+      return;
+    }
+    ppc::core::kernels::detail::forEachChunk(
+        rows_, num_threads,
+        [&](size_t /*chunk*/, size_t begin, size_t end) {
+          ppc::core::kernels::dotMany(x, dense_.data() + begin * n_, n_, end - begin, y + begin);
+        },
+        std::max<size_t>(1, ppc::core::kernels::detail::kMinChunk / std::max<size_t>(1, n_)));
+  }
+
+  // A[first_row + local_row][col].
+  [[nodiscard]] T entry(size_t local_row, size_t col) const {
+    return is_csr_ ? csr_.at(local_row, col) : dense_[local_row * n_ + col];
+  }
+
+ private:
+  RowBlock(size_t n, size_t first_row, size_t rows) : n_(n), first_row_(first_row), rows_(rows) {}
+
+  size_t n_;
+  size_t first_row_;
+  size_t rows_;
+  bool is_csr_ = false;
+  ppc::core::kernels::AlignedVector<T> dense_;
+  ppc::core::kernels::CsrMatrix<T> csr_;
+};
+
+// Single-process solver; with num_threads_ > 1 the products, the
+// preconditioner and the vector updates are split between threads.
+template <class T>
+class PcgSequential : public ppc::core::Task {
+ public:
+  explicit PcgSequential(std::shared_ptr<ppc::core::TaskData> taskData_, PcgParams params_, int num_threads_ = 1)
+      : Task(std::move(taskData_)), params(params_), num_threads(num_threads_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    if (taskData->inputs.size() == 2) {
+      n = taskData->inputs_count[0];
+      block_.emplace(RowBlock<T>::dense(n, 0, n, reinterpret_cast<T*>(taskData->inputs[0])));
+      auto* b = reinterpret_cast<T*>(taskData->inputs[1]);
+      b_.assign(b, b + n);
+    } else {
+      n = taskData->inputs_count[3];
+      const size_t nnz = taskData->inputs_count[1];
+      ppc::core::kernels::CsrMatrix<T> csr;
+      csr.rows = csr.cols = n;
+      auto* row_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
+      auto* col_idx = reinterpret_cast<int*>(taskData->inputs[1]);
+      auto* values = reinterpret_cast<T*>(taskData->inputs[2]);
+      csr.row_ptr.assign(row_ptr, row_ptr + n + 1);
+      csr.col_idx.assign(col_idx, col_idx + nnz);
+      csr.values.assign(values, values + nnz);
+      block_.emplace(RowBlock<T>::csr(n, 0, std::move(csr)));
+      auto* b = reinterpret_cast<T*>(taskData->inputs[3]);
+      b_.assign(b, b + n);
+    }
+    x_.resize(n);
+    return preconditioner_.factorise(n, params.block_size, [&](size_t i, size_t j) { return block_->entry(i, j); });
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return isValidTaskData<T>(*taskData, params) && num_threads > 0;
+  }
+
+  bool run() override {
+    internal_order_test();
+    result_ = ppc::core::kernels::pcgSolve(
+        n, b_.data(), x_.data(), [&](const T* u, T* w) { block_->multiply(u, w, num_threads); },
+        [&](const T* r, T* u) { preconditioner_.apply(r, u, num_threads); }, [](std::array<double, 3>& /*sums*/) {},
+        params.tolerance, params.max_iterations, num_threads);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(x_.begin(), x_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    return true;
+  }
+
+  [[nodiscard]] const ppc::core::kernels::PcgResult& result() const { return result_; }
+
+ private:
+  PcgParams params;
+  int num_threads;
+  size_t n{};
+  std::optional<RowBlock<T>> block_;
+  ppc::core::kernels::BlockJacobiPreconditioner<T> preconditioner_;
+  std::vector<T> b_;
+  std::vector<T> x_;
+  ppc::core::kernels::PcgResult result_;
+};
+
+// Same contract, with A split into blocks of rows (BlockPartition(n, size)).
+// For the product, dense input gathers the preconditioned residual on every
+// process with one MPI_Allgatherv; CSR input goes through a
+// ppc::mpi::DistributedSpmv, which sends each process only the entries its
+// rows touch. The three inner products of an iteration are summed with one
+// MPI_Allreduce. Each process runs num_threads_ threads.
+template <class T>
+class PcgParallel : public ppc::core::Task {
+ public:
+  explicit PcgParallel(std::shared_ptr<ppc::core::TaskData> taskData_, PcgParams params_, int num_threads_ = 1)
+      : Task(std::move(taskData_)), params(params_), num_threads(num_threads_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    // {n, nnz}; nnz < 0 marks dense input.
+    std::array<int, 2> shape{};
+    if (world.rank() == 0) {
+      const bool csr = taskData->inputs.size() == 4;
+      shape = {static_cast<int>(taskData->inputs_count[csr ? 3 : 0]),
+               csr ? static_cast<int>(taskData->inputs_count[1]) : -1};
+    }
+    broadcast(world, shape.data(), 2, 0);
+    n = shape[0];
+    part_ = ppc::mpi::BlockPartition(n, world.size());
+    const int rows = part_.counts[world.rank()];
+    const int first_row = part_.displs[world.rank()];
+    if (shape[1] < 0) {
+      distributeDense(rows, first_row);
+    } else {
+      const auto input = [&](size_t index) { return world.rank() == 0 ? taskData->inputs[index] : nullptr; };
+      spmv_.emplace(world, part_,
+                    ppc::mpi::scatterCsr(world, part_, n, reinterpret_cast<int*>(input(0)),
+                                         reinterpret_cast<int*>(input(1)), reinterpret_cast<T*>(input(2))));
+    }
+    b_.resize(rows);
+    MPI_Scatterv(world.rank() == 0 ? taskData->inputs.back() : nullptr, part_.counts.data(), part_.displs.data(),
+                 ppc::mpi::mpiTypeOf<T>(), b_.data(), rows, ppc::mpi::mpiTypeOf<T>(), 0, world);
+    x_.resize(rows);
+    const bool factorised = preconditioner_.factorise(rows, params.block_size, [&](size_t i, size_t j) {
+      return spmv_ ? spmv_->local().at(i, j) : block_->entry(i, first_row + j);
+    });
+    return boost::mpi::all_reduce(world, factorised, std::logical_and<>());
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return isValidTaskData<T>(*taskData, params) && num_threads > 0;
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    result_ = ppc::core::kernels::pcgSolve(
+        b_.size(), b_.data(), x_.data(),
+        [&](const T* u, T* w) {
+          if (spmv_) {
+            spmv_->multiply(u, w, num_threads);
+            return;
+          }
+          MPI_Allgatherv(u, static_cast<int>(b_.size()), ppc::mpi::mpiTypeOf<T>(), u_full_.data(),
+                         part_.counts.data(), part_.displs.data(), ppc::mpi::mpiTypeOf<T>(), world);
+          block_->multiply(u_full_.data(), w, num_threads);
+        },
+        [&](const T* r, T* u) { preconditioner_.apply(r, u, num_threads); },
+        [&](std::array<double, 3>& sums) {
+          MPI_Allreduce(MPI_IN_PLACE, sums.data(), 3, MPI_DOUBLE, MPI_SUM, world);
+        },
+        params.tolerance, params.max_iterations, num_threads);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    MPI_Gatherv(x_.data(), static_cast<int>(x_.size()), ppc::mpi::mpiTypeOf<T>(),
+                world.rank() == 0 ? taskData->outputs[0] : nullptr, part_.counts.data(), part_.displs.data(),
+                ppc::mpi::mpiTypeOf<T>(), 0, world);
+    return true;
+  }
+
+  [[nodiscard]] const ppc::core::kernels::PcgResult& result() const { return result_; }
+
+ private:
+  // Whole rows travel as one contiguous datatype, so the counts stay in rows.
+  void distributeDense(int rows, int first_row) {
+    MPI_Datatype row_type;
+    MPI_Type_contiguous(n, ppc::mpi::mpiTypeOf<T>(), &row_type);
+    MPI_Type_commit(&row_type);
+    std::vector<T> local(static_cast<size_t>(rows) * n);
+    MPI_Scatterv(world.rank() == 0 ? taskData->inputs[0] : nullptr, part_.counts.data(), part_.displs.data(), row_type,
+                 local.data(), rows, row_type, 0, world);
+    MPI_Type_free(&row_type);
+    block_.emplace(RowBlock<T>::dense(n, first_row, rows, local.data()));
+    u_full_.resize(n);
+  }
+
+  PcgParams params;
+  int num_threads;
+  int n{};
+  ppc::mpi::BlockPartition part_{0, 1};
+  std::optional<RowBlock<T>> block_;
+  std::optional<ppc::mpi::DistributedSpmv<T>> spmv_;
+  ppc::core::kernels::BlockJacobiPreconditioner<T> preconditioner_;
+  std::vector<T> b_;
+  std::vector<T> x_;
+  std::vector<T> u_full_;
+  ppc::core::kernels::PcgResult result_;
+  boost::mpi::communicator world;
+};
+
+}  // namespace conjugate_gradient_mpi
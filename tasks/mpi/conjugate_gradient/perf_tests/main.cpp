@@ -0,0 +1,97 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/kernels/include/sparse.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/conjugate_gradient/include/ops_mpi.hpp"
+
+namespace {
+
+// 5-point Laplacian of a kSide x kSide grid in CSR (65536 unknowns, about 5
+// non-zeros per row) with b = A * (1, ..., 1).
+const int kSide = 256;
+
+ppc::core::kernels::CsrMatrix<double> makeLaplacian() {
+  ppc::core::kernels::CsrMatrix<double> a;
+  a.rows = a.cols = static_cast<size_t>(kSide) * kSide;
+  for (int i = 0; i < kSide; i++) {
+    for (int j = 0; j < kSide; j++) {
+      const int row = i * kSide + j;
+      const auto add = [&](int col, double value) {
+        a.col_idx.push_back(col);
+        a.values.push_back(value);
+      };
+      if (i > 0) add(row - kSide, -1.0);
+      if (j > 0) add(row - 1, -1.0);
+      add(row, 4.0);
+      if (j + 1 < kSide) add(row + 1, -1.0);
+      if (i + 1 < kSide) add(row + kSide, -1.0);
+      a.row_ptr.push_back(static_cast<int>(a.values.size()));
+    }
+  }
+  return a;
+}
+
+void runPerf(bool pipeline) {
+  boost::mpi::communicator world;
+  const conjugate_gradient_mpi::PcgParams params{1e-8, 5000};
+  ppc::core::kernels::CsrMatrix<double> a;
+  std::vector<double> b;
+  std::vector<double> x;
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    a = makeLaplacian();
+    const std::vector<double> ones(a.rows, 1.0);
+    b.resize(a.rows);
+    ppc::core::kernels::spmv(a, ones.data(), b.data());
+    x.resize(a.rows);
+    const auto n = static_cast<uint32_t>(a.rows);
+    const auto nnz = static_cast<uint32_t>(a.nnz());
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.row_ptr.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.col_idx.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.values.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+    taskDataPar->inputs_count = {n + 1, nnz, nnz, n};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+    taskDataPar->outputs_count.emplace_back(n);
+  }
+
+  auto testMpiTaskParallel = std::make_shared<conjugate_gradient_mpi::PcgParallel<double>>(taskDataPar, params);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->data_type = ppc::core::kernels::typeName<double>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    EXPECT_TRUE(testMpiTaskParallel->result().converged);
+    for (size_t i = 0; i < x.size(); i++) {
+      ASSERT_NEAR(x[i], 1.0, 1e-4);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(conjugate_gradient_mpi_perf_test, test_pipeline_run) { runPerf(true); }
+
+TEST(conjugate_gradient_mpi_perf_test, test_task_run) { runPerf(false); }
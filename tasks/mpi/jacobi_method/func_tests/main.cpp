@@ -0,0 +1,275 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/sparse.hpp"
+#include "core/testing/include/compare.hpp"
+#include "mpi/jacobi_method/include/ops_mpi.hpp"
+
+namespace {
+
+// Random n x n system with a known solution: off-diagonal entries in [-1, 1]
+// within `bandwidth` of the diagonal (everywhere for a negative bandwidth) and
+// a diagonal twice the off-diagonal row sum, so Jacobi converges quickly.
+template <class T>
+struct System {
+  std::vector<T> a;
+  std::vector<T> b;
+  std::vector<T> solution;
+};
+
+template <class T>
+System<T> makeSystem(int n, int bandwidth = -1) {
+  std::random_device dev;
+  std::mt19937 gen(dev());
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  System<T> system;
+  system.a.assign(static_cast<size_t>(n) * n, T{});
+  system.solution.resize(n);
+  for (auto& value : system.solution) value = static_cast<T>(dist(gen));
+  for (int i = 0; i < n; i++) {
+    T row_sum{};
+    for (int j = 0; j < n; j++) {
+      if (j != i && (bandwidth < 0 || std::abs(i - j) <= bandwidth)) {
+        system.a[i * n + j] = static_cast<T>(dist(gen));
+        row_sum += std::abs(system.a[i * n + j]);
+      }
+    }
+    system.a[i * n + i] = 2 * row_sum + T{1};
+  }
+  system.b.assign(n, T{});
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      system.b[i] += system.a[i * n + j] * system.solution[j];
+    }
+  }
+  return system;
+}
+
+std::shared_ptr<ppc::core::TaskData> makeTaskData(int n, std::vector<uint8_t*> inputs, uint8_t* x) {
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs = std::move(inputs);
+  taskData->inputs_count = {static_cast<uint32_t>(n), static_cast<uint32_t>(n)};
+  taskData->outputs.emplace_back(x);
+  taskData->outputs_count.emplace_back(n);
+  return taskData;
+}
+
+template <class T>
+void runAndCompare(int n, int bandwidth, T eps, T tolerance, ppc::mpi::ConvergencePolicy check = {}) {
+  boost::mpi::communicator world;
+  const jacobi_method_mpi::JacobiParams<T> params{eps, 1000, check};
+  System<T> system;
+  std::vector<T> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem<T>(n, bandwidth);
+    taskDataPar = makeTaskData(
+        n, {reinterpret_cast<uint8_t*>(system.a.data()), reinterpret_cast<uint8_t*>(system.b.data())},
+        reinterpret_cast<uint8_t*>(x.data()));
+  }
+
+  jacobi_method_mpi::JacobiParallel<T> testMpiTaskParallel(taskDataPar, params, bandwidth);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+
+  if (world.rank() == 0) {
+    std::vector<T> reference(n);
+    auto taskDataSeq = ppc::core::testing::withOutputs(taskDataPar, {reinterpret_cast<uint8_t*>(reference.data())});
+    jacobi_method_mpi::JacobiSequential<T> testMpiTaskSequential(taskDataSeq, params);
+    ppc::core::testing::runTask(testMpiTaskSequential);
+
+    const auto& stats = testMpiTaskParallel.stats();
+    EXPECT_TRUE(stats.converged);
+    EXPECT_EQ(stats.iterations % check.interval, 0);
+    EXPECT_LE(stats.wasted_sweeps, check.mode == ppc::mpi::CheckMode::Exact ? 1 : check.interval);
+    EXPECT_NEAR(stats.iterations, testMpiTaskSequential.iterations(), check.interval);
+    for (int i = 0; i < n; i++) {
+      ASSERT_NEAR(x[i], system.solution[i], tolerance);
+      ASSERT_NEAR(reference[i], system.solution[i], tolerance);
+    }
+  }
+}
+
+// Same check with the system handed over in CSR form.
+void runSparseAndCompare(int n, int bandwidth, ppc::mpi::SpmvFormat format) {
+  boost::mpi::communicator world;
+  const jacobi_method_mpi::JacobiParams<double> params{1e-12, 1000, {}, format};
+  System<double> system;
+  ppc::core::kernels::CsrMatrix<double> a;
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem<double>(n, bandwidth);
+    a = ppc::core::kernels::CsrMatrix<double>::fromDense(n, n, system.a.data());
+    const auto nnz = static_cast<uint32_t>(a.nnz());
+    taskDataPar->inputs = {reinterpret_cast<uint8_t*>(a.row_ptr.data()), reinterpret_cast<uint8_t*>(a.col_idx.data()),
+                           reinterpret_cast<uint8_t*>(a.values.data()), reinterpret_cast<uint8_t*>(system.b.data())};
+    taskDataPar->inputs_count = {static_cast<uint32_t>(n + 1), nnz, nnz, static_cast<uint32_t>(n)};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+    taskDataPar->outputs_count.emplace_back(n);
+  }
+
+  jacobi_method_mpi::JacobiParallel<double> testMpiTaskParallel(taskDataPar, params);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+
+  if (world.rank() == 0) {
+    std::vector<double> reference(n);
+    auto taskDataSeq = ppc::core::testing::withOutputs(taskDataPar, {reinterpret_cast<uint8_t*>(reference.data())});
+    jacobi_method_mpi::JacobiSequential<double> testMpiTaskSequential(taskDataSeq, params);
+    ppc::core::testing::runTask(testMpiTaskSequential);
+
+    EXPECT_TRUE(testMpiTaskParallel.stats().converged);
+    EXPECT_NEAR(testMpiTaskParallel.iterations(), testMpiTaskSequential.iterations(), 1);
+    for (int i = 0; i < n; i++) {
+      ASSERT_NEAR(x[i], system.solution[i], 1e-9);
+      ASSERT_NEAR(reference[i], system.solution[i], 1e-9);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(jacobi_method_mpi, dense_double) { runAndCompare<double>(60, -1, 1e-12, 1e-9); }
+
+TEST(jacobi_method_mpi, dense_float) { runAndCompare<float>(45, -1, 1e-6F, 1e-4F); }
+
+TEST(jacobi_method_mpi, fewer_rows_than_processes) { runAndCompare<double>(2, -1, 1e-12, 1e-9); }
+
+TEST(jacobi_method_mpi, single_unknown) { runAndCompare<double>(1, -1, 1e-12, 1e-9); }
+
+TEST(jacobi_method_mpi, tridiagonal_band) { runAndCompare<double>(100, 1, 1e-12, 1e-9); }
+
+TEST(jacobi_method_mpi, wide_band) { runAndCompare<double>(64, 5, 1e-12, 1e-9); }
+
+// Blocks smaller than the band fall back to the all-gather exchange.
+TEST(jacobi_method_mpi, band_wider_than_blocks) { runAndCompare<double>(9, 4, 1e-12, 1e-9); }
+
+TEST(jacobi_method_mpi, diagonal_matrix) { runAndCompare<double>(30, 0, 1e-12, 1e-9); }
+
+TEST(jacobi_method_mpi, exact_check_every_sweep_on_band) {
+  runAndCompare<double>(100, 2, 1e-12, 1e-9, {1, ppc::mpi::CheckMode::Exact});
+}
+
+TEST(jacobi_method_mpi, exact_check_every_fourth_sweep) {
+  runAndCompare<double>(100, 2, 1e-12, 1e-9, {4, ppc::mpi::CheckMode::Exact});
+}
+
+TEST(jacobi_method_mpi, speculative_check_on_band) {
+  runAndCompare<double>(100, 2, 1e-12, 1e-9, {1, ppc::mpi::CheckMode::Speculative});
+}
+
+TEST(jacobi_method_mpi, speculative_check_every_third_sweep) {
+  runAndCompare<double>(100, 1, 1e-12, 1e-9, {3, ppc::mpi::CheckMode::Speculative});
+}
+
+TEST(jacobi_method_mpi, checks_every_fifth_sweep_on_dense) {
+  runAndCompare<double>(40, -1, 1e-12, 1e-9, {5, ppc::mpi::CheckMode::Speculative});
+}
+
+TEST(jacobi_method_mpi, csr_tridiagonal) { runSparseAndCompare(100, 1, ppc::mpi::SpmvFormat::Csr); }
+
+TEST(jacobi_method_mpi, csr_dense_pattern) { runSparseAndCompare(30, -1, ppc::mpi::SpmvFormat::Csr); }
+
+TEST(jacobi_method_mpi, csr_fewer_rows_than_processes) { runSparseAndCompare(2, 1, ppc::mpi::SpmvFormat::Csr); }
+
+TEST(jacobi_method_mpi, sell_band) { runSparseAndCompare(90, 4, ppc::mpi::SpmvFormat::Sell); }
+
+TEST(jacobi_method_mpi, stops_after_max_iterations) {
+  boost::mpi::communicator world;
+  const int n = 20;
+  const jacobi_method_mpi::JacobiParams<double> params{1e-300, 3};
+  System<double> system;
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem<double>(n);
+    taskDataPar = makeTaskData(
+        n, {reinterpret_cast<uint8_t*>(system.a.data()), reinterpret_cast<uint8_t*>(system.b.data())},
+        reinterpret_cast<uint8_t*>(x.data()));
+  }
+  jacobi_method_mpi::JacobiParallel<double> testMpiTaskParallel(taskDataPar, params);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+  EXPECT_EQ(testMpiTaskParallel.iterations(), 3);
+  EXPECT_FALSE(testMpiTaskParallel.stats().converged);
+}
+
+TEST(jacobi_method_mpi, validation_fails_on_zero_diagonal) {
+  boost::mpi::communicator world;
+  std::vector<double> a = {1.0, 2.0, 3.0, 0.0};
+  std::vector<double> b = {1.0, 1.0};
+  std::vector<double> x(2);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(2, {reinterpret_cast<uint8_t*>(a.data()), reinterpret_cast<uint8_t*>(b.data())},
+                               reinterpret_cast<uint8_t*>(x.data()));
+  }
+  jacobi_method_mpi::JacobiParallel<double> testMpiTaskParallel(taskDataPar, {1e-9, 100});
+  if (world.rank() == 0) {
+    EXPECT_FALSE(testMpiTaskParallel.validation());
+  }
+}
+
+TEST(jacobi_method_mpi, validation_fails_on_bad_params) {
+  boost::mpi::communicator world;
+  std::vector<double> a = {2.0, 1.0, 1.0, 2.0};
+  std::vector<double> b = {1.0, 1.0};
+  std::vector<double> x(2);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(2, {reinterpret_cast<uint8_t*>(a.data()), reinterpret_cast<uint8_t*>(b.data())},
+                               reinterpret_cast<uint8_t*>(x.data()));
+  }
+  jacobi_method_mpi::JacobiParallel<double> zero_eps(taskDataPar, {0.0, 100});
+  jacobi_method_mpi::JacobiParallel<double> no_iterations(taskDataPar, {1e-9, 0});
+  if (world.rank() == 0) {
+    EXPECT_FALSE(zero_eps.validation());
+    EXPECT_FALSE(no_iterations.validation());
+  }
+}
+
+TEST(jacobi_method_mpi, validation_fails_on_size_mismatch) {
+  boost::mpi::communicator world;
+  std::vector<double> a = {2.0, 1.0, 1.0, 2.0};
+  std::vector<double> b = {1.0, 1.0};
+  std::vector<double> x(2);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(2, {reinterpret_cast<uint8_t*>(a.data()), reinterpret_cast<uint8_t*>(b.data())},
+                               reinterpret_cast<uint8_t*>(x.data()));
+    taskDataPar->outputs_count[0] = 3;
+  }
+  jacobi_method_mpi::JacobiParallel<double> testMpiTaskParallel(taskDataPar, {1e-9, 100});
+  if (world.rank() == 0) {
+    EXPECT_FALSE(testMpiTaskParallel.validation());
+  }
+}
+
+TEST(jacobi_method_mpi, validation_fails_on_csr_without_diagonal) {
+  boost::mpi::communicator world;
+  // [[2, 1], [1, 0]]: row 1 stores no diagonal entry.
+  std::vector<int> row_ptr = {0, 2, 3};
+  std::vector<int> col_idx = {0, 1, 0};
+  std::vector<double> values = {2.0, 1.0, 1.0};
+  std::vector<double> b = {1.0, 1.0};
+  std::vector<double> x(2);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs = {reinterpret_cast<uint8_t*>(row_ptr.data()), reinterpret_cast<uint8_t*>(col_idx.data()),
+                           reinterpret_cast<uint8_t*>(values.data()), reinterpret_cast<uint8_t*>(b.data())};
+    taskDataPar->inputs_count = {3, 3, 3, 2};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+    taskDataPar->outputs_count.emplace_back(2);
+  }
+  jacobi_method_mpi::JacobiParallel<double> testMpiTaskParallel(taskDataPar, {1e-9, 100});
+  if (world.rank() == 0) {
+    EXPECT_FALSE(testMpiTaskParallel.validation());
+  }
+}
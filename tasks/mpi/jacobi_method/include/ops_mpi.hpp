@@ -0,0 +1,235 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/dot_product.hpp"
+#include "core/kernels/include/sparse.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/convergence.hpp"
+#include "mpi/common/include/jacobi.hpp"
+#include "mpi/common/include/sparse.hpp"
+
+namespace jacobi_method_mpi {
+
+// Stopping rule shared by both tasks: sweep until max |x' - x| <= eps or
+// max_iterations sweeps have been done. The test is made every
+// check.interval sweeps; check.mode only matters for the parallel task (see
+// ppc::mpi::ConvergencePolicy), as does sparse_format, the storage its
+// product uses for CSR input.
+template <class T>
+struct JacobiParams {
+  T eps;
+  int max_iterations;
+  ppc::mpi::ConvergencePolicy check{};
+  ppc::mpi::SpmvFormat sparse_format = ppc::mpi::SpmvFormat::Csr;
+};
+
+// Input, A with a non-zero diagonal given either
+//  dense: inputs = {A (n x n, row-major), b (n values)}, inputs_count = {n, n};
+//  CSR:   inputs = {row_ptr (n + 1 int32), col_idx (nnz int32), values (nnz),
+//         b}, inputs_count = {n + 1, nnz, nnz, n}.
+// Output: outputs[0] receives x (n values).
+// Convergence is only guaranteed for diagonally dominant A; that is left to the
+// caller, validation only checks what the iteration cannot run without.
+template <class T>
+bool isValidTaskData(const ppc::core::TaskData& taskData, const JacobiParams<T>& params) {
+  if (taskData.outputs.size() != 1 || taskData.outputs_count.size() != 1 || !(params.eps > T{}) ||
+      params.max_iterations <= 0) {
+    return false;
+  }
+  if (taskData.inputs.size() == 4 && taskData.inputs_count.size() == 4) {
+    const size_t n = taskData.inputs_count[3];
+    const size_t nnz = taskData.inputs_count[1];
+    if (n == 0 || taskData.inputs_count[0] != n + 1 || taskData.inputs_count[2] != nnz ||
+        taskData.outputs_count[0] != n) {
+      return false;
+    }
+    const auto* row_ptr = reinterpret_cast<const int*>(taskData.inputs[0]);
+    const auto* col_idx = reinterpret_cast<const int*>(taskData.inputs[1]);
+    const auto* values = reinterpret_cast<const T*>(taskData.inputs[2]);
+    if (!ppc::core::kernels::isValidCsr(n, n, nnz, row_ptr, col_idx)) return false;
+    for (size_t i = 0; i < n; i++) {
+      const int* last = col_idx + row_ptr[i + 1];
+      const int* diagonal = std::lower_bound(col_idx + row_ptr[i], last, static_cast<int>(i));
+      if (diagonal == last || *diagonal != static_cast<int>(i) || values[diagonal - col_idx] == T{}) return false;
+    }
+    return true;
+  }
+  if (taskData.inputs.size() != 2 || taskData.inputs_count.size() != 2 || taskData.inputs_count[0] == 0 ||
+      taskData.inputs_count[0] != taskData.inputs_count[1] || taskData.outputs_count[0] != taskData.inputs_count[0]) {
+    return false;
+  }
+  const size_t n = taskData.inputs_count[0];
+  const auto* a = reinterpret_cast<const T*>(taskData.inputs[0]);
+  for (size_t i = 0; i < n; i++) {
+    if (a[i * n + i] == T{}) return false;
+  }
+  return true;
+}
+
+template <class T>
+class JacobiSequential : public ppc::core::Task {
+  static_assert(std::is_floating_point_v<T>);
+
+ public:
+  explicit JacobiSequential(std::shared_ptr<ppc::core::TaskData> taskData_, JacobiParams<T> params_)
+      : Task(std::move(taskData_)), params(params_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    sparse_ = taskData->inputs.size() == 4;
+    if (sparse_) {
+      n = taskData->inputs_count[3];
+      const size_t nnz = taskData->inputs_count[1];
+      auto* row_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
+      auto* col_idx = reinterpret_cast<int*>(taskData->inputs[1]);
+      auto* values = reinterpret_cast<T*>(taskData->inputs[2]);
+      csr_.rows = csr_.cols = n;
+      csr_.row_ptr.assign(row_ptr, row_ptr + n + 1);
+      csr_.col_idx.assign(col_idx, col_idx + nnz);
+      csr_.values.assign(values, values + nnz);
+    } else {
+      n = taskData->inputs_count[0];
+      auto* a = reinterpret_cast<T*>(taskData->inputs[0]);
+      a_.assign(a, a + n * n);
+    }
+    auto* b = reinterpret_cast<T*>(taskData->inputs.back());
+    b_.assign(b, b + n);
+    diagonal_.resize(n);
+    for (size_t i = 0; i < n; i++) {
+      diagonal_[i] = sparse_ ? csr_.at(i, i) : a_[i * n + i];
+    }
+    x_.assign(n, T{});
+    x_next_.resize(n);
+    ax_.resize(n);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return isValidTaskData(*taskData, params);
+  }
+
+  bool run() override {
+    internal_order_test();
+    using Acc = ppc::core::kernels::DotAccumulatorT<T>;
+    const int interval = std::max(1, params.check.interval);
+    iterations_ = 0;
+    while (iterations_ < params.max_iterations) {
+      iterations_++;
+      if (sparse_) {
+        ppc::core::kernels::spmv(csr_, x_.data(), ax_.data());
+      } else {
+        ppc::core::kernels::dotMany(x_.data(), a_.data(), n, n, ax_.data());
+      }
+      T change{};
+      for (size_t i = 0; i < n; i++) {
+        x_next_[i] = x_[i] + static_cast<T>((static_cast<Acc>(b_[i]) - ax_[i]) / diagonal_[i]);
+        change = std::max(change, std::abs(x_next_[i] - x_[i]));
+      }
+      std::swap(x_, x_next_);
+      if (iterations_ % interval == 0 && change <= params.eps) break;
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(x_.begin(), x_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    return true;
+  }
+
+  [[nodiscard]] int iterations() const { return iterations_; }
+
+ private:
+  JacobiParams<T> params;
+  bool sparse_{};
+  std::vector<T> a_;
+  ppc::core::kernels::CsrMatrix<T> csr_;
+  std::vector<T> diagonal_;
+  std::vector<T> b_;
+  std::vector<T> x_;
+  std::vector<T> x_next_;
+  std::vector<ppc::core::kernels::DotAccumulatorT<T>> ax_;
+  size_t n{};
+  int iterations_{};
+};
+
+// Same contract as JacobiSequential, iterated by ppc::mpi::JacobiEngine: block
+// rows of A stay on their process for the whole solve and every sweep costs one
+// MPI_Allgatherv. A non-negative bandwidth_ promises a[i][j] == 0 for
+// |i - j| > bandwidth_; only the band is distributed and, when the blocks are
+// large enough, the sweeps exchange just the band boundaries with neighbours.
+// CSR input keeps only the own rows and exchanges only the entries of x they
+// touch (bandwidth_ is then ignored).
+template <class T>
+class JacobiParallel : public ppc::core::Task {
+ public:
+  explicit JacobiParallel(std::shared_ptr<ppc::core::TaskData> taskData_, JacobiParams<T> params_,
+                          int bandwidth_ = -1)
+      : Task(std::move(taskData_)), params(params_), bandwidth(bandwidth_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    // {n, 1 for CSR input}
+    std::array<int, 2> shape{};
+    if (world.rank() == 0) {
+      const bool csr = taskData->inputs.size() == 4;
+      shape = {static_cast<int>(taskData->inputs_count[csr ? 3 : 0]), csr ? 1 : 0};
+    }
+    broadcast(world, shape.data(), 2, 0);
+    engine_.emplace(world, shape[0], bandwidth);
+    const auto input = [&](size_t index) { return world.rank() == 0 ? taskData->inputs[index] : nullptr; };
+    if (shape[1] != 0) {
+      engine_->distributeCsr(reinterpret_cast<int*>(input(0)), reinterpret_cast<int*>(input(1)),
+                             reinterpret_cast<T*>(input(2)), reinterpret_cast<T*>(input(3)), params.sparse_format);
+    } else {
+      engine_->distribute(reinterpret_cast<T*>(input(0)), reinterpret_cast<T*>(input(1)));
+    }
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return isValidTaskData(*taskData, params);
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    engine_->solve(params.eps, params.max_iterations, params.check);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    engine_->gather(world.rank() == 0 ? reinterpret_cast<T*>(taskData->outputs[0]) : nullptr);
+    return true;
+  }
+
+  [[nodiscard]] int iterations() const { return engine_->iterations(); }
+  // Iterations, checks, wasted sweeps and wall time of run().
+  [[nodiscard]] const ppc::mpi::SolveStats& stats() const { return engine_->stats(); }
+
+ private:
+  std::optional<ppc::mpi::JacobiEngine<T>> engine_;
+  JacobiParams<T> params;
+  int bandwidth;
+  boost::mpi::communicator world;
+};
+
+}  // namespace jacobi_method_mpi
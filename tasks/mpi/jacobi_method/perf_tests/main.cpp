@@ -0,0 +1,77 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/jacobi_method/include/ops_mpi.hpp"
+
+namespace {
+
+// a[i][i] = 4n and 1 elsewhere with b chosen for x = (1, ..., 1): the iteration
+// matrix has norm below 1/4, so the tolerance is reached after 22 sweeps of
+// n^2 multiply-adds each.
+const int kSize = 8192;
+
+void runPerf(bool pipeline) {
+  boost::mpi::communicator world;
+  const jacobi_method_mpi::JacobiParams<double> params{1e-12, 100};
+  std::vector<double> a;
+  std::vector<double> b;
+  std::vector<double> x;
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    a.assign(static_cast<size_t>(kSize) * kSize, 1.0);
+    for (int i = 0; i < kSize; i++) {
+      a[static_cast<size_t>(i) * kSize + i] = 4.0 * kSize;
+    }
+    b.assign(kSize, 5.0 * kSize - 1.0);
+    x.resize(kSize);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+    taskDataPar->inputs_count = {kSize, kSize};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+    taskDataPar->outputs_count.emplace_back(x.size());
+  }
+
+  auto testMpiTaskParallel = std::make_shared<jacobi_method_mpi::JacobiParallel<double>>(taskDataPar, params);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  // The sweep count is fixed by the system; it is checked below.
+  const int sweeps = 22;
+  perfAttr->flops_per_run = 2ULL * kSize * kSize * sweeps;
+  perfAttr->bytes_per_run = static_cast<uint64_t>(kSize) * kSize * sizeof(double) * sweeps;
+  perfAttr->data_type = ppc::core::kernels::typeName<double>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    EXPECT_EQ(testMpiTaskParallel->iterations(), sweeps);
+    for (int i = 0; i < kSize; i++) {
+      ASSERT_NEAR(x[i], 1.0, 1e-10);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(jacobi_method_mpi_perf_test, test_pipeline_run) { runPerf(true); }
+
+TEST(jacobi_method_mpi_perf_test, test_task_run) { runPerf(false); }
@@ -0,0 +1,412 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/testing/include/compare.hpp"
+#include "mpi/lu_decomposition/include/ops_mpi.hpp"
+
+namespace {
+
+// Random n x n system with a known solution. The entries are uniform in
+// [-1, 1] with no diagonal boost, so partial pivoting does real row swaps.
+struct System {
+  std::vector<double> a;
+  std::vector<double> b;
+  std::vector<double> solution;
+};
+
+System makeSystem(int n) {
+  std::random_device dev;
+  std::mt19937 gen(dev());
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  System system;
+  system.a.resize(static_cast<size_t>(n) * n);
+  system.solution.resize(n);
+  for (auto& value : system.a) value = dist(gen);
+  for (auto& value : system.solution) value = dist(gen);
+  system.b.assign(n, 0.0);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      system.b[i] += system.a[i * n + j] * system.solution[j];
+    }
+  }
+  return system;
+}
+
+std::shared_ptr<ppc::core::TaskData> makeTaskData(int n, System& system, std::vector<double>& x) {
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs = {reinterpret_cast<uint8_t*>(system.a.data()), reinterpret_cast<uint8_t*>(system.b.data())};
+  taskData->inputs_count = {static_cast<uint32_t>(n), static_cast<uint32_t>(system.b.size())};
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+  taskData->outputs_count.emplace_back(x.size());
+  return taskData;
+}
+
+void runAndCompare(int n, lu_decomposition_mpi::LuParams params) {
+  boost::mpi::communicator world;
+  System system;
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(n);
+    taskDataPar = makeTaskData(n, system, x);
+  }
+
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar, params);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+
+  if (world.rank() == 0) {
+    std::vector<double> reference(n);
+    auto taskDataSeq = ppc::core::testing::withOutputs(taskDataPar, {reinterpret_cast<uint8_t*>(reference.data())});
+    lu_decomposition_mpi::LuSequential<double> testMpiTaskSequential(taskDataSeq, params);
+    ppc::core::testing::runTask(testMpiTaskSequential);
+
+    for (int i = 0; i < n; i++) {
+      ASSERT_NEAR(x[i], system.solution[i], 1e-8);
+      ASSERT_NEAR(reference[i], system.solution[i], 1e-8);
+    }
+    EXPECT_EQ(testMpiTaskParallel.determinant().sign, testMpiTaskSequential.determinant().sign);
+    EXPECT_NEAR(testMpiTaskParallel.determinant().log_abs, testMpiTaskSequential.determinant().log_abs, 1e-9);
+    if (params.estimate_condition) {
+      EXPECT_GE(testMpiTaskParallel.condition(), 1.0);
+      EXPECT_NEAR(testMpiTaskParallel.condition(), testMpiTaskSequential.condition(),
+                  1e-6 * testMpiTaskSequential.condition());
+    }
+  }
+}
+
+// nrhs right-hand sides for system.a, side by side in system.b, with
+// solutions (j + 1) * system.solution.
+void addRightHandSides(int n, int nrhs, System& system) {
+  system.b.assign(static_cast<size_t>(n) * nrhs, 0.0);
+  for (int i = 0; i < n; i++) {
+    double row = 0.0;
+    for (int j = 0; j < n; j++) row += system.a[i * n + j] * system.solution[j];
+    for (int r = 0; r < nrhs; r++) system.b[i * nrhs + r] = (r + 1) * row;
+  }
+}
+
+// run() factorises A and solves for X in place; with run() called twice, as
+// the perf harness does, the second call must start over from A and B rather
+// than from the factors and solution of the first.
+void runTwice(lu_decomposition_mpi::LuParams params) {
+  boost::mpi::communicator world;
+  const int n = 40;
+  const int nrhs = 3;
+  System system;
+  std::vector<double> x(n * nrhs);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(n);
+    addRightHandSides(n, nrhs, system);
+    taskDataPar = makeTaskData(n, system, x);
+  }
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar, params);
+  ppc::core::testing::runTask(testMpiTaskParallel, 2);
+
+  if (world.rank() == 0) {
+    std::vector<double> reference(n * nrhs);
+    auto taskDataSeq = ppc::core::testing::withOutputs(taskDataPar, {reinterpret_cast<uint8_t*>(reference.data())});
+    lu_decomposition_mpi::LuSequential<double> testMpiTaskSequential(taskDataSeq, params);
+    ppc::core::testing::runTask(testMpiTaskSequential, 2);
+    for (int i = 0; i < n; i++) {
+      for (int r = 0; r < nrhs; r++) {
+        ASSERT_NEAR(x[i * nrhs + r], (r + 1) * system.solution[i], 1e-8);
+        ASSERT_NEAR(reference[i * nrhs + r], (r + 1) * system.solution[i], 1e-8);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(lu_decomposition_mpi, several_blocks_per_process) { runAndCompare(100, {8, true}); }
+
+TEST(lu_decomposition_mpi, without_lookahead) { runAndCompare(100, {8, false}); }
+
+TEST(lu_decomposition_mpi, partial_last_block) { runAndCompare(61, {7, true}); }
+
+TEST(lu_decomposition_mpi, single_block) { runAndCompare(30, {64, true}); }
+
+TEST(lu_decomposition_mpi, block_of_one) { runAndCompare(25, {1, true}); }
+
+TEST(lu_decomposition_mpi, fewer_blocks_than_processes) { runAndCompare(5, {2, true}); }
+
+TEST(lu_decomposition_mpi, single_unknown) { runAndCompare(1, {4, true}); }
+
+TEST(lu_decomposition_mpi, default_block) { runAndCompare(200, {}); }
+
+TEST(lu_decomposition_mpi, condition_estimate) { runAndCompare(100, {8, true, false, {}, true}); }
+
+TEST(lu_decomposition_mpi, condition_estimate_partial_last_block) { runAndCompare(61, {7, false, false, {}, true}); }
+
+TEST(lu_decomposition_mpi, determinant_of_known_matrix) {
+  boost::mpi::communicator world;
+  // Rows of diag(2, -3, 0.5, 4) in the order 2, 0, 3, 1 (an odd permutation):
+  // det = -(2 * -3 * 0.5 * 4) = 12.
+  const int n = 4;
+  System system;
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system.a = {0.0, 0.0, 0.5, 0.0,  //
+                2.0, 0.0, 0.0, 0.0,  //
+                0.0, 0.0, 0.0, 4.0,  //
+                0.0, -3.0, 0.0, 0.0};
+    system.b = {1.0, 1.0, 1.0, 1.0};
+    taskDataPar = makeTaskData(n, system, x);
+  }
+  lu_decomposition_mpi::LuParams params;
+  params.block = 1;
+  params.estimate_condition = true;
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar, params);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+  EXPECT_NEAR(testMpiTaskParallel.determinant().value(), 12.0, 1e-12);
+  // ||A||_1 = 4, ||A^-1||_1 = 2; the estimate is exact for a scaled
+  // permutation.
+  EXPECT_NEAR(testMpiTaskParallel.condition(), 8.0, 1e-12);
+}
+
+TEST(lu_decomposition_mpi, pivoting_on_zero_diagonal) {
+  // A zero diagonal everywhere: only row swaps make the elimination possible.
+  boost::mpi::communicator world;
+  const int n = 16;
+  System system;
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system.a.assign(n * n, 0.0);
+    for (int i = 0; i < n; i++) {
+      system.a[i * n + (n - 1 - i)] = 1.0 + i;
+      system.a[i * n + (i + 1) % n] += 0.5;
+    }
+    for (int i = 0; i < n; i++) system.a[i * n + i] = 0.0;
+    system.solution.resize(n);
+    system.b.assign(n, 0.0);
+    for (int i = 0; i < n; i++) system.solution[i] = i - 3.0;
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) system.b[i] += system.a[i * n + j] * system.solution[j];
+    }
+    taskDataPar = makeTaskData(n, system, x);
+  }
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar, {3, true});
+  ppc::core::testing::runTask(testMpiTaskParallel);
+  if (world.rank() == 0) {
+    for (int i = 0; i < n; i++) {
+      ASSERT_NEAR(x[i], system.solution[i], 1e-10);
+    }
+  }
+}
+
+TEST(lu_decomposition_mpi, run_fails_on_singular_matrix) {
+  boost::mpi::communicator world;
+  const int n = 12;
+  System system;
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(n);
+    // A zero column stays exactly zero through the elimination, whatever the
+    // grid and block order, so its pivot is exactly zero.
+    for (int i = 0; i < n; i++) system.a[i * n + 7] = 0.0;
+    taskDataPar = makeTaskData(n, system, x);
+  }
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar, {4, true});
+  ASSERT_EQ(testMpiTaskParallel.validation(), true);
+  testMpiTaskParallel.pre_processing();
+  EXPECT_FALSE(testMpiTaskParallel.run());
+  EXPECT_EQ(testMpiTaskParallel.determinant().value(), 0.0);
+}
+
+TEST(lu_decomposition_mpi, batch_of_right_hand_sides) {
+  boost::mpi::communicator world;
+  const int n = 50;
+  const int nrhs = 6;
+  System system;
+  std::vector<double> x(n * nrhs);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(n);
+    addRightHandSides(n, nrhs, system);
+    taskDataPar = makeTaskData(n, system, x);
+  }
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar, {8, true});
+  ppc::core::testing::runTask(testMpiTaskParallel);
+
+  if (world.rank() == 0) {
+    std::vector<double> reference(n * nrhs);
+    auto taskDataSeq = makeTaskData(n, system, reference);
+    lu_decomposition_mpi::LuSequential<double> testMpiTaskSequential(taskDataSeq, {8, true});
+    ppc::core::testing::runTask(testMpiTaskSequential);
+    for (int i = 0; i < n; i++) {
+      for (int r = 0; r < nrhs; r++) {
+        ASSERT_NEAR(x[i * nrhs + r], (r + 1) * system.solution[i], 1e-8);
+        ASSERT_NEAR(reference[i * nrhs + r], (r + 1) * system.solution[i], 1e-8);
+      }
+    }
+  }
+}
+
+TEST(lu_decomposition_mpi, repeated_runs_give_the_same_solution) { runTwice({8, true}); }
+
+TEST(lu_decomposition_mpi, repeated_mixed_precision_runs_give_the_same_solution) { runTwice({8, true, true}); }
+
+TEST(lu_decomposition_mpi, cache_factorises_each_matrix_once) {
+  boost::mpi::communicator world;
+  const int n = 40;
+  System first;
+  System second;
+  if (world.rank() == 0) {
+    first = makeSystem(n);
+    second = makeSystem(n);
+  }
+  auto cache = std::make_shared<ppc::mpi::LuEngineCache<double>>();
+  auto seq_cache = std::make_shared<ppc::core::kernels::LuFactorCache<double>>();
+  // A stream of solves: A1, A1 with another b, A2, A1 again.
+  for (int step = 0; step < 4; step++) {
+    System& system = step == 2 ? second : first;
+    const int nrhs = step + 1;
+    std::vector<double> x(n * nrhs);
+    std::vector<double> reference(n * nrhs);
+    std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+    if (world.rank() == 0) {
+      addRightHandSides(n, nrhs, system);
+      taskDataPar = makeTaskData(n, system, x);
+    }
+    lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar, {8, true}, cache);
+    ppc::core::testing::runTask(testMpiTaskParallel);
+    if (world.rank() == 0) {
+      auto taskDataSeq = makeTaskData(n, system, reference);
+      lu_decomposition_mpi::LuSequential<double> testMpiTaskSequential(taskDataSeq, {8, true}, seq_cache);
+      ppc::core::testing::runTask(testMpiTaskSequential);
+      for (int i = 0; i < n; i++) {
+        for (int r = 0; r < nrhs; r++) {
+          ASSERT_NEAR(x[i * nrhs + r], (r + 1) * system.solution[i], 1e-8);
+          ASSERT_NEAR(reference[i * nrhs + r], (r + 1) * system.solution[i], 1e-8);
+        }
+      }
+    }
+  }
+  EXPECT_EQ(cache->misses(), 2U);
+  EXPECT_EQ(cache->hits(), 2U);
+  if (world.rank() == 0) {
+    EXPECT_EQ(seq_cache->misses(), 2U);
+    EXPECT_EQ(seq_cache->hits(), 2U);
+  }
+}
+
+TEST(lu_decomposition_mpi, mixed_precision_reaches_double_accuracy) {
+  boost::mpi::communicator world;
+  const int n = 90;
+  const int nrhs = 2;
+  System system;
+  std::vector<double> x(n * nrhs);
+  std::vector<double> reference(n * nrhs);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(n);
+    for (int i = 0; i < n; i++) system.a[i * n + i] += 4.0;
+    addRightHandSides(n, nrhs, system);
+    taskDataPar = makeTaskData(n, system, x);
+  }
+  lu_decomposition_mpi::LuParams params{8, true, true};
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar, params);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+  EXPECT_TRUE(testMpiTaskParallel.refinement().converged);
+  EXPECT_FALSE(testMpiTaskParallel.refinement().fell_back);
+  EXPECT_LT(testMpiTaskParallel.refinement().residual, 1e-14);
+
+  if (world.rank() == 0) {
+    auto taskDataSeq = makeTaskData(n, system, reference);
+    lu_decomposition_mpi::LuSequential<double> testMpiTaskSequential(taskDataSeq, params);
+    ppc::core::testing::runTask(testMpiTaskSequential);
+    EXPECT_TRUE(testMpiTaskSequential.refinement().converged);
+    for (int i = 0; i < n; i++) {
+      for (int r = 0; r < nrhs; r++) {
+        ASSERT_NEAR(x[i * nrhs + r], (r + 1) * system.solution[i], 1e-10);
+        ASSERT_NEAR(reference[i * nrhs + r], (r + 1) * system.solution[i], 1e-10);
+      }
+    }
+  }
+}
+
+TEST(lu_decomposition_mpi, mixed_precision_falls_back_when_refinement_stalls) {
+  // Hilbert matrix: condition number near 1e13, beyond float factors.
+  boost::mpi::communicator world;
+  const int n = 10;
+  System system;
+  std::vector<double> x(n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system.a.resize(n * n);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) system.a[i * n + j] = 1.0 / (i + j + 1);
+    }
+    system.b.assign(n, 1.0);
+    taskDataPar = makeTaskData(n, system, x);
+  }
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar, {3, true, true});
+  ppc::core::testing::runTask(testMpiTaskParallel);
+  EXPECT_TRUE(testMpiTaskParallel.refinement().fell_back);
+  EXPECT_LT(testMpiTaskParallel.refinement().residual, 1e-14);
+  if (world.rank() == 0) {
+    for (int i = 0; i < n; i++) {
+      double sum = 0.0;
+      for (int j = 0; j < n; j++) sum += system.a[i * n + j] * x[j];
+      ASSERT_NEAR(sum, 1.0, 1e-8);
+    }
+  }
+}
+
+TEST(lu_decomposition_mpi, validation_fails_on_size_mismatch) {
+  boost::mpi::communicator world;
+  System system;
+  std::vector<double> x(3);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(3);
+    taskDataPar = makeTaskData(3, system, x);
+    taskDataPar->inputs_count[1] = 2;
+  }
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    EXPECT_FALSE(testMpiTaskParallel.validation());
+  }
+}
+
+TEST(lu_decomposition_mpi, validation_fails_on_partial_right_hand_side) {
+  boost::mpi::communicator world;
+  System system;
+  std::vector<double> x(7);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(3);
+    system.b.resize(7);
+    taskDataPar = makeTaskData(3, system, x);
+  }
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    EXPECT_FALSE(testMpiTaskParallel.validation());
+  }
+}
+
+TEST(lu_decomposition_mpi, validation_fails_on_bad_block) {
+  boost::mpi::communicator world;
+  System system;
+  std::vector<double> x(3);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    system = makeSystem(3);
+    taskDataPar = makeTaskData(3, system, x);
+  }
+  lu_decomposition_mpi::LuParallel<double> testMpiTaskParallel(taskDataPar, {0, true});
+  if (world.rank() == 0) {
+    EXPECT_FALSE(testMpiTaskParallel.validation());
+  }
+}
@@ -0,0 +1,215 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/lu.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/lu.hpp"
+
+namespace lu_decomposition_mpi {
+
+// `block`: panel width of the blocked factorisation (and block of the 2D
+// block-cyclic layout of the parallel task). `lookahead` lets the parallel task
+// factorise the next panel before finishing the current trailing update.
+// `mixed_precision` factorises A in float and refines X to the accuracy of T
+// (luSolveMixed()), falling back to a T factorisation if that does not
+// converge; refinement() then reports the outcome. `estimate_condition`
+// estimates the 1-norm condition number of A from the factors after the
+// solve (condition()). determinant() and condition() come from the T factors
+// and are left unset in mixed precision.
+struct LuParams {
+  int block = static_cast<int>(ppc::core::kernels::kLuBlock);
+  bool lookahead = true;
+  bool mixed_precision = false;
+  ppc::core::kernels::RefinementParams refinement;
+  bool estimate_condition = false;
+};
+
+// Solves A X = B through P A = L U. Input: inputs[0] is A (n x n, row-major),
+// inputs[1] is B (n x nrhs, row-major: nrhs right-hand sides side by side),
+// inputs_count = {n, n * nrhs}. Output: outputs[0] receives X (n x nrhs),
+// outputs_count = {n * nrhs}. run() returns false if A is singular.
+//
+// Both tasks optionally take a cache of factorisations shared between task
+// instances: a task given the same A as an earlier one skips the
+// factorisation and only runs the substitutions. The cache holds T factors
+// and is not used in mixed precision.
+inline bool isValidTaskData(const ppc::core::TaskData& taskData, const LuParams& params) {
+  return taskData.inputs.size() == 2 && taskData.inputs_count.size() == 2 && taskData.outputs.size() == 1 &&
+         taskData.outputs_count.size() == 1 && taskData.inputs_count[0] > 0 && taskData.inputs_count[1] > 0 &&
+         taskData.inputs_count[1] % taskData.inputs_count[0] == 0 &&
+         taskData.outputs_count[0] == taskData.inputs_count[1] && params.block > 0;
+}
+
+template <class T>
+class LuSequential : public ppc::core::Task {
+ public:
+  explicit LuSequential(std::shared_ptr<ppc::core::TaskData> taskData_, LuParams params_ = {},
+                        std::shared_ptr<ppc::core::kernels::LuFactorCache<T>> cache_ = nullptr)
+      : Task(std::move(taskData_)), params(params_), cache(std::move(cache_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    n = taskData->inputs_count[0];
+    nrhs = taskData->inputs_count[1] / n;
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return isValidTaskData(*taskData, params);
+  }
+
+  bool run() override {
+    internal_order_test();
+    // X is solved for in place, so every run starts again from B.
+    auto* b = reinterpret_cast<T*>(taskData->inputs[1]);
+    x_.assign(b, b + n * nrhs);
+    const auto* a = reinterpret_cast<T*>(taskData->inputs[0]);
+    if (params.mixed_precision) {
+      return ppc::core::kernels::luSolveMixed<float>(n, a, x_.data(), nrhs, refinement_, params.refinement,
+                                                     params.block, 1);
+    }
+    if (cache) {
+      factors_ = cache->factorise(n, a, params.block);
+    } else {
+      factors_ = std::make_shared<const ppc::core::kernels::LuFactors<T>>(
+          ppc::core::kernels::LuFactors<T>::factorise(n, a, params.block));
+    }
+    determinant_ = factors_->determinant();
+    if (!factors_->regular) return false;
+    factors_->solve(x_.data(), nrhs, 1);
+    if (params.estimate_condition) condition_ = factors_->conditionEstimate();
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(x_.begin(), x_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    return true;
+  }
+
+  [[nodiscard]] const ppc::core::kernels::RefinementResult& refinement() const { return refinement_; }
+
+  // det A from the last run(), zero if A is singular.
+  [[nodiscard]] const ppc::core::kernels::Determinant& determinant() const { return determinant_; }
+
+  // Estimated ||A||_1 ||A^-1||_1 from the last run() with
+  // `estimate_condition`, zero otherwise.
+  [[nodiscard]] double condition() const { return condition_; }
+
+ private:
+  LuParams params;
+  std::shared_ptr<ppc::core::kernels::LuFactorCache<T>> cache;
+  size_t n{};
+  size_t nrhs{};
+  std::shared_ptr<const ppc::core::kernels::LuFactors<T>> factors_;
+  std::vector<T> x_;
+  ppc::core::kernels::RefinementResult refinement_;
+  ppc::core::kernels::Determinant determinant_;
+  double condition_{};
+};
+
+// Same contract; A is factorised by ppc::mpi::LuEngine in a 2D block-cyclic
+// layout and never gathered, and X comes from the distributed triangular
+// solves, all right-hand sides at once. The determinant and condition
+// estimate are by-products of the same distributed factors.
+template <class T>
+class LuParallel : public ppc::core::Task {
+ public:
+  explicit LuParallel(std::shared_ptr<ppc::core::TaskData> taskData_, LuParams params_ = {},
+                      std::shared_ptr<ppc::mpi::LuEngineCache<T>> cache_ = nullptr)
+      : Task(std::move(taskData_)), params(params_), cache(std::move(cache_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    std::array<int, 2> sizes{};
+    if (world.rank() == 0) {
+      sizes = {static_cast<int>(taskData->inputs_count[0]),
+               static_cast<int>(taskData->inputs_count[1] / taskData->inputs_count[0])};
+    }
+    broadcast(world, sizes.data(), 2, 0);
+    n = sizes[0];
+    nrhs = sizes[1];
+    // factorise() overwrites the distributed A, so it is distributed anew in
+    // every run(); with a cache only on a miss, and in mixed precision by
+    // luSolveMixed().
+    if (!cache && !params.mixed_precision) {
+      engine_ = std::make_shared<ppc::mpi::LuEngine<T>>(world, n, params.block);
+    }
+    b_.resize(static_cast<size_t>(n) * nrhs);
+    if (world.rank() == 0) {
+      std::copy_n(reinterpret_cast<T*>(taskData->inputs[1]), b_.size(), b_.begin());
+    }
+    broadcast(world, b_.data(), static_cast<int>(b_.size()), 0);
+    x_.resize(b_.size());
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return isValidTaskData(*taskData, params);
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    const T* a = world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[0]) : nullptr;
+    if (params.mixed_precision) {
+      return ppc::mpi::luSolveMixed<float>(world, n, a, b_.data(), x_.data(), nrhs, refinement_, params.refinement,
+                                           params.block, params.lookahead);
+    }
+    if (cache) {
+      engine_ = cache->factorise(world, n, a, params.block, params.lookahead);
+    } else {
+      engine_->distribute(a);
+      engine_->factorise(params.lookahead);
+    }
+    determinant_ = engine_->determinant();
+    if (!engine_->regular()) return false;
+    engine_->solve(b_.data(), x_.data(), nrhs);
+    if (params.estimate_condition) condition_ = engine_->conditionEstimate();
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      std::copy(x_.begin(), x_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    }
+    return true;
+  }
+
+  // Outcome of the last mixed-precision run(), on every process.
+  [[nodiscard]] const ppc::core::kernels::RefinementResult& refinement() const { return refinement_; }
+
+  // As in LuSequential, on every process.
+  [[nodiscard]] const ppc::core::kernels::Determinant& determinant() const { return determinant_; }
+  [[nodiscard]] double condition() const { return condition_; }
+
+ private:
+  LuParams params;
+  std::shared_ptr<ppc::mpi::LuEngineCache<T>> cache;
+  int n{};
+  int nrhs{};
+  std::shared_ptr<ppc::mpi::LuEngine<T>> engine_;
+  std::vector<T> b_;
+  std::vector<T> x_;
+  ppc::core::kernels::RefinementResult refinement_;
+  ppc::core::kernels::Determinant determinant_;
+  double condition_{};
+  boost::mpi::communicator world;
+};
+
+}  // namespace lu_decomposition_mpi
@@ -0,0 +1,114 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <cstdint>
+#include <ios>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/lu_decomposition/include/ops_mpi.hpp"
+
+namespace {
+
+// Dense random 768 x 768 system without a diagonal boost, so partial pivoting
+// swaps rows; the factorisation is about 2/3 n^3 flops.
+constexpr int kSize = 768;
+
+// Time of one run() of the task on a fresh instance, in seconds.
+double timeRun(const std::shared_ptr<ppc::core::TaskData>& taskData, lu_decomposition_mpi::LuParams params) {
+  boost::mpi::communicator world;
+  lu_decomposition_mpi::LuParallel<double> task(taskData, params);
+  task.validation();
+  task.pre_processing();
+  world.barrier();
+  const boost::mpi::timer timer;
+  task.run();
+  world.barrier();
+  const double elapsed = timer.elapsed();
+  task.post_processing();
+  return elapsed;
+}
+
+void runPerf(bool pipeline, bool mixed_precision = false) {
+  boost::mpi::communicator world;
+  std::vector<double> a;
+  std::vector<double> b;
+  std::vector<double> solution;
+  std::vector<double> x(kSize);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    a.resize(static_cast<size_t>(kSize) * kSize);
+    for (auto& value : a) value = dist(gen);
+    solution.resize(kSize);
+    for (auto& value : solution) value = dist(gen);
+    b.assign(kSize, 0.0);
+    for (int i = 0; i < kSize; i++) {
+      for (int j = 0; j < kSize; j++) b[i] += a[i * kSize + j] * solution[j];
+    }
+    taskDataPar->inputs = {reinterpret_cast<uint8_t*>(a.data()), reinterpret_cast<uint8_t*>(b.data())};
+    taskDataPar->inputs_count = {kSize, kSize};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+    taskDataPar->outputs_count.emplace_back(kSize);
+  }
+
+  lu_decomposition_mpi::LuParams params;
+  params.mixed_precision = mixed_precision;
+  auto testMpiTaskParallel = std::make_shared<lu_decomposition_mpi::LuParallel<double>>(taskDataPar, params);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->flops_per_run = 2ULL * kSize * kSize * kSize / 3;
+  perfAttr->data_type = ppc::core::kernels::typeName<double>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    for (int i = 0; i < kSize; i++) {
+      ASSERT_NEAR(x[i], solution[i], 1e-7);
+    }
+  }
+  if (mixed_precision) {
+    const auto& refinement = testMpiTaskParallel->refinement();
+    EXPECT_TRUE(refinement.converged);
+    // Speedup of the float factorisation plus refinement over the plain
+    // double solve, one run() of each. Both cover distributing A, factorising
+    // and solving (B is broadcast in pre_processing() by both); the mixed run
+    // also distributes the double A its residuals need.
+    const double plain = timeRun(taskDataPar, {});
+    const double mixed = timeRun(taskDataPar, params);
+    if (world.rank() == 0) {
+      std::cout << "mixed precision: " << refinement.iterations << " refinement steps, backward error "
+                << std::scientific << refinement.residual << std::fixed << ", run() speedup " << plain / mixed << '\n';
+    }
+  }
+}
+
+}  // namespace
+
+TEST(lu_decomposition_mpi_perf_test, test_pipeline_run) { runPerf(true); }
+
+TEST(lu_decomposition_mpi_perf_test, test_task_run) { runPerf(false); }
+
+TEST(lu_decomposition_mpi_perf_test, test_pipeline_run_mixed_precision) { runPerf(true, true); }
+
+TEST(lu_decomposition_mpi_perf_test, test_task_run_mixed_precision) { runPerf(false, true); }
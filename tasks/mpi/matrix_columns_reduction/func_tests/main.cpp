@@ -0,0 +1,150 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/testing/include/compare.hpp"
+#include "mpi/matrix_columns_reduction/include/ops_mpi.hpp"
+
+namespace {
+
+template <class T = int>
+void runAndCompare(int rows, int cols, const std::string& ops,
+                   matrix_columns_reduction_mpi::Distribution distribution) {
+  boost::mpi::communicator world;
+  std::vector<T> matrix;
+  std::vector<T> global_res(cols, 0);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    matrix = matrix_columns_reduction_mpi::getRandomMatrix<T>(rows, cols);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(matrix.data()));
+    taskDataPar->inputs_count.emplace_back(rows);
+    taskDataPar->inputs_count.emplace_back(cols);
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_res.data()));
+    taskDataPar->outputs_count.emplace_back(global_res.size());
+  }
+
+  matrix_columns_reduction_mpi::ColumnsReductionParallel<T> testMpiTaskParallel(taskDataPar, ops, distribution);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+
+  if (world.rank() == 0) {
+    ppc::core::testing::expectSameAsReference<matrix_columns_reduction_mpi::ColumnsReductionSequential<T>, T>(
+        taskDataPar, ops);
+  }
+}
+
+}  // namespace
+
+TEST(matrix_columns_reduction_mpi, row_blocks_min) {
+  runAndCompare(40, 30, "min", matrix_columns_reduction_mpi::Distribution::RowBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, row_blocks_max) {
+  runAndCompare(40, 30, "max", matrix_columns_reduction_mpi::Distribution::RowBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, row_blocks_sum) {
+  runAndCompare(40, 30, "+", matrix_columns_reduction_mpi::Distribution::RowBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, row_blocks_fewer_rows_than_processes) {
+  runAndCompare(1, 17, "min", matrix_columns_reduction_mpi::Distribution::RowBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, column_blocks_min) {
+  runAndCompare(40, 30, "min", matrix_columns_reduction_mpi::Distribution::ColumnBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, column_blocks_max) {
+  runAndCompare(23, 57, "max", matrix_columns_reduction_mpi::Distribution::ColumnBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, column_blocks_sum) {
+  runAndCompare(57, 23, "+", matrix_columns_reduction_mpi::Distribution::ColumnBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, column_blocks_fewer_columns_than_processes) {
+  runAndCompare(19, 1, "max", matrix_columns_reduction_mpi::Distribution::ColumnBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, row_blocks_int8_max) {
+  runAndCompare<int8_t>(33, 21, "max", matrix_columns_reduction_mpi::Distribution::RowBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, row_blocks_int16_min) {
+  runAndCompare<int16_t>(41, 19, "min", matrix_columns_reduction_mpi::Distribution::RowBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, column_blocks_int16_sum) {
+  runAndCompare<int16_t>(41, 19, "+", matrix_columns_reduction_mpi::Distribution::ColumnBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, row_blocks_int64_sum) {
+  runAndCompare<int64_t>(25, 26, "+", matrix_columns_reduction_mpi::Distribution::RowBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, row_blocks_float_max) {
+  runAndCompare<float>(30, 40, "max", matrix_columns_reduction_mpi::Distribution::RowBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, row_blocks_double_min) {
+  runAndCompare<double>(30, 40, "min", matrix_columns_reduction_mpi::Distribution::RowBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, column_blocks_double_max) {
+  runAndCompare<double>(17, 45, "max", matrix_columns_reduction_mpi::Distribution::ColumnBlocks);
+}
+
+TEST(matrix_columns_reduction_mpi, repeated_runs_start_from_identity) {
+  boost::mpi::communicator world;
+  std::vector<int> matrix = {1, 2, 3, 4, 5, 6};
+  std::vector<int> global_res(3, 0);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(matrix.data()));
+    taskDataPar->inputs_count.emplace_back(2);
+    taskDataPar->inputs_count.emplace_back(3);
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_res.data()));
+    taskDataPar->outputs_count.emplace_back(global_res.size());
+  }
+  matrix_columns_reduction_mpi::ColumnsReductionParallel<int> testMpiTaskParallel(taskDataPar, "+");
+  ppc::core::testing::runTask(testMpiTaskParallel, 2);
+  if (world.rank() == 0) {
+    EXPECT_EQ(global_res, std::vector<int>({5, 7, 9}));
+    std::vector<int> reference(3, 0);
+    matrix_columns_reduction_mpi::ColumnsReductionSequential<int> testMpiTaskSequential(
+        ppc::core::testing::withOutputs(taskDataPar, {reinterpret_cast<uint8_t*>(reference.data())}), "+");
+    ppc::core::testing::runTask(testMpiTaskSequential, 2);
+    EXPECT_EQ(reference, std::vector<int>({5, 7, 9}));
+  }
+}
+
+TEST(matrix_columns_reduction_mpi, validation_fails_on_wrong_output_size) {
+  boost::mpi::communicator world;
+  std::vector<int> matrix(12, 1);
+  std::vector<int> global_res(3, 0);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(matrix.data()));
+    taskDataPar->inputs_count.emplace_back(3);
+    taskDataPar->inputs_count.emplace_back(4);
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_res.data()));
+    taskDataPar->outputs_count.emplace_back(global_res.size());
+  }
+  matrix_columns_reduction_mpi::ColumnsReductionParallel<int> testMpiTaskParallel(taskDataPar, "min");
+  if (world.rank() == 0) {
+    ASSERT_EQ(testMpiTaskParallel.validation(), false);
+  }
+}
+
+TEST(matrix_columns_reduction_mpi, validation_fails_on_unknown_ops) {
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  matrix_columns_reduction_mpi::ColumnsReductionParallel<int> testMpiTaskParallel(taskDataPar, "*");
+  ASSERT_EQ(testMpiTaskParallel.validation(), false);
+}
@@ -0,0 +1,264 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+
+namespace matrix_columns_reduction_mpi {
+
+// How the row-major matrix is split between processes. Both modes send the
+// matrix from rank 0 in its native layout, nothing is transposed or repacked
+// on the root.
+//  RowBlocks    - contiguous blocks of rows (MPI_Scatterv over a row datatype),
+//                 every rank reduces its block into a partial row of length
+//                 cols, partial rows are combined with a single MPI_Reduce.
+//  ColumnBlocks - blocks of columns described by an MPI_Type_vector per rank,
+//                 every rank receives whole columns, reduces them locally and
+//                 the results are collected with MPI_Gatherv.
+enum class Distribution { RowBlocks, ColumnBlocks };
+
+template <class T>
+std::vector<T> getRandomMatrix(int rows, int cols) {
+  std::random_device dev;
+  std::mt19937 gen(dev());
+  std::vector<T> matrix(static_cast<size_t>(rows) * cols);
+  if constexpr (std::is_floating_point_v<T>) {
+    std::uniform_real_distribution<T> dist(-1000, 1000);
+    for (auto& value : matrix) value = dist(gen);
+  } else {
+    std::uniform_int_distribution<int> dist(-100, 100);
+    for (auto& value : matrix) value = static_cast<T>(dist(gen));
+  }
+  return matrix;
+}
+
+namespace detail {
+
+inline bool isSupportedOps(const std::string& ops) { return ops == "+" || ops == "min" || ops == "max"; }
+
+template <class T>
+T identityOf(const std::string& ops) {
+  if (ops == "min") return std::numeric_limits<T>::max();
+  if (ops == "max") return std::numeric_limits<T>::lowest();
+  return T{};
+}
+
+inline MPI_Op mpiOpOf(const std::string& ops) {
+  if (ops == "min") return MPI_MIN;
+  if (ops == "max") return MPI_MAX;
+  return MPI_SUM;
+}
+
+// Folds `nrows` contiguous rows into `acc`. The inner loop walks a row with unit
+// stride, so the compiler vectorises it with as many lanes as T allows.
+template <class T, class Op>
+void foldRows(const T* data, int nrows, int ncols, T* acc, Op op) {
+  for (int i = 0; i < nrows; i++) {
+    const T* row = data + static_cast<size_t>(i) * ncols;
+    for (int j = 0; j < ncols; j++) {
+      acc[j] = op(acc[j], row[j]);
+    }
+  }
+}
+
+template <class T>
+void foldRows(const std::string& ops, const T* data, int nrows, int ncols, T* acc) {
+  if (ops == "min") {
+    foldRows(data, nrows, ncols, acc, [](T a, T b) { return std::min(a, b); });
+  } else if (ops == "max") {
+    foldRows(data, nrows, ncols, acc, [](T a, T b) { return std::max(a, b); });
+  } else {
+    foldRows(data, nrows, ncols, acc, [](T a, T b) { return static_cast<T>(a + b); });
+  }
+}
+
+inline bool isValidTaskData(const ppc::core::TaskData& taskData) {
+  return taskData.inputs.size() == 1 && taskData.inputs_count.size() == 2 && taskData.inputs_count[0] > 0 &&
+         taskData.inputs_count[1] > 0 && taskData.outputs_count.size() == 1 &&
+         taskData.outputs_count[0] == taskData.inputs_count[1];
+}
+
+}  // namespace detail
+
+// Input: inputs[0] is a rows x cols row-major matrix of T, inputs_count = {rows, cols}.
+// Output: outputs[0] receives cols values. ops is "+", "min" or "max"; sums are
+// accumulated in T, as MPI_SUM does.
+template <class T>
+class ColumnsReductionSequential : public ppc::core::Task {
+ public:
+  explicit ColumnsReductionSequential(std::shared_ptr<ppc::core::TaskData> taskData_, std::string ops_)
+      : Task(std::move(taskData_)), ops(std::move(ops_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    rows = static_cast<int>(taskData->inputs_count[0]);
+    cols = static_cast<int>(taskData->inputs_count[1]);
+    auto* tmp_ptr = reinterpret_cast<T*>(taskData->inputs[0]);
+    input_.assign(tmp_ptr, tmp_ptr + static_cast<size_t>(rows) * cols);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return detail::isSupportedOps(ops) && detail::isValidTaskData(*taskData);
+  }
+
+  bool run() override {
+    internal_order_test();
+    res_.assign(cols, detail::identityOf<T>(ops));
+    detail::foldRows(ops, input_.data(), rows, cols, res_.data());
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(res_.begin(), res_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    return true;
+  }
+
+ private:
+  std::vector<T> input_;
+  std::vector<T> res_;
+  int rows{};
+  int cols{};
+  std::string ops;
+};
+
+template <class T>
+class ColumnsReductionParallel : public ppc::core::Task {
+ public:
+  explicit ColumnsReductionParallel(std::shared_ptr<ppc::core::TaskData> taskData_, std::string ops_,
+                                    Distribution distribution_ = Distribution::RowBlocks)
+      : Task(std::move(taskData_)), ops(std::move(ops_)), distribution(distribution_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      rows = static_cast<int>(taskData->inputs_count[0]);
+      cols = static_cast<int>(taskData->inputs_count[1]);
+    }
+    broadcast(world, rows, 0);
+    broadcast(world, cols, 0);
+
+    if (distribution == Distribution::RowBlocks) {
+      scatter_row_blocks();
+    } else {
+      scatter_column_blocks();
+    }
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (!detail::isSupportedOps(ops)) {
+      return false;
+    }
+    if (world.rank() == 0) {
+      return detail::isValidTaskData(*taskData);
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    const int local_count = partition_.counts[world.rank()];
+    res_.assign(world.rank() == 0 ? cols : 0, T{});
+
+    if (distribution == Distribution::RowBlocks) {
+      local_res_.assign(cols, detail::identityOf<T>(ops));
+      detail::foldRows(ops, local_input_.data(), local_count, cols, local_res_.data());
+      MPI_Reduce(local_res_.data(), res_.data(), cols, ppc::mpi::mpiTypeOf<T>(), detail::mpiOpOf(ops), 0, world);
+    } else {
+      local_res_.assign(local_count, detail::identityOf<T>(ops));
+      detail::foldRows(ops, local_input_.data(), rows, local_count, local_res_.data());
+      MPI_Gatherv(local_res_.data(), local_count, ppc::mpi::mpiTypeOf<T>(), res_.data(), partition_.counts.data(),
+                  partition_.displs.data(), ppc::mpi::mpiTypeOf<T>(), 0, world);
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      std::copy(res_.begin(), res_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    }
+    return true;
+  }
+
+ private:
+  void scatter_row_blocks() {
+    partition_ = ppc::mpi::BlockPartition(rows, world.size());
+    const int local_rows = partition_.counts[world.rank()];
+    local_input_.resize(static_cast<size_t>(local_rows) * cols);
+
+    // One element of this type is a full matrix row, so counts and displacements
+    // are expressed in rows and rank 0 sends straight from the caller's buffer.
+    MPI_Datatype row_type;
+    MPI_Type_contiguous(cols, ppc::mpi::mpiTypeOf<T>(), &row_type);
+    MPI_Type_commit(&row_type);
+    const T* sendbuf = world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[0]) : nullptr;
+    MPI_Scatterv(sendbuf, partition_.counts.data(), partition_.displs.data(), row_type, local_input_.data(),
+                 local_rows, row_type, 0, world);
+    MPI_Type_free(&row_type);
+  }
+
+  void scatter_column_blocks() {
+    partition_ = ppc::mpi::BlockPartition(cols, world.size());
+    const int local_cols = partition_.counts[world.rank()];
+    local_input_.resize(static_cast<size_t>(local_cols) * rows);
+
+    // The column block of a process is `rows` runs of `local_cols` elements with
+    // stride `cols`. Rank 0 describes every block with its own vector datatype
+    // and sends it directly from the caller's buffer; the block arrives as a
+    // compact row-major rows x local_cols matrix.
+    std::vector<MPI_Request> requests;
+    std::vector<MPI_Datatype> block_types;
+    if (world.rank() == 0) {
+      const T* matrix = reinterpret_cast<T*>(taskData->inputs[0]);
+      for (int proc = 0; proc < world.size(); proc++) {
+        if (partition_.counts[proc] == 0) continue;
+        MPI_Datatype block_type;
+        MPI_Type_vector(rows, partition_.counts[proc], cols, ppc::mpi::mpiTypeOf<T>(), &block_type);
+        MPI_Type_commit(&block_type);
+        block_types.push_back(block_type);
+        requests.emplace_back();
+        MPI_Isend(matrix + partition_.displs[proc], 1, block_type, proc, 0, world, &requests.back());
+      }
+    }
+    if (local_cols > 0) {
+      MPI_Recv(local_input_.data(), local_cols * rows, ppc::mpi::mpiTypeOf<T>(), 0, 0, world, MPI_STATUS_IGNORE);
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    for (auto& block_type : block_types) {
+      MPI_Type_free(&block_type);
+    }
+  }
+
+  std::vector<T> local_input_;
+  std::vector<T> local_res_;
+  std::vector<T> res_;
+  ppc::mpi::BlockPartition partition_{0, 1};
+  int rows{};
+  int cols{};
+  std::string ops;
+  Distribution distribution;
+  boost::mpi::communicator world;
+};
+
+}  // namespace matrix_columns_reduction_mpi
@@ -0,0 +1,99 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/matrix_columns_reduction/include/ops_mpi.hpp"
+
+namespace {
+
+// 10000 x 10000 matrix where column j holds j in its last row and larger values
+// above, so the column minimum is known without a reference run.
+const int kRows = 10000;
+const int kCols = 10000;
+
+template <class T>
+std::vector<T> makeMatrix() {
+  std::vector<T> matrix(static_cast<size_t>(kRows) * kCols);
+  for (int i = 0; i < kRows; i++) {
+    for (int j = 0; j < kCols; j++) {
+      matrix[static_cast<size_t>(i) * kCols + j] = static_cast<T>(j + (kRows - 1 - i));
+    }
+  }
+  return matrix;
+}
+
+template <class T = int>
+void runPerf(matrix_columns_reduction_mpi::Distribution distribution, bool pipeline) {
+  boost::mpi::communicator world;
+  std::vector<T> matrix;
+  std::vector<T> global_res(kCols, 0);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    matrix = makeMatrix<T>();
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(matrix.data()));
+    taskDataPar->inputs_count.emplace_back(kRows);
+    taskDataPar->inputs_count.emplace_back(kCols);
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_res.data()));
+    taskDataPar->outputs_count.emplace_back(global_res.size());
+  }
+
+  auto testMpiTaskParallel =
+      std::make_shared<matrix_columns_reduction_mpi::ColumnsReductionParallel<T>>(taskDataPar, "min", distribution);
+  ASSERT_EQ(testMpiTaskParallel->validation(), true);
+  testMpiTaskParallel->pre_processing();
+  testMpiTaskParallel->run();
+  testMpiTaskParallel->post_processing();
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->bytes_per_run = static_cast<uint64_t>(kRows) * kCols * sizeof(T);
+  perfAttr->data_type = ppc::core::kernels::typeName<T>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    for (int j = 0; j < kCols; j++) {
+      ASSERT_EQ(global_res[j], static_cast<T>(j));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(matrix_columns_reduction_mpi_perf_test, test_pipeline_run_row_blocks) {
+  runPerf(matrix_columns_reduction_mpi::Distribution::RowBlocks, true);
+}
+
+TEST(matrix_columns_reduction_mpi_perf_test, test_task_run_row_blocks) {
+  runPerf(matrix_columns_reduction_mpi::Distribution::RowBlocks, false);
+}
+
+TEST(matrix_columns_reduction_mpi_perf_test, test_pipeline_run_column_blocks) {
+  runPerf(matrix_columns_reduction_mpi::Distribution::ColumnBlocks, true);
+}
+
+TEST(matrix_columns_reduction_mpi_perf_test, test_task_run_column_blocks) {
+  runPerf(matrix_columns_reduction_mpi::Distribution::ColumnBlocks, false);
+}
+
+TEST(matrix_columns_reduction_mpi_perf_test, test_pipeline_run_row_blocks_int16) {
+  runPerf<int16_t>(matrix_columns_reduction_mpi::Distribution::RowBlocks, true);
+}
@@ -0,0 +1,232 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/kernels/include/gemm.hpp"
+#include "core/testing/include/compare.hpp"
+#include "mpi/matrix_multiplication/include/cannon.hpp"
+#include "mpi/matrix_multiplication/include/ring_strip.hpp"
+#include "mpi/matrix_multiplication/include/summa.hpp"
+
+namespace {
+
+template <class T>
+void writeBinary(const std::string& path, const std::vector<T>& values) {
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <class Task, class T = int>
+void runAndCompare(int m, int k, int n, int runs = 1) {
+  boost::mpi::communicator world;
+  std::vector<T> a;
+  std::vector<T> b;
+  std::vector<T> c;
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    a = ppc::core::testing::getExactRandomVector<T>(static_cast<size_t>(m) * k);
+    b = ppc::core::testing::getExactRandomVector<T>(static_cast<size_t>(k) * n);
+    c.resize(static_cast<size_t>(m) * n);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+    taskDataPar->inputs_count = {static_cast<uint32_t>(m), static_cast<uint32_t>(k), static_cast<uint32_t>(k),
+                                 static_cast<uint32_t>(n)};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+    taskDataPar->outputs_count.emplace_back(c.size());
+  }
+
+  Task testMpiTaskParallel(taskDataPar);
+  ppc::core::testing::runTask(testMpiTaskParallel, runs);
+
+  if (world.rank() == 0) {
+    std::vector<T> reference(static_cast<size_t>(m) * n);
+    ppc::core::kernels::matmul<T>(m, n, k, a.data(), b.data(), reference.data());
+    ASSERT_EQ(c, reference);
+  }
+}
+
+}  // namespace
+
+TEST(matrix_multiplication_mpi_summa, square) {
+  runAndCompare<matrix_multiplication_mpi::SummaParallel<int>>(64, 64, 64);
+}
+
+TEST(matrix_multiplication_mpi_summa, rectangular) {
+  runAndCompare<matrix_multiplication_mpi::SummaParallel<int>>(37, 53, 29);
+}
+
+TEST(matrix_multiplication_mpi_summa, inner_dimension_spans_several_panels) {
+  runAndCompare<matrix_multiplication_mpi::SummaParallel<int>>(9, 700, 11);
+}
+
+TEST(matrix_multiplication_mpi_summa, smaller_than_grid) {
+  runAndCompare<matrix_multiplication_mpi::SummaParallel<int>>(1, 1, 1);
+}
+
+TEST(matrix_multiplication_mpi_summa, row_times_column) {
+  runAndCompare<matrix_multiplication_mpi::SummaParallel<int>>(1, 40, 1);
+}
+
+TEST(matrix_multiplication_mpi_summa, float_matrix) {
+  runAndCompare<matrix_multiplication_mpi::SummaParallel<float>, float>(45, 31, 50);
+}
+
+TEST(matrix_multiplication_mpi_summa, double_matrix) {
+  runAndCompare<matrix_multiplication_mpi::SummaParallel<double>, double>(33, 65, 17);
+}
+
+TEST(matrix_multiplication_mpi_cannon, square) {
+  runAndCompare<matrix_multiplication_mpi::CannonParallel<int>>(64, 64, 64);
+}
+
+TEST(matrix_multiplication_mpi_cannon, rectangular_uneven_tiles) {
+  runAndCompare<matrix_multiplication_mpi::CannonParallel<int>>(37, 53, 29);
+}
+
+TEST(matrix_multiplication_mpi_cannon, smaller_than_grid) {
+  runAndCompare<matrix_multiplication_mpi::CannonParallel<int>>(1, 1, 1);
+}
+
+TEST(matrix_multiplication_mpi_cannon, long_inner_dimension) {
+  runAndCompare<matrix_multiplication_mpi::CannonParallel<int>>(5, 301, 3);
+}
+
+TEST(matrix_multiplication_mpi_cannon, double_matrix) {
+  runAndCompare<matrix_multiplication_mpi::CannonParallel<double>, double>(40, 23, 41);
+}
+
+TEST(matrix_multiplication_mpi_cannon, repeated_runs) {
+  runAndCompare<matrix_multiplication_mpi::CannonParallel<int>>(37, 53, 29, 2);
+}
+
+TEST(matrix_multiplication_mpi_ring_strip, square) {
+  runAndCompare<matrix_multiplication_mpi::RingStripParallel<int>>(64, 64, 64);
+}
+
+TEST(matrix_multiplication_mpi_ring_strip, uneven_strips) {
+  runAndCompare<matrix_multiplication_mpi::RingStripParallel<int>>(37, 53, 29);
+}
+
+TEST(matrix_multiplication_mpi_ring_strip, fewer_columns_than_processes) {
+  runAndCompare<matrix_multiplication_mpi::RingStripParallel<int>>(7, 5, 1);
+}
+
+TEST(matrix_multiplication_mpi_ring_strip, float_matrix) {
+  runAndCompare<matrix_multiplication_mpi::RingStripParallel<float>, float>(30, 45, 26);
+}
+
+TEST(matrix_multiplication_mpi_ring_strip, persistent_requests_survive_repeated_runs) {
+  boost::mpi::communicator world;
+  const int m = 12;
+  const int k = 10;
+  const int n = 9;
+  std::vector<int> a;
+  std::vector<int> b;
+  std::vector<int> c;
+  std::vector<int> reference;
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    a = ppc::core::testing::getExactRandomVector<int>(static_cast<size_t>(m) * k);
+    b = ppc::core::testing::getExactRandomVector<int>(static_cast<size_t>(k) * n);
+    c.resize(m * n);
+    reference.resize(m * n);
+    ppc::core::kernels::matmul<int>(m, n, k, a.data(), b.data(), reference.data());
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+    taskDataPar->inputs_count = {m, k, k, n};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+    taskDataPar->outputs_count.emplace_back(c.size());
+  }
+  matrix_multiplication_mpi::RingStripParallel<int> testMpiTaskParallel(taskDataPar);
+  ppc::core::testing::runTask(testMpiTaskParallel, 3);
+  ASSERT_GE(testMpiTaskParallel.overlapFraction(), 0.0);
+  ASSERT_LE(testMpiTaskParallel.overlapFraction(), 1.0);
+  if (world.rank() == 0) {
+    ASSERT_EQ(c, reference);
+  }
+}
+
+TEST(matrix_multiplication_mpi_ring_strip, reads_operands_from_files) {
+  boost::mpi::communicator world;
+  const int m = 14;
+  const int k = 11;
+  const int n = 9;
+  const auto dir = std::filesystem::temp_directory_path();
+  const std::string a_path = (dir / "ppc_ring_strip_a.bin").string();
+  const std::string b_path = (dir / "ppc_ring_strip_b.bin").string();
+  std::vector<double> c;
+  std::vector<double> reference;
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    const auto a = ppc::core::testing::getExactRandomVector<double>(static_cast<size_t>(m) * k);
+    const auto b = ppc::core::testing::getExactRandomVector<double>(static_cast<size_t>(k) * n);
+    writeBinary(a_path, a);
+    writeBinary(b_path, b);
+    c.resize(m * n);
+    reference.resize(m * n);
+    ppc::core::kernels::matmul<double>(m, n, k, a.data(), b.data(), reference.data());
+    // Only the shapes come from the task data; the operands stay on disk.
+    taskDataPar->inputs = {nullptr, nullptr};
+    taskDataPar->inputs_count = {m, k, k, n};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+    taskDataPar->outputs_count.emplace_back(c.size());
+  }
+  world.barrier();
+
+  matrix_multiplication_mpi::RingStripParallel<double> testMpiTaskParallel(taskDataPar, a_path, b_path);
+  ASSERT_EQ(testMpiTaskParallel.validation(), true);
+  ASSERT_EQ(testMpiTaskParallel.pre_processing(), true);
+  testMpiTaskParallel.run();
+  testMpiTaskParallel.post_processing();
+  world.barrier();
+  if (world.rank() == 0) {
+    std::filesystem::remove(a_path);
+    std::filesystem::remove(b_path);
+    ASSERT_EQ(c, reference);
+  }
+}
+
+TEST(matrix_multiplication_mpi_ring_strip, validation_fails_on_missing_file) {
+  boost::mpi::communicator world;
+  std::vector<int> b(6);
+  std::vector<int> c(4);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs = {nullptr, reinterpret_cast<uint8_t*>(b.data())};
+    taskDataPar->inputs_count = {2, 3, 3, 2};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+    taskDataPar->outputs_count.emplace_back(c.size());
+  }
+  const auto missing = std::filesystem::temp_directory_path() / "ppc_ring_strip_missing.bin";
+  matrix_multiplication_mpi::RingStripParallel<int> testMpiTaskParallel(taskDataPar, missing.string());
+  if (world.rank() == 0) {
+    ASSERT_EQ(testMpiTaskParallel.validation(), false);
+  }
+}
+
+TEST(matrix_multiplication_mpi_summa, validation_fails_on_mismatched_inner_dimension) {
+  boost::mpi::communicator world;
+  std::vector<int> a(6);
+  std::vector<int> b(6);
+  std::vector<int> c(4);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+    taskDataPar->inputs_count = {2, 3, 2, 3};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+    taskDataPar->outputs_count.emplace_back(c.size());
+  }
+  matrix_multiplication_mpi::SummaParallel<int> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    ASSERT_EQ(testMpiTaskParallel.validation(), false);
+  }
+}
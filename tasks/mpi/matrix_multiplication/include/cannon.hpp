@@ -0,0 +1,199 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/gemm.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/common/include/process_grid.hpp"
+#include "mpi/matrix_multiplication/include/task_data.hpp"
+
+namespace matrix_multiplication_mpi {
+
+namespace detail {
+
+// Largest q with q * q <= size.
+inline int squareGridSide(int size) {
+  int q = static_cast<int>(std::sqrt(static_cast<double>(size)));
+  while (q * q > size) q--;
+  while ((q + 1) * (q + 1) <= size) q++;
+  return q;
+}
+
+// Copies a compact rows x cols tile into the top left corner of a zero-filled
+// padded_rows x padded_cols tile.
+template <class T>
+std::vector<T> padTile(const std::vector<T>& tile, int rows, int cols, int padded_rows, int padded_cols) {
+  std::vector<T> padded(static_cast<size_t>(padded_rows) * padded_cols, T{});
+  for (int i = 0; i < rows; i++) {
+    std::copy(tile.begin() + static_cast<ptrdiff_t>(i) * cols, tile.begin() + static_cast<ptrdiff_t>(i + 1) * cols,
+              padded.begin() + static_cast<ptrdiff_t>(i) * padded_cols);
+  }
+  return padded;
+}
+
+}  // namespace detail
+
+// C = A * B with Cannon's algorithm on a periodic q x q grid, q = floor(sqrt(p));
+// processes beyond q * q only take part in the task's broadcasts. Task data as in
+// isValidMatmulTaskData.
+//
+// Tiles are padded with zeros to the size of the largest block, so that every
+// shift moves tiles of one size. After the initial skew (row i of A shifted left
+// by i, column j of B shifted up by j, with MPI_Sendrecv_replace) every step
+// multiplies the current tiles and shifts A left and B up by one. The shifts are
+// double buffered: the transfer of the tiles for step s + 1 is started with
+// MPI_Isend/MPI_Irecv before the multiply of step s and only waited for after
+// it, so the communication is hidden behind the local GEMM.
+template <class T>
+class CannonParallel : public ppc::core::Task {
+ public:
+  explicit CannonParallel(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      m = static_cast<int>(taskData->inputs_count[0]);
+      k = static_cast<int>(taskData->inputs_count[1]);
+      n = static_cast<int>(taskData->inputs_count[3]);
+    }
+    broadcast(world, m, 0);
+    broadcast(world, k, 0);
+    broadcast(world, n, 0);
+
+    const int q = detail::squareGridSide(world.size());
+    grid_ = std::make_unique<ppc::mpi::ProcessGrid>(world, std::array<int, 2>{q, q}, true);
+    if (!grid_->member()) {
+      return true;
+    }
+    rows_part_ = ppc::mpi::BlockPartition(m, q);
+    cols_part_ = ppc::mpi::BlockPartition(n, q);
+    inner_part_ = ppc::mpi::BlockPartition(k, q);
+
+    std::vector<T> tile;
+    const T* a = world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[0]) : nullptr;
+    ppc::mpi::scatterTiles(*grid_, a, k, rows_part_, inner_part_, tile);
+    a_scattered_ = detail::padTile(tile, rows_part_.counts[grid_->row()], inner_part_.counts[grid_->col()], tileM(),
+                                   tileK());
+    const T* b = world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[1]) : nullptr;
+    ppc::mpi::scatterTiles(*grid_, b, n, inner_part_, cols_part_, tile);
+    b_scattered_ = detail::padTile(tile, inner_part_.counts[grid_->row()], cols_part_.counts[grid_->col()], tileK(),
+                                   tileN());
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return isValidMatmulTaskData(*taskData);
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    if (!grid_->member()) {
+      return true;
+    }
+    const int q = grid_->rows();
+    const int a_count = tileM() * tileK();
+    const int b_count = tileK() * tileN();
+    // The skew and the shifts rotate the working tiles, so every run starts
+    // again from the scattered ones.
+    a_tile_ = a_scattered_;
+    b_tile_ = b_scattered_;
+    c_tile_.assign(static_cast<size_t>(tileM()) * tileN(), T{});
+
+    // Initial alignment: A(i, j) <- A(i, j + i), B(i, j) <- B(i + j, j).
+    int src = 0;
+    int dst = 0;
+    MPI_Cart_shift(grid_->cart(), 1, -grid_->row(), &src, &dst);
+    MPI_Sendrecv_replace(a_tile_.data(), a_count, ppc::mpi::mpiTypeOf<T>(), dst, 0, src, 0, grid_->cart(),
+                         MPI_STATUS_IGNORE);
+    MPI_Cart_shift(grid_->cart(), 0, -grid_->col(), &src, &dst);
+    MPI_Sendrecv_replace(b_tile_.data(), b_count, ppc::mpi::mpiTypeOf<T>(), dst, 1, src, 1, grid_->cart(),
+                         MPI_STATUS_IGNORE);
+
+    int left = 0;
+    int right = 0;
+    int up = 0;
+    int down = 0;
+    MPI_Cart_shift(grid_->cart(), 1, -1, &right, &left);
+    MPI_Cart_shift(grid_->cart(), 0, -1, &down, &up);
+    std::vector<T> a_next(a_tile_.size());
+    std::vector<T> b_next(b_tile_.size());
+    for (int step = 0; step < q; step++) {
+      std::array<MPI_Request, 4> requests = {MPI_REQUEST_NULL, MPI_REQUEST_NULL, MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+      const bool shift = step + 1 < q;
+      if (shift) {
+        MPI_Irecv(a_next.data(), a_count, ppc::mpi::mpiTypeOf<T>(), right, 2, grid_->cart(), &requests[0]);
+        MPI_Irecv(b_next.data(), b_count, ppc::mpi::mpiTypeOf<T>(), down, 3, grid_->cart(), &requests[1]);
+        MPI_Isend(a_tile_.data(), a_count, ppc::mpi::mpiTypeOf<T>(), left, 2, grid_->cart(), &requests[2]);
+        MPI_Isend(b_tile_.data(), b_count, ppc::mpi::mpiTypeOf<T>(), up, 3, grid_->cart(), &requests[3]);
+      }
+      // The tiles being sent are only read here, so the multiply may run while
+      // the sends are in flight.
+      ppc::core::kernels::gemm<T>(tileM(), tileN(), tileK(), a_tile_.data(), tileK(), b_tile_.data(), tileN(),
+                                  c_tile_.data(), tileN());
+      if (shift) {
+        MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+        a_tile_.swap(a_next);
+        b_tile_.swap(b_next);
+      }
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    if (!grid_->member()) {
+      return true;
+    }
+    const int local_m = rows_part_.counts[grid_->row()];
+    const int local_n = cols_part_.counts[grid_->col()];
+    std::vector<T> tile(static_cast<size_t>(local_m) * local_n);
+    for (int i = 0; i < local_m; i++) {
+      std::copy(c_tile_.begin() + static_cast<ptrdiff_t>(i) * tileN(),
+                c_tile_.begin() + static_cast<ptrdiff_t>(i) * tileN() + local_n,
+                tile.begin() + static_cast<ptrdiff_t>(i) * local_n);
+    }
+    T* c = world.rank() == 0 ? reinterpret_cast<T*>(taskData->outputs[0]) : nullptr;
+    ppc::mpi::gatherTiles(*grid_, tile, c, n, rows_part_, cols_part_);
+    return true;
+  }
+
+ private:
+  // Padded tile dimensions: the first block of a BlockPartition is the largest.
+  [[nodiscard]] int tileM() const { return rows_part_.counts[0]; }
+  [[nodiscard]] int tileK() const { return inner_part_.counts[0]; }
+  [[nodiscard]] int tileN() const { return cols_part_.counts[0]; }
+
+  std::unique_ptr<ppc::mpi::ProcessGrid> grid_;
+  ppc::mpi::BlockPartition rows_part_{0, 1};
+  ppc::mpi::BlockPartition cols_part_{0, 1};
+  ppc::mpi::BlockPartition inner_part_{0, 1};
+  std::vector<T> a_scattered_;
+  std::vector<T> b_scattered_;
+  std::vector<T> a_tile_;
+  std::vector<T> b_tile_;
+  std::vector<T> c_tile_;
+  int m{};
+  int k{};
+  int n{};
+  boost::mpi::communicator world;
+};
+
+}  // namespace matrix_multiplication_mpi
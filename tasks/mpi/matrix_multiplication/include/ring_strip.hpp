@@ -0,0 +1,242 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/gemm.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/file_io.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/matrix_multiplication/include/task_data.hpp"
+
+namespace matrix_multiplication_mpi {
+
+// C = A * B with horizontal strips of A and vertical strips of B passed around
+// a ring. Task data as in isValidMatmulTaskData.
+//
+// Rank r keeps rows block r of A and C. It starts with column strip r of B. At
+// step s it holds strip (r + s) % p, multiplies it into the matching columns of
+// its C rows and passes it to rank r - 1. The strip for the next step is received
+// from rank r + 1 while the current one is multiplied. B strips are padded to
+// the widest strip, so every transfer has the same size. That lets the four
+// transfers (send/receive out of/into either of the two strip buffers) be
+// persistent requests created with MPI_Send_init/MPI_Recv_init. They are created
+// once and reused by every run while the matrix shape stays the same. The ring
+// leaves another rank's strip in the buffers, so the own strip is kept apart and
+// copied in at the start of every run.
+//
+// Operands stored on disk: with a non-empty a_path_ / b_path_ the matrix is
+// read from that binary file (row-major values of T) instead of inputs[0] /
+// inputs[1], which may then be nullptr. Every rank reads only its rows block of
+// A and its column strip of B with MPI_File_read_at_all, so rank 0 never loads
+// or scatters them.
+template <class T>
+class RingStripParallel : public ppc::core::Task {
+ public:
+  explicit RingStripParallel(std::shared_ptr<ppc::core::TaskData> taskData_, std::string a_path_ = {},
+                             std::string b_path_ = {})
+      : Task(std::move(taskData_)), a_path(std::move(a_path_)), b_path(std::move(b_path_)) {}
+
+  RingStripParallel(const RingStripParallel&) = delete;
+  RingStripParallel& operator=(const RingStripParallel&) = delete;
+
+  ~RingStripParallel() override { freeRequests(); }
+
+  bool pre_processing() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      m = static_cast<int>(taskData->inputs_count[0]);
+      k = static_cast<int>(taskData->inputs_count[1]);
+      n = static_cast<int>(taskData->inputs_count[3]);
+    }
+    broadcast(world, m, 0);
+    broadcast(world, k, 0);
+    broadcast(world, n, 0);
+    rows_part_ = ppc::mpi::BlockPartition(m, world.size());
+    cols_part_ = ppc::mpi::BlockPartition(n, world.size());
+    const int local_m = rows_part_.counts[world.rank()];
+    const int strip_n = cols_part_.counts[0];
+
+    a_rows_.resize(static_cast<size_t>(local_m) * k);
+    if (strip_n != strip_n_ || k != strip_k_) {
+      freeRequests();
+      own_strip_.assign(static_cast<size_t>(k) * strip_n, T{});
+      strips_[0].assign(static_cast<size_t>(k) * strip_n, T{});
+      strips_[1].assign(static_cast<size_t>(k) * strip_n, T{});
+      strip_n_ = strip_n;
+      strip_k_ = k;
+    }
+    if (a_path.empty()) {
+      scatterA();
+    } else if (!ppc::mpi::readTile(world, a_path, k, rows_part_.displs[world.rank()], 0, local_m, k, a_rows_.data(),
+                                   k)) {
+      return false;
+    }
+    if (b_path.empty()) {
+      scatterB();
+    } else if (!ppc::mpi::readTile(world, b_path, n, 0, cols_part_.displs[world.rank()], k,
+                                   cols_part_.counts[world.rank()], own_strip_.data(), strip_n)) {
+      return false;
+    }
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      const auto& counts = taskData->inputs_count;
+      return isValidMatmulTaskData(*taskData) &&
+             (a_path.empty() || ppc::mpi::fileHolds(a_path, sizeof(T) * counts[0] * counts[1])) &&
+             (b_path.empty() || ppc::mpi::fileHolds(b_path, sizeof(T) * counts[2] * counts[3]));
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    const int size = world.size();
+    const int local_m = rows_part_.counts[world.rank()];
+    c_rows_.assign(static_cast<size_t>(local_m) * n, T{});
+    // Copied, not assigned, so the persistent requests keep their buffer.
+    std::copy(own_strip_.begin(), own_strip_.end(), strips_[0].begin());
+    if (size > 1 && requests_[0] == MPI_REQUEST_NULL) {
+      initRequests();
+    }
+
+    compute_time_ = 0.0;
+    wait_time_ = 0.0;
+    for (int step = 0; step < size; step++) {
+      const int current = step % 2;
+      const bool shift = step + 1 < size;
+      if (shift) {
+        MPI_Startall(2, requests_.data() + 2 * current);
+      }
+      const double start = MPI_Wtime();
+      const int strip = (world.rank() + step) % size;
+      ppc::core::kernels::gemm<T>(local_m, cols_part_.counts[strip], k, a_rows_.data(), k, strips_[current].data(),
+                                  strip_n_, c_rows_.data() + cols_part_.displs[strip], n);
+      const double computed = MPI_Wtime();
+      if (shift) {
+        MPI_Waitall(2, requests_.data() + 2 * current, MPI_STATUSES_IGNORE);
+      }
+      compute_time_ += computed - start;
+      wait_time_ += MPI_Wtime() - computed;
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    MPI_Datatype row_type;
+    MPI_Type_contiguous(n, ppc::mpi::mpiTypeOf<T>(), &row_type);
+    MPI_Type_commit(&row_type);
+    T* c = world.rank() == 0 ? reinterpret_cast<T*>(taskData->outputs[0]) : nullptr;
+    MPI_Gatherv(c_rows_.data(), rows_part_.counts[world.rank()], row_type, c, rows_part_.counts.data(),
+                rows_part_.displs.data(), row_type, 0, world);
+    MPI_Type_free(&row_type);
+    return true;
+  }
+
+  // Share of the last run() this rank spent multiplying rather than blocked on
+  // the ring transfers: 1.0 means the shifts were completely hidden behind the
+  // local GEMM.
+  [[nodiscard]] double overlapFraction() const {
+    const double total = compute_time_ + wait_time_;
+    return total > 0.0 ? compute_time_ / total : 1.0;
+  }
+
+ private:
+  // Rows block of A from rank 0: one element of the row type is a whole row.
+  void scatterA() {
+    MPI_Datatype row_type;
+    MPI_Type_contiguous(k, ppc::mpi::mpiTypeOf<T>(), &row_type);
+    MPI_Type_commit(&row_type);
+    const T* a = world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[0]) : nullptr;
+    MPI_Scatterv(a, rows_part_.counts.data(), rows_part_.displs.data(), row_type, a_rows_.data(),
+                 rows_part_.counts[world.rank()], row_type, 0, world);
+    MPI_Type_free(&row_type);
+  }
+
+  // Column strip of B from rank 0, sent with a vector datatype per rank and
+  // received with a vector datatype straight into the padded k x strip_n layout.
+  void scatterB() {
+    std::vector<MPI_Request> requests;
+    std::vector<MPI_Datatype> strip_types;
+    if (world.rank() == 0) {
+      const T* b = reinterpret_cast<T*>(taskData->inputs[1]);
+      for (int proc = 0; proc < world.size(); proc++) {
+        if (cols_part_.counts[proc] == 0) continue;
+        MPI_Datatype strip_type;
+        MPI_Type_vector(k, cols_part_.counts[proc], n, ppc::mpi::mpiTypeOf<T>(), &strip_type);
+        MPI_Type_commit(&strip_type);
+        strip_types.push_back(strip_type);
+        requests.emplace_back();
+        MPI_Isend(b + cols_part_.displs[proc], 1, strip_type, proc, 0, world, &requests.back());
+      }
+    }
+    const int local_n = cols_part_.counts[world.rank()];
+    if (local_n > 0) {
+      MPI_Datatype padded_type;
+      MPI_Type_vector(k, local_n, strip_n_, ppc::mpi::mpiTypeOf<T>(), &padded_type);
+      MPI_Type_commit(&padded_type);
+      MPI_Recv(own_strip_.data(), 1, padded_type, 0, 0, world, MPI_STATUS_IGNORE);
+      MPI_Type_free(&padded_type);
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    for (auto& strip_type : strip_types) {
+      MPI_Type_free(&strip_type);
+    }
+  }
+
+  void initRequests() {
+    const int left = (world.rank() + world.size() - 1) % world.size();
+    const int right = (world.rank() + 1) % world.size();
+    const int count = strip_k_ * strip_n_;
+    // requests_[2 * b] sends strips_[b] to the left, requests_[2 * b + 1]
+    // receives the next strip from the right into the other buffer.
+    for (int b = 0; b < 2; b++) {
+      MPI_Send_init(strips_[b].data(), count, ppc::mpi::mpiTypeOf<T>(), left, 0, world, &requests_[2 * b]);
+      MPI_Recv_init(strips_[1 - b].data(), count, ppc::mpi::mpiTypeOf<T>(), right, 0, world, &requests_[2 * b + 1]);
+    }
+  }
+
+  void freeRequests() {
+    for (auto& request : requests_) {
+      if (request != MPI_REQUEST_NULL) {
+        MPI_Request_free(&request);
+      }
+    }
+  }
+
+  ppc::mpi::BlockPartition rows_part_{0, 1};
+  ppc::mpi::BlockPartition cols_part_{0, 1};
+  std::vector<T> a_rows_;
+  std::vector<T> c_rows_;
+  std::vector<T> own_strip_;
+  std::array<std::vector<T>, 2> strips_;
+  std::array<MPI_Request, 4> requests_ = {MPI_REQUEST_NULL, MPI_REQUEST_NULL, MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+  int strip_k_ = -1;
+  int strip_n_ = -1;
+  double compute_time_ = 0.0;
+  double wait_time_ = 0.0;
+  int m{};
+  int k{};
+  int n{};
+  std::string a_path;
+  std::string b_path;
+  boost::mpi::communicator world;
+};
+
+}  // namespace matrix_multiplication_mpi
@@ -0,0 +1,141 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/gemm.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/common/include/process_grid.hpp"
+#include "mpi/matrix_multiplication/include/task_data.hpp"
+
+namespace matrix_multiplication_mpi {
+
+// C = A * B with SUMMA on a 2D process grid.
+// Input: inputs[0] is A (m x k), inputs[1] is B (k x n), row-major, on rank 0;
+// inputs_count = {m, k, k, n}. Output: outputs[0] receives m x n values.
+//
+// The process at grid position (r, c) keeps only its tiles: rows block r of A
+// and C, columns block c of B and C, and the matching blocks of the inner
+// dimension (k is split over grid columns for A and over grid rows for B). For
+// every panel of the inner dimension the owning grid column broadcasts its A
+// panel along the grid rows and the owning grid row broadcasts its B panel along
+// the grid columns, then every process adds the panel product to its C tile.
+// Per-process memory and traffic are O(n^2 / p) instead of O(n^2).
+template <class T>
+class SummaParallel : public ppc::core::Task {
+ public:
+  explicit SummaParallel(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      m = static_cast<int>(taskData->inputs_count[0]);
+      k = static_cast<int>(taskData->inputs_count[1]);
+      n = static_cast<int>(taskData->inputs_count[3]);
+    }
+    broadcast(world, m, 0);
+    broadcast(world, k, 0);
+    broadcast(world, n, 0);
+
+    grid_ = std::make_unique<ppc::mpi::ProcessGrid>(world);
+    rows_part_ = ppc::mpi::BlockPartition(m, grid_->rows());
+    cols_part_ = ppc::mpi::BlockPartition(n, grid_->cols());
+    inner_a_part_ = ppc::mpi::BlockPartition(k, grid_->cols());
+    inner_b_part_ = ppc::mpi::BlockPartition(k, grid_->rows());
+
+    const T* a = world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[0]) : nullptr;
+    const T* b = world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[1]) : nullptr;
+    ppc::mpi::scatterTiles(*grid_, a, k, rows_part_, inner_a_part_, a_tile_);
+    ppc::mpi::scatterTiles(*grid_, b, n, inner_b_part_, cols_part_, b_tile_);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return isValidMatmulTaskData(*taskData);
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    const int local_m = rows_part_.counts[grid_->row()];
+    const int local_n = cols_part_.counts[grid_->col()];
+    const int local_k_a = inner_a_part_.counts[grid_->col()];
+    c_tile_.assign(static_cast<size_t>(local_m) * local_n, T{});
+
+    // A panel is cut where either partition of k has a block boundary, so it has
+    // exactly one owner in the grid row and one in the grid column.
+    std::vector<T> a_panel;
+    std::vector<T> b_panel;
+    for (int k0 = 0; k0 < k;) {
+      const int owner_col = inner_a_part_.owner(k0);
+      const int owner_row = inner_b_part_.owner(k0);
+      const int k1 = std::min({k0 + static_cast<int>(ppc::core::kernels::kGemmKc),
+                               inner_a_part_.displs[owner_col] + inner_a_part_.counts[owner_col],
+                               inner_b_part_.displs[owner_row] + inner_b_part_.counts[owner_row]});
+      const int width = k1 - k0;
+
+      a_panel.resize(static_cast<size_t>(local_m) * width);
+      if (grid_->col() == owner_col) {
+        const int offset = k0 - inner_a_part_.displs[owner_col];
+        for (int i = 0; i < local_m; i++) {
+          const T* row = a_tile_.data() + static_cast<size_t>(i) * local_k_a + offset;
+          std::copy(row, row + width, a_panel.data() + static_cast<size_t>(i) * width);
+        }
+      }
+      MPI_Bcast(a_panel.data(), static_cast<int>(a_panel.size()), ppc::mpi::mpiTypeOf<T>(), owner_col,
+                grid_->row_comm());
+
+      // Rows of B are contiguous in the tile, so the owner broadcasts in place.
+      T* b_rows = nullptr;
+      if (grid_->row() == owner_row) {
+        b_rows = b_tile_.data() + static_cast<size_t>(k0 - inner_b_part_.displs[owner_row]) * local_n;
+      } else {
+        b_panel.resize(static_cast<size_t>(width) * local_n);
+        b_rows = b_panel.data();
+      }
+      MPI_Bcast(b_rows, width * local_n, ppc::mpi::mpiTypeOf<T>(), owner_row, grid_->col_comm());
+
+      ppc::core::kernels::gemm<T>(local_m, local_n, width, a_panel.data(), width, b_rows, local_n, c_tile_.data(),
+                                  local_n);
+      k0 = k1;
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    T* c = world.rank() == 0 ? reinterpret_cast<T*>(taskData->outputs[0]) : nullptr;
+    ppc::mpi::gatherTiles(*grid_, c_tile_, c, n, rows_part_, cols_part_);
+    return true;
+  }
+
+ private:
+  std::unique_ptr<ppc::mpi::ProcessGrid> grid_;
+  ppc::mpi::BlockPartition rows_part_{0, 1};
+  ppc::mpi::BlockPartition cols_part_{0, 1};
+  ppc::mpi::BlockPartition inner_a_part_{0, 1};
+  ppc::mpi::BlockPartition inner_b_part_{0, 1};
+  std::vector<T> a_tile_;
+  std::vector<T> b_tile_;
+  std::vector<T> c_tile_;
+  int m{};
+  int k{};
+  int n{};
+  boost::mpi::communicator world;
+};
+
+}  // namespace matrix_multiplication_mpi
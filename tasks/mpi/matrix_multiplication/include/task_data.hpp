@@ -0,0 +1,18 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include "core/task/include/task.hpp"
+
+namespace matrix_multiplication_mpi {
+
+// Task data of every grid matmul task: inputs[0] is A (m x k), inputs[1] is B
+// (k x n), row-major, on rank 0; inputs_count = {m, k, k, n}; outputs[0]
+// receives the m x n product.
+inline bool isValidMatmulTaskData(const ppc::core::TaskData& taskData) {
+  return taskData.inputs.size() == 2 && taskData.inputs_count.size() == 4 && taskData.outputs_count.size() == 1 &&
+         taskData.inputs_count[0] > 0 && taskData.inputs_count[1] > 0 && taskData.inputs_count[3] > 0 &&
+         taskData.inputs_count[1] == taskData.inputs_count[2] &&
+         taskData.outputs_count[0] == taskData.inputs_count[0] * taskData.inputs_count[3];
+}
+
+}  // namespace matrix_multiplication_mpi
@@ -0,0 +1,123 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/matrix_multiplication/include/cannon.hpp"
+#include "mpi/matrix_multiplication/include/ring_strip.hpp"
+#include "mpi/matrix_multiplication/include/summa.hpp"
+
+namespace {
+
+// A is all ones and B[p][j] = j % 7, so every entry of C is n * (j % 7) and the
+// result is checked without a reference run.
+template <class Task, class T = int>
+void runPerf(uint32_t n, bool pipeline) {
+  boost::mpi::communicator world;
+  std::vector<T> a;
+  std::vector<T> b;
+  std::vector<T> c;
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    a.assign(static_cast<size_t>(n) * n, T{1});
+    b.resize(static_cast<size_t>(n) * n);
+    for (size_t i = 0; i < b.size(); i++) {
+      b[i] = static_cast<T>(i % n % 7);
+    }
+    c.resize(static_cast<size_t>(n) * n);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+    taskDataPar->inputs_count = {n, n, n, n};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+    taskDataPar->outputs_count.emplace_back(c.size());
+  }
+
+  auto testMpiTaskParallel = std::make_shared<Task>(taskDataPar);
+  ASSERT_EQ(testMpiTaskParallel->validation(), true);
+  testMpiTaskParallel->pre_processing();
+  testMpiTaskParallel->run();
+  testMpiTaskParallel->post_processing();
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  // n^3 work: keep the measurement of the larger sizes within PerfResults::MAX_TIME
+  perfAttr->num_running = n >= 1024 ? 3 : 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->flops_per_run = 2ULL * n * n * n;
+  perfAttr->data_type = ppc::core::kernels::typeName<T>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    if constexpr (requires { testMpiTaskParallel->overlapFraction(); }) {
+      std::cout << "overlap fraction of the ring shifts: " << std::fixed << std::setprecision(3)
+                << testMpiTaskParallel->overlapFraction() << std::endl;
+    }
+    for (size_t i = 0; i < n; i += n / 8) {
+      for (size_t j = 0; j < n; j++) {
+        ASSERT_EQ(c[i * n + j], static_cast<T>(n * (j % 7)));
+      }
+    }
+  }
+}
+
+}  // namespace
+
+// 200 x 200 is the size used by the perf tests of the strip-scheme tasks
+// (e.g. kalinin_d_matrix_mult_hor_a_vert_b), 1024 x 1024 shows the scaling.
+TEST(matrix_multiplication_mpi_perf_test, test_pipeline_run_summa_200) {
+  runPerf<matrix_multiplication_mpi::SummaParallel<int>>(200, true);
+}
+
+TEST(matrix_multiplication_mpi_perf_test, test_pipeline_run_summa_1024) {
+  runPerf<matrix_multiplication_mpi::SummaParallel<int>>(1024, true);
+}
+
+TEST(matrix_multiplication_mpi_perf_test, test_task_run_summa_1024) {
+  runPerf<matrix_multiplication_mpi::SummaParallel<int>>(1024, false);
+}
+
+TEST(matrix_multiplication_mpi_perf_test, test_task_run_summa_1024_double) {
+  runPerf<matrix_multiplication_mpi::SummaParallel<double>, double>(1024, false);
+}
+
+TEST(matrix_multiplication_mpi_perf_test, test_pipeline_run_cannon_200) {
+  runPerf<matrix_multiplication_mpi::CannonParallel<int>>(200, true);
+}
+
+TEST(matrix_multiplication_mpi_perf_test, test_pipeline_run_cannon_1024) {
+  runPerf<matrix_multiplication_mpi::CannonParallel<int>>(1024, true);
+}
+
+TEST(matrix_multiplication_mpi_perf_test, test_task_run_cannon_1024) {
+  runPerf<matrix_multiplication_mpi::CannonParallel<int>>(1024, false);
+}
+
+TEST(matrix_multiplication_mpi_perf_test, test_pipeline_run_ring_strip_200) {
+  runPerf<matrix_multiplication_mpi::RingStripParallel<int>>(200, true);
+}
+
+TEST(matrix_multiplication_mpi_perf_test, test_pipeline_run_ring_strip_1024) {
+  runPerf<matrix_multiplication_mpi::RingStripParallel<int>>(1024, true);
+}
+
+TEST(matrix_multiplication_mpi_perf_test, test_task_run_ring_strip_1024) {
+  runPerf<matrix_multiplication_mpi::RingStripParallel<int>>(1024, false);
+}
@@ -0,0 +1,151 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/testing/include/compare.hpp"
+#include "mpi/matrix_vector_multiplication/include/ops_mpi.hpp"
+
+namespace {
+
+template <class T = int>
+void runAndCompare(int m, int n, ppc::mpi::MatvecScheme scheme) {
+  boost::mpi::communicator world;
+  std::vector<T> a;
+  std::vector<T> x;
+  std::vector<T> y(m);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    a = ppc::core::testing::getExactRandomVector<T>(static_cast<size_t>(m) * n);
+    x = ppc::core::testing::getExactRandomVector<T>(n);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+    taskDataPar->inputs_count = {static_cast<uint32_t>(m), static_cast<uint32_t>(n), static_cast<uint32_t>(n)};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(y.data()));
+    taskDataPar->outputs_count.emplace_back(y.size());
+  }
+
+  matrix_vector_multiplication_mpi::MatvecParallel<T> testMpiTaskParallel(taskDataPar, scheme);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+
+  if (world.rank() == 0) {
+    ppc::core::testing::expectSameAsReference<matrix_vector_multiplication_mpi::MatvecSequential<T>, T>(taskDataPar);
+  }
+}
+
+}  // namespace
+
+TEST(matrix_vector_multiplication_mpi, row_ribbon) { runAndCompare(50, 40, ppc::mpi::MatvecScheme::RowRibbon); }
+
+TEST(matrix_vector_multiplication_mpi, column_ribbon) { runAndCompare(50, 40, ppc::mpi::MatvecScheme::ColumnRibbon); }
+
+TEST(matrix_vector_multiplication_mpi, block_2d) { runAndCompare(50, 40, ppc::mpi::MatvecScheme::Block2D); }
+
+TEST(matrix_vector_multiplication_mpi, row_ribbon_fewer_rows_than_processes) {
+  runAndCompare(1, 9, ppc::mpi::MatvecScheme::RowRibbon);
+}
+
+TEST(matrix_vector_multiplication_mpi, column_ribbon_fewer_columns_than_processes) {
+  runAndCompare(7, 1, ppc::mpi::MatvecScheme::ColumnRibbon);
+}
+
+TEST(matrix_vector_multiplication_mpi, block_2d_tiny) { runAndCompare(2, 3, ppc::mpi::MatvecScheme::Block2D); }
+
+TEST(matrix_vector_multiplication_mpi, column_ribbon_double) {
+  runAndCompare<double>(33, 71, ppc::mpi::MatvecScheme::ColumnRibbon);
+}
+
+TEST(matrix_vector_multiplication_mpi, block_2d_float) {
+  runAndCompare<float>(64, 17, ppc::mpi::MatvecScheme::Block2D);
+}
+
+TEST(matrix_vector_multiplication_mpi, engine_reuses_distributed_matrix) {
+  boost::mpi::communicator world;
+  const int m = 13;
+  const int n = 11;
+  std::vector<int> a(m * n);
+  for (int i = 0; i < m * n; i++) a[i] = i % 5 - 2;
+  ppc::mpi::MatvecEngine<int> engine(world, ppc::mpi::MatvecScheme::Block2D, m, n);
+  engine.distributeMatrix(a.data());
+
+  std::vector<int> x(n, 1);
+  std::vector<int> y(m);
+  for (int iteration = 0; iteration < 3; iteration++) {
+    engine.multiplyReplicated(x.data());
+    engine.allgather(y.data());
+    for (int i = 0; i < m; i++) {
+      int expected = 0;
+      for (int j = 0; j < n; j++) expected += a[i * n + j] * x[j];
+      ASSERT_EQ(y[i], expected);
+    }
+    std::transform(x.begin(), x.end(), x.begin(), [](int value) { return value + 1; });
+  }
+}
+
+TEST(matrix_vector_multiplication_mpi, reads_matrix_from_file) {
+  boost::mpi::communicator world;
+  const int m = 21;
+  const int n = 17;
+  const std::string path = (std::filesystem::temp_directory_path() / "ppc_matvec_matrix.bin").string();
+  std::vector<double> x;
+  std::vector<double> y(m);
+  std::vector<double> reference(m);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    const auto a = ppc::core::testing::getExactRandomVector<double>(static_cast<size_t>(m) * n);
+    std::ofstream(path, std::ios::binary)
+        .write(reinterpret_cast<const char*>(a.data()), static_cast<std::streamsize>(a.size() * sizeof(double)));
+    x = ppc::core::testing::getExactRandomVector<double>(n);
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < n; j++) reference[i] += a[i * n + j] * x[j];
+    }
+    // The matrix stays on disk: only x travels through the task data.
+    taskDataPar->inputs = {nullptr, reinterpret_cast<uint8_t*>(x.data())};
+    taskDataPar->inputs_count = {static_cast<uint32_t>(m), static_cast<uint32_t>(n), static_cast<uint32_t>(n)};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(y.data()));
+    taskDataPar->outputs_count.emplace_back(y.size());
+  }
+  world.barrier();
+
+  for (auto scheme : {ppc::mpi::MatvecScheme::RowRibbon, ppc::mpi::MatvecScheme::Block2D}) {
+    matrix_vector_multiplication_mpi::MatvecParallel<double> testMpiTaskParallel(taskDataPar, scheme, path);
+    ASSERT_EQ(testMpiTaskParallel.validation(), true);
+    ASSERT_EQ(testMpiTaskParallel.pre_processing(), true);
+    testMpiTaskParallel.run();
+    testMpiTaskParallel.post_processing();
+    if (world.rank() == 0) {
+      ASSERT_EQ(y, reference);
+    }
+  }
+  world.barrier();
+  if (world.rank() == 0) {
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(matrix_vector_multiplication_mpi, validation_fails_on_wrong_vector_size) {
+  boost::mpi::communicator world;
+  std::vector<int> a(6);
+  std::vector<int> x(2);
+  std::vector<int> y(2);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+    taskDataPar->inputs_count = {2, 3, 2};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(y.data()));
+    taskDataPar->outputs_count.emplace_back(y.size());
+  }
+  matrix_vector_multiplication_mpi::MatvecParallel<int> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    ASSERT_EQ(testMpiTaskParallel.validation(), false);
+  }
+}
@@ -0,0 +1,135 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/dot_product.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/file_io.hpp"
+#include "mpi/common/include/matvec.hpp"
+
+namespace matrix_vector_multiplication_mpi {
+
+inline bool isValidTaskData(const ppc::core::TaskData& taskData) {
+  return taskData.inputs.size() == 2 && taskData.inputs_count.size() == 3 && taskData.outputs_count.size() == 1 &&
+         taskData.inputs_count[0] > 0 && taskData.inputs_count[1] > 0 &&
+         taskData.inputs_count[1] == taskData.inputs_count[2] && taskData.outputs_count[0] == taskData.inputs_count[0];
+}
+
+// y = A * x.
+// Input: inputs[0] is A (m x n, row-major), inputs[1] is x (n values),
+// inputs_count = {m, n, n}. Output: outputs[0] receives m values.
+template <class T>
+class MatvecSequential : public ppc::core::Task {
+ public:
+  explicit MatvecSequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    m = taskData->inputs_count[0];
+    n = taskData->inputs_count[1];
+    auto* a = reinterpret_cast<T*>(taskData->inputs[0]);
+    auto* x = reinterpret_cast<T*>(taskData->inputs[1]);
+    a_.assign(a, a + m * n);
+    x_.assign(x, x + n);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return isValidTaskData(*taskData);
+  }
+
+  bool run() override {
+    internal_order_test();
+    res_.resize(m);
+    ppc::core::kernels::dotMany(x_.data(), a_.data(), n, m, res_.data());
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::transform(res_.begin(), res_.end(), reinterpret_cast<T*>(taskData->outputs[0]),
+                   [](ppc::core::kernels::DotAccumulatorT<T> value) { return static_cast<T>(value); });
+    return true;
+  }
+
+ private:
+  std::vector<T> a_;
+  std::vector<T> x_;
+  std::vector<ppc::core::kernels::DotAccumulatorT<T>> res_;
+  size_t m{};
+  size_t n{};
+};
+
+// Same contract as MatvecSequential, computed with ppc::mpi::MatvecEngine: the
+// matrix is scattered with derived datatypes in the chosen scheme and the
+// partial results are combined with one MPI_Reduce_scatter per grid row.
+// With a non-empty matrix_path_ the matrix is not taken from inputs[0] (which
+// may be nullptr) but read from that binary file (m x n values of T, row-major),
+// each process reading only its own tile.
+template <class T>
+class MatvecParallel : public ppc::core::Task {
+ public:
+  explicit MatvecParallel(std::shared_ptr<ppc::core::TaskData> taskData_,
+                          ppc::mpi::MatvecScheme scheme_ = ppc::mpi::MatvecScheme::RowRibbon,
+                          std::string matrix_path_ = {})
+      : Task(std::move(taskData_)), scheme(scheme_), matrix_path(std::move(matrix_path_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    int m = 0;
+    int n = 0;
+    if (world.rank() == 0) {
+      m = static_cast<int>(taskData->inputs_count[0]);
+      n = static_cast<int>(taskData->inputs_count[1]);
+    }
+    broadcast(world, m, 0);
+    broadcast(world, n, 0);
+    engine_.emplace(world, scheme, m, n);
+    if (!matrix_path.empty()) {
+      return engine_->readMatrix(matrix_path);
+    }
+    engine_->distributeMatrix(world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[0]) : nullptr);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return isValidTaskData(*taskData) &&
+             (matrix_path.empty() ||
+              ppc::mpi::fileHolds(matrix_path, sizeof(T) * taskData->inputs_count[0] * taskData->inputs_count[1]));
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    engine_->multiply(world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[1]) : nullptr);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    engine_->gather(world.rank() == 0 ? reinterpret_cast<T*>(taskData->outputs[0]) : nullptr);
+    return true;
+  }
+
+ private:
+  std::optional<ppc::mpi::MatvecEngine<T>> engine_;
+  ppc::mpi::MatvecScheme scheme;
+  std::string matrix_path;
+  boost::mpi::communicator world;
+};
+
+}  // namespace matrix_vector_multiplication_mpi
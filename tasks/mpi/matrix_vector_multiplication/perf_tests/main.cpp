@@ -0,0 +1,101 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/matrix_vector_multiplication/include/ops_mpi.hpp"
+
+namespace {
+
+// A[i][j] = (i + j) % 3 and x is all ones, so y[i] is known without a reference
+// run: every row holds each residue about n / 3 times.
+const int kRows = 4000;
+const int kCols = 4000;
+
+void runPerf(ppc::mpi::MatvecScheme scheme, bool pipeline) {
+  boost::mpi::communicator world;
+  std::vector<int> a;
+  std::vector<int> x;
+  std::vector<int> y;
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    a.resize(static_cast<size_t>(kRows) * kCols);
+    for (int i = 0; i < kRows; i++) {
+      for (int j = 0; j < kCols; j++) {
+        a[static_cast<size_t>(i) * kCols + j] = (i + j) % 3;
+      }
+    }
+    x.assign(kCols, 1);
+    y.resize(kRows);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+    taskDataPar->inputs_count = {kRows, kCols, kCols};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(y.data()));
+    taskDataPar->outputs_count.emplace_back(y.size());
+  }
+
+  auto testMpiTaskParallel =
+      std::make_shared<matrix_vector_multiplication_mpi::MatvecParallel<int>>(taskDataPar, scheme);
+  ASSERT_EQ(testMpiTaskParallel->validation(), true);
+  testMpiTaskParallel->pre_processing();
+  testMpiTaskParallel->run();
+  testMpiTaskParallel->post_processing();
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->bytes_per_run = static_cast<uint64_t>(kRows) * kCols * sizeof(int);
+  perfAttr->data_type = ppc::core::kernels::typeName<int>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    for (int i = 0; i < kRows; i++) {
+      int expected = 0;
+      for (int j = 0; j < kCols; j++) expected += (i + j) % 3;
+      ASSERT_EQ(y[i], expected);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(matrix_vector_multiplication_mpi_perf_test, test_pipeline_run_row_ribbon) {
+  runPerf(ppc::mpi::MatvecScheme::RowRibbon, true);
+}
+
+TEST(matrix_vector_multiplication_mpi_perf_test, test_pipeline_run_column_ribbon) {
+  runPerf(ppc::mpi::MatvecScheme::ColumnRibbon, true);
+}
+
+TEST(matrix_vector_multiplication_mpi_perf_test, test_pipeline_run_block_2d) {
+  runPerf(ppc::mpi::MatvecScheme::Block2D, true);
+}
+
+TEST(matrix_vector_multiplication_mpi_perf_test, test_task_run_row_ribbon) {
+  runPerf(ppc::mpi::MatvecScheme::RowRibbon, false);
+}
+
+TEST(matrix_vector_multiplication_mpi_perf_test, test_task_run_column_ribbon) {
+  runPerf(ppc::mpi::MatvecScheme::ColumnRibbon, false);
+}
+
+TEST(matrix_vector_multiplication_mpi_perf_test, test_task_run_block_2d) {
+  runPerf(ppc::mpi::MatvecScheme::Block2D, false);
+}
@@ -0,0 +1,114 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "core/testing/include/compare.hpp"
+#include "mpi/prefix_scan/include/ops_mpi.hpp"
+
+namespace {
+
+std::vector<uint8_t> getRandomHeads(int n, int one_in) {
+  std::random_device dev;
+  std::mt19937 gen(dev());
+  std::uniform_int_distribution<int> dist(0, one_in - 1);
+  std::vector<uint8_t> heads(n);
+  for (auto& head : heads) head = dist(gen) == 0 ? 1 : 0;
+  return heads;
+}
+
+template <class T, class Out = ppc::core::kernels::WideningAccumulatorT<T>>
+void runAndCompare(int n, prefix_scan_mpi::ScanKind kind, int head_one_in = 5) {
+  boost::mpi::communicator world;
+  std::vector<T> input;
+  std::vector<uint8_t> heads;
+  std::vector<Out> global_res(n);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    input = ppc::core::testing::getExactRandomVector<T>(n, 100);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(input.data()));
+    taskDataPar->inputs_count.emplace_back(n);
+    if (kind == prefix_scan_mpi::ScanKind::Segmented) {
+      heads = getRandomHeads(n, head_one_in);
+      taskDataPar->inputs.emplace_back(heads.data());
+      taskDataPar->inputs_count.emplace_back(n);
+    }
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_res.data()));
+    taskDataPar->outputs_count.emplace_back(global_res.size());
+  }
+
+  prefix_scan_mpi::PrefixScanParallel<T, Out> testMpiTaskParallel(taskDataPar, kind);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+
+  if (world.rank() == 0) {
+    ppc::core::testing::expectSameAsReference<prefix_scan_mpi::PrefixScanSequential<T, Out>, Out>(taskDataPar, kind);
+  }
+}
+
+}  // namespace
+
+TEST(prefix_scan_mpi, inclusive_int) { runAndCompare<int>(1000, prefix_scan_mpi::ScanKind::Inclusive); }
+
+TEST(prefix_scan_mpi, exclusive_int) { runAndCompare<int>(1000, prefix_scan_mpi::ScanKind::Exclusive); }
+
+TEST(prefix_scan_mpi, segmented_int) { runAndCompare<int>(1000, prefix_scan_mpi::ScanKind::Segmented); }
+
+TEST(prefix_scan_mpi, segmented_long_segments_cross_ranks) {
+  runAndCompare<int>(1000, prefix_scan_mpi::ScanKind::Segmented, 400);
+}
+
+TEST(prefix_scan_mpi, inclusive_fewer_items_than_processes) {
+  runAndCompare<int>(2, prefix_scan_mpi::ScanKind::Inclusive);
+}
+
+TEST(prefix_scan_mpi, exclusive_single_item) { runAndCompare<int>(1, prefix_scan_mpi::ScanKind::Exclusive); }
+
+TEST(prefix_scan_mpi, inclusive_int8_widens) { runAndCompare<int8_t>(777, prefix_scan_mpi::ScanKind::Inclusive); }
+
+TEST(prefix_scan_mpi, exclusive_int16_into_int32) {
+  runAndCompare<int16_t, int32_t>(513, prefix_scan_mpi::ScanKind::Exclusive);
+}
+
+TEST(prefix_scan_mpi, inclusive_double) { runAndCompare<double>(300, prefix_scan_mpi::ScanKind::Inclusive); }
+
+TEST(prefix_scan_mpi, segmented_int64) { runAndCompare<int64_t>(450, prefix_scan_mpi::ScanKind::Segmented); }
+
+TEST(prefix_scan_mpi, validation_fails_without_heads) {
+  boost::mpi::communicator world;
+  std::vector<int> input(10, 1);
+  std::vector<int64_t> global_res(10);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(input.data()));
+    taskDataPar->inputs_count.emplace_back(input.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_res.data()));
+    taskDataPar->outputs_count.emplace_back(global_res.size());
+  }
+  prefix_scan_mpi::PrefixScanParallel<int> testMpiTaskParallel(taskDataPar, prefix_scan_mpi::ScanKind::Segmented);
+  if (world.rank() == 0) {
+    ASSERT_EQ(testMpiTaskParallel.validation(), false);
+  }
+}
+
+TEST(prefix_scan_mpi, validation_fails_on_wrong_output_size) {
+  boost::mpi::communicator world;
+  std::vector<int> input(10, 1);
+  std::vector<int64_t> global_res(9);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(input.data()));
+    taskDataPar->inputs_count.emplace_back(input.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_res.data()));
+    taskDataPar->outputs_count.emplace_back(global_res.size());
+  }
+  prefix_scan_mpi::PrefixScanParallel<int> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    ASSERT_EQ(testMpiTaskParallel.validation(), false);
+  }
+}
@@ -0,0 +1,167 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/scan.hpp"
+#include "core/kernels/include/simd.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/block_partition.hpp"
+#include "mpi/common/include/mpi_types.hpp"
+#include "mpi/common/include/scan.hpp"
+
+namespace prefix_scan_mpi {
+
+//  Inclusive - out[i] = in[0] + ... + in[i]
+//  Exclusive - out[i] = in[0] + ... + in[i - 1], out[0] = 0
+//  Segmented - inclusive scan that restarts at every i with heads[i] != 0
+enum class ScanKind { Inclusive, Exclusive, Segmented };
+
+namespace detail {
+
+inline bool isValidTaskData(const ppc::core::TaskData& taskData, ScanKind kind) {
+  const size_t num_inputs = kind == ScanKind::Segmented ? 2 : 1;
+  if (taskData.inputs.size() != num_inputs || taskData.inputs_count.size() != num_inputs ||
+      taskData.outputs.size() != 1 || taskData.outputs_count.size() != 1) {
+    return false;
+  }
+  return std::all_of(taskData.inputs_count.begin(), taskData.inputs_count.end(),
+                     [&](unsigned int count) { return count == taskData.outputs_count[0]; });
+}
+
+}  // namespace detail
+
+// Input: inputs[0] holds n values of T, inputs_count = {n}. A segmented scan also
+// takes inputs[1] with n uint8_t segment heads, inputs_count = {n, n}.
+// Output: outputs[0] receives n values of Out; by default integers are scanned
+// into 64 bit so that long prefix sums of narrow types do not overflow.
+template <class T, class Out = ppc::core::kernels::WideningAccumulatorT<T>>
+class PrefixScanSequential : public ppc::core::Task {
+ public:
+  explicit PrefixScanSequential(std::shared_ptr<ppc::core::TaskData> taskData_, ScanKind kind_ = ScanKind::Inclusive)
+      : Task(std::move(taskData_)), kind(kind_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    const auto n = taskData->inputs_count[0];
+    auto* tmp_ptr = reinterpret_cast<T*>(taskData->inputs[0]);
+    input_.assign(tmp_ptr, tmp_ptr + n);
+    if (kind == ScanKind::Segmented) {
+      heads_.assign(taskData->inputs[1], taskData->inputs[1] + n);
+    }
+    res_.resize(n);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return detail::isValidTaskData(*taskData, kind);
+  }
+
+  bool run() override {
+    internal_order_test();
+    if (kind == ScanKind::Inclusive) {
+      ppc::core::kernels::inclusiveScan(input_.data(), input_.size(), res_.data());
+    } else if (kind == ScanKind::Exclusive) {
+      ppc::core::kernels::exclusiveScan(input_.data(), input_.size(), res_.data());
+    } else {
+      ppc::core::kernels::segmentedInclusiveScan(input_.data(), heads_.data(), input_.size(), res_.data());
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(res_.begin(), res_.end(), reinterpret_cast<Out*>(taskData->outputs[0]));
+    return true;
+  }
+
+ private:
+  std::vector<T> input_;
+  std::vector<uint8_t> heads_;
+  std::vector<Out> res_;
+  ScanKind kind;
+};
+
+// Same contract as PrefixScanSequential. Rank 0 scatters contiguous blocks, every
+// rank scans its block with one MPI_Exscan for the block offsets (see
+// mpi/common/include/scan.hpp) and the scanned blocks are gathered back.
+template <class T, class Out = ppc::core::kernels::WideningAccumulatorT<T>>
+class PrefixScanParallel : public ppc::core::Task {
+ public:
+  explicit PrefixScanParallel(std::shared_ptr<ppc::core::TaskData> taskData_, ScanKind kind_ = ScanKind::Inclusive)
+      : Task(std::move(taskData_)), kind(kind_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    int n = 0;
+    if (world.rank() == 0) {
+      n = static_cast<int>(taskData->inputs_count[0]);
+    }
+    broadcast(world, n, 0);
+    partition_ = ppc::mpi::BlockPartition(n, world.size());
+    const int local_n = partition_.counts[world.rank()];
+
+    local_input_.resize(local_n);
+    const T* sendbuf = world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[0]) : nullptr;
+    MPI_Scatterv(sendbuf, partition_.counts.data(), partition_.displs.data(), ppc::mpi::mpiTypeOf<T>(),
+                 local_input_.data(), local_n, ppc::mpi::mpiTypeOf<T>(), 0, world);
+    if (kind == ScanKind::Segmented) {
+      local_heads_.resize(local_n);
+      const uint8_t* heads = world.rank() == 0 ? taskData->inputs[1] : nullptr;
+      MPI_Scatterv(heads, partition_.counts.data(), partition_.displs.data(), MPI_UINT8_T, local_heads_.data(),
+                   local_n, MPI_UINT8_T, 0, world);
+    }
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return detail::isValidTaskData(*taskData, kind);
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    local_res_.resize(local_input_.size());
+    if (kind == ScanKind::Inclusive) {
+      ppc::mpi::inclusiveScan(world, local_input_.data(), local_input_.size(), local_res_.data());
+    } else if (kind == ScanKind::Exclusive) {
+      ppc::mpi::exclusiveScan(world, local_input_.data(), local_input_.size(), local_res_.data());
+    } else {
+      ppc::mpi::segmentedInclusiveScan(world, local_input_.data(), local_heads_.data(), local_input_.size(),
+                                       local_res_.data());
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    Out* recvbuf = world.rank() == 0 ? reinterpret_cast<Out*>(taskData->outputs[0]) : nullptr;
+    MPI_Gatherv(local_res_.data(), static_cast<int>(local_res_.size()), ppc::mpi::mpiTypeOf<Out>(), recvbuf,
+                partition_.counts.data(), partition_.displs.data(), ppc::mpi::mpiTypeOf<Out>(), 0, world);
+    return true;
+  }
+
+ private:
+  std::vector<T> local_input_;
+  std::vector<uint8_t> local_heads_;
+  std::vector<Out> local_res_;
+  ppc::mpi::BlockPartition partition_{0, 1};
+  ScanKind kind;
+  boost::mpi::communicator world;
+};
+
+}  // namespace prefix_scan_mpi
@@ -0,0 +1,69 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/prefix_scan/include/ops_mpi.hpp"
+
+namespace {
+
+// All ones, so the inclusive scan is 1, 2, 3, ... and is checked without a
+// reference run.
+const int kCount = 20000000;
+
+void runPerf(bool pipeline) {
+  boost::mpi::communicator world;
+  std::vector<int> input;
+  std::vector<int64_t> global_res;
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    input.assign(kCount, 1);
+    global_res.resize(kCount);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(input.data()));
+    taskDataPar->inputs_count.emplace_back(input.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_res.data()));
+    taskDataPar->outputs_count.emplace_back(global_res.size());
+  }
+
+  auto testMpiTaskParallel = std::make_shared<prefix_scan_mpi::PrefixScanParallel<int>>(taskDataPar);
+  ASSERT_EQ(testMpiTaskParallel->validation(), true);
+  testMpiTaskParallel->pre_processing();
+  testMpiTaskParallel->run();
+  testMpiTaskParallel->post_processing();
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->bytes_per_run = static_cast<uint64_t>(kCount) * (sizeof(int) + sizeof(int64_t));
+  perfAttr->data_type = ppc::core::kernels::typeName<int>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    ASSERT_EQ(global_res.front(), 1);
+    ASSERT_EQ(global_res[kCount / 2], kCount / 2 + 1);
+    ASSERT_EQ(global_res.back(), kCount);
+  }
+}
+
+}  // namespace
+
+TEST(prefix_scan_mpi_perf_test, test_pipeline_run) { runPerf(true); }
+
+TEST(prefix_scan_mpi_perf_test, test_task_run) { runPerf(false); }
@@ -0,0 +1,192 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/testing/include/compare.hpp"
+#include "mpi/rank_determinant/include/ops_mpi.hpp"
+
+namespace {
+
+// rows x cols product of random rows x rank and rank x cols factors, of rank
+// `rank` with probability one.
+std::vector<double> makeLowRank(int rows, int cols, int rank) {
+  std::random_device dev;
+  std::mt19937 gen(dev());
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> left(static_cast<size_t>(rows) * rank);
+  std::vector<double> right(static_cast<size_t>(rank) * cols);
+  for (auto& value : left) value = dist(gen);
+  for (auto& value : right) value = dist(gen);
+  std::vector<double> a(static_cast<size_t>(rows) * cols, 0.0);
+  for (int i = 0; i < rows; i++) {
+    for (int k = 0; k < rank; k++) {
+      for (int j = 0; j < cols; j++) a[i * cols + j] += left[i * rank + k] * right[k * cols + j];
+    }
+  }
+  return a;
+}
+
+// L U with L unit lower triangular (small off-diagonal entries, so A stays
+// well conditioned) and U upper triangular with the given diagonal, rows
+// shuffled by a cyclic shift by one (sign (-1)^(n - 1)), so det A =
+// (-1)^(n - 1) prod diagonal.
+std::vector<double> makeWithDeterminant(const std::vector<double>& diagonal) {
+  const int n = static_cast<int>(diagonal.size());
+  std::random_device dev;
+  std::mt19937 gen(dev());
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> l(static_cast<size_t>(n) * n, 0.0);
+  std::vector<double> u(static_cast<size_t>(n) * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    l[i * n + i] = 1.0;
+    u[i * n + i] = diagonal[i];
+    for (int j = 0; j < i; j++) l[i * n + j] = dist(gen) / n;
+    for (int j = i + 1; j < n; j++) u[i * n + j] = dist(gen);
+  }
+  std::vector<double> a(static_cast<size_t>(n) * n, 0.0);
+  for (int i = 0; i < n; i++) {
+    const int target = (i + 1) % n;
+    for (int k = 0; k <= i; k++) {
+      for (int j = k; j < n; j++) a[target * n + j] += l[i * n + k] * u[k * n + j];
+    }
+  }
+  return a;
+}
+
+struct Outcome {
+  int rank = -1;
+  double determinant = 0.0;
+};
+
+std::vector<uint8_t*> outputsOf(Outcome& outcome, bool with_determinant) {
+  std::vector<uint8_t*> outputs{reinterpret_cast<uint8_t*>(&outcome.rank)};
+  if (with_determinant) outputs.emplace_back(reinterpret_cast<uint8_t*>(&outcome.determinant));
+  return outputs;
+}
+
+std::shared_ptr<ppc::core::TaskData> makeTaskData(int rows, int cols, std::vector<double>& a, Outcome& outcome,
+                                                  bool with_determinant) {
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+  taskData->inputs_count = {static_cast<uint32_t>(rows), static_cast<uint32_t>(cols)};
+  taskData->outputs = outputsOf(outcome, with_determinant);
+  taskData->outputs_count.assign(taskData->outputs.size(), 1);
+  return taskData;
+}
+
+// Runs both tasks on `a` (significant on rank 0 only) and checks the rank
+// and, for a square matrix, the determinant against the expected values.
+// run() is called `runs` times, as the perf harness does.
+void runAndCompare(int rows, int cols, std::vector<double> a, int expected_rank, double expected_determinant = 0.0,
+                   int runs = 1) {
+  boost::mpi::communicator world;
+  const bool square = rows == cols;
+  Outcome parallel;
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(rows, cols, a, parallel, square);
+  }
+
+  rank_determinant_mpi::RankDeterminantParallel<double> testMpiTaskParallel(taskDataPar);
+  ppc::core::testing::runTask(testMpiTaskParallel, runs);
+
+  if (world.rank() == 0) {
+    Outcome sequential;
+    auto taskDataSeq = ppc::core::testing::withOutputs(taskDataPar, outputsOf(sequential, square));
+    rank_determinant_mpi::RankDeterminantSequential<double> testMpiTaskSequential(taskDataSeq);
+    ppc::core::testing::runTask(testMpiTaskSequential, runs);
+
+    EXPECT_EQ(parallel.rank, expected_rank);
+    EXPECT_EQ(sequential.rank, expected_rank);
+    if (square) {
+      const double tolerance = 1e-9 * std::max(1.0, std::abs(expected_determinant));
+      EXPECT_NEAR(parallel.determinant, expected_determinant, tolerance);
+      EXPECT_NEAR(sequential.determinant, expected_determinant, tolerance);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(rank_determinant_mpi, two_by_two) { runAndCompare(2, 2, {1.0, 2.0, 3.0, 4.0}, 2, -2.0); }
+
+TEST(rank_determinant_mpi, identity) {
+  const int n = 17;
+  std::vector<double> a(n * n, 0.0);
+  for (int i = 0; i < n; i++) a[i * n + i] = 1.0;
+  runAndCompare(n, n, a, n, 1.0);
+}
+
+TEST(rank_determinant_mpi, known_determinant) {
+  runAndCompare(6, 6, makeWithDeterminant({2.0, -1.5, 0.5, 3.0, 1.0, -2.0}), 6, -(2.0 * -1.5 * 0.5 * 3.0 * -2.0));
+}
+
+TEST(rank_determinant_mpi, known_determinant_odd_size) {
+  runAndCompare(5, 5, makeWithDeterminant({1.5, -2.0, 0.25, 4.0, 1.0}), 5, 1.5 * -2.0 * 0.25 * 4.0);
+}
+
+TEST(rank_determinant_mpi, repeated_runs) {
+  runAndCompare(6, 6, makeWithDeterminant({2.0, -1.5, 0.5, 3.0, 1.0, -2.0}), 6, -(2.0 * -1.5 * 0.5 * 3.0 * -2.0), 2);
+}
+
+TEST(rank_determinant_mpi, larger_full_rank) {
+  std::vector<double> diagonal(60);
+  for (int i = 0; i < 60; i++) diagonal[i] = i % 3 == 0 ? -1.25 : 0.8;
+  double expected = -1.0;  // cyclic shift of 60 rows
+  for (double value : diagonal) expected *= value;
+  runAndCompare(60, 60, makeWithDeterminant(diagonal), 60, expected);
+}
+
+TEST(rank_determinant_mpi, rank_deficient_square) { runAndCompare(40, 40, makeLowRank(40, 40, 23), 23); }
+
+TEST(rank_determinant_mpi, rank_one) { runAndCompare(30, 30, makeLowRank(30, 30, 1), 1); }
+
+TEST(rank_determinant_mpi, zero_matrix) { runAndCompare(7, 7, std::vector<double>(49, 0.0), 0); }
+
+TEST(rank_determinant_mpi, duplicate_rows) {
+  runAndCompare(3, 3, {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 1.0, 2.0, 3.0}, 2);
+}
+
+TEST(rank_determinant_mpi, wide_matrix) { runAndCompare(12, 35, makeLowRank(12, 35, 12), 12); }
+
+TEST(rank_determinant_mpi, tall_rank_deficient_matrix) { runAndCompare(50, 9, makeLowRank(50, 9, 6), 6); }
+
+TEST(rank_determinant_mpi, single_row) { runAndCompare(1, 4, {0.0, 0.0, 2.0, 1.0}, 1); }
+
+TEST(rank_determinant_mpi, fewer_rows_than_processes) { runAndCompare(2, 3, {1.0, 2.0, 3.0, 2.0, 4.0, 6.0}, 1); }
+
+TEST(rank_determinant_mpi, validation_fails_on_determinant_of_rectangular_matrix) {
+  boost::mpi::communicator world;
+  std::vector<double> a(6, 1.0);
+  Outcome outcome;
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(2, 3, a, outcome, true);
+  }
+  rank_determinant_mpi::RankDeterminantParallel<double> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    ASSERT_EQ(testMpiTaskParallel.validation(), false);
+  }
+}
+
+TEST(rank_determinant_mpi, validation_fails_on_empty_matrix) {
+  boost::mpi::communicator world;
+  std::vector<double> a;
+  Outcome outcome;
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(0, 0, a, outcome, false);
+  }
+  rank_determinant_mpi::RankDeterminantParallel<double> testMpiTaskParallel(taskDataPar);
+  if (world.rank() == 0) {
+    ASSERT_EQ(testMpiTaskParallel.validation(), false);
+  }
+}
@@ -0,0 +1,143 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/echelon.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/echelon.hpp"
+
+namespace rank_determinant_mpi {
+
+// Rank and determinant of A by Gaussian elimination with complete pivoting
+// (ppc::core::kernels::rowEchelon()). Input: inputs[0] is A
+// (rows x cols, row-major), inputs_count = {rows, cols}. Output: outputs[0]
+// receives the rank as an int, outputs_count = {1}; for a square A an optional
+// outputs[1] receives det A as a T (zero if A is singular), outputs_count =
+// {1, 1}. Pivots of magnitude at most `tolerance` count as zero; negative
+// means ppc::core::kernels::rankTolerance().
+inline bool isValidTaskData(const ppc::core::TaskData& taskData) {
+  if (taskData.inputs.size() != 1 || taskData.inputs_count.size() != 2) return false;
+  if (taskData.inputs_count[0] == 0 || taskData.inputs_count[1] == 0) return false;
+  if (taskData.outputs.empty() || taskData.outputs.size() > 2) return false;
+  if (taskData.outputs_count.size() != taskData.outputs.size()) return false;
+  for (auto count : taskData.outputs_count) {
+    if (count != 1) return false;
+  }
+  return taskData.outputs.size() == 1 || taskData.inputs_count[0] == taskData.inputs_count[1];
+}
+
+template <class T>
+class RankDeterminantSequential : public ppc::core::Task {
+ public:
+  explicit RankDeterminantSequential(std::shared_ptr<ppc::core::TaskData> taskData_, double tolerance_ = -1.0)
+      : Task(std::move(taskData_)), tolerance(tolerance_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    rows = taskData->inputs_count[0];
+    cols = taskData->inputs_count[1];
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return isValidTaskData(*taskData);
+  }
+
+  bool run() override {
+    internal_order_test();
+    // rowEchelon() reduces its copy of A in place, so every run takes a fresh one.
+    auto* a = reinterpret_cast<T*>(taskData->inputs[0]);
+    a_.assign(a, a + rows * cols);
+    result_ = ppc::core::kernels::rowEchelon(rows, cols, a_.data(), cols, tolerance);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    *reinterpret_cast<int*>(taskData->outputs[0]) = static_cast<int>(result_.rank);
+    if (taskData->outputs.size() == 2) {
+      *reinterpret_cast<T*>(taskData->outputs[1]) = static_cast<T>(result_.determinant.value());
+    }
+    return true;
+  }
+
+  // Sign and log |det A|, which stay representable when det A itself
+  // overflows T.
+  [[nodiscard]] const ppc::core::kernels::Determinant& determinant() const { return result_.determinant; }
+
+ private:
+  double tolerance;
+  size_t rows{};
+  size_t cols{};
+  std::vector<T> a_;
+  ppc::core::kernels::EchelonResult result_;
+};
+
+// Same contract; rank 0 deals the rows of A cyclically and
+// ppc::mpi::rowEchelon() eliminates them in place, electing each pivot with
+// one reduction.
+template <class T>
+class RankDeterminantParallel : public ppc::core::Task {
+ public:
+  explicit RankDeterminantParallel(std::shared_ptr<ppc::core::TaskData> taskData_, double tolerance_ = -1.0)
+      : Task(std::move(taskData_)), tolerance(tolerance_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    std::array<int, 2> sizes{};
+    if (world.rank() == 0) {
+      sizes = {static_cast<int>(taskData->inputs_count[0]), static_cast<int>(taskData->inputs_count[1])};
+    }
+    boost::mpi::broadcast(world, sizes.data(), 2, 0);
+    rows = sizes[0];
+    cols = sizes[1];
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return isValidTaskData(*taskData);
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    const T* a = world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[0]) : nullptr;
+    result_ = ppc::mpi::rowEchelon(world, rows, cols, a, tolerance);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      *reinterpret_cast<int*>(taskData->outputs[0]) = static_cast<int>(result_.rank);
+      if (taskData->outputs.size() == 2) {
+        *reinterpret_cast<T*>(taskData->outputs[1]) = static_cast<T>(result_.determinant.value());
+      }
+    }
+    return true;
+  }
+
+  // As in RankDeterminantSequential, on every process.
+  [[nodiscard]] const ppc::core::kernels::Determinant& determinant() const { return result_.determinant; }
+
+ private:
+  double tolerance;
+  int rows{};
+  int cols{};
+  ppc::core::kernels::EchelonResult result_;
+  boost::mpi::communicator world;
+};
+
+}  // namespace rank_determinant_mpi
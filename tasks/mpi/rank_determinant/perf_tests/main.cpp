@@ -0,0 +1,75 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/kernels/include/lu.hpp"
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/rank_determinant/include/ops_mpi.hpp"
+
+namespace {
+
+// Dense random 384 x 384 matrix: about 2/3 n^3 flops of elimination plus as
+// many comparisons in the pivot searches.
+constexpr int kSize = 384;
+
+void runPerf(bool pipeline) {
+  boost::mpi::communicator world;
+  std::vector<double> a;
+  int rank = 0;
+  double determinant = 0.0;
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    a.resize(static_cast<size_t>(kSize) * kSize);
+    for (auto& value : a) value = dist(gen);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+    taskDataPar->inputs_count = {kSize, kSize};
+    taskDataPar->outputs = {reinterpret_cast<uint8_t*>(&rank), reinterpret_cast<uint8_t*>(&determinant)};
+    taskDataPar->outputs_count = {1, 1};
+  }
+
+  auto testMpiTaskParallel = std::make_shared<rank_determinant_mpi::RankDeterminantParallel<double>>(taskDataPar);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->flops_per_run = 2ULL * kSize * kSize * kSize / 3;
+  perfAttr->data_type = ppc::core::kernels::typeName<double>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    ASSERT_EQ(rank, kSize);
+    // |det A| is far beyond the largest double for a random matrix of this
+    // size; compare it in log form with the LU one.
+    const auto reference = ppc::core::kernels::LuFactors<double>::factorise(kSize, a.data()).determinant();
+    EXPECT_EQ(testMpiTaskParallel->determinant().sign, reference.sign);
+    EXPECT_NEAR(testMpiTaskParallel->determinant().log_abs, reference.log_abs, 1e-8 * std::abs(reference.log_abs));
+  }
+}
+
+}  // namespace
+
+TEST(rank_determinant_mpi_perf_test, test_pipeline_run) { runPerf(true); }
+
+TEST(rank_determinant_mpi_perf_test, test_task_run) { runPerf(false); }
@@ -0,0 +1,210 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/testing/include/compare.hpp"
+#include "mpi/red_black_sor/include/ops_mpi.hpp"
+
+namespace {
+
+std::shared_ptr<ppc::core::TaskData> makeTaskData(int rows, int cols, std::vector<double>& u, std::vector<double>& f,
+                                                  std::vector<double>& out) {
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(u.data()));
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(f.data()));
+  taskData->inputs_count = {static_cast<uint32_t>(rows), static_cast<uint32_t>(cols)};
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  return taskData;
+}
+
+std::vector<double> getRandomVector(size_t size) {
+  std::random_device dev;
+  std::mt19937 gen(dev());
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> vec(size);
+  for (auto& value : vec) value = dist(gen);
+  return vec;
+}
+
+// Red-black ordering makes every update independent of the thread and process
+// count, so the parallel result must equal the sequential one exactly.
+void runAndCompare(int rows, int cols, red_black_sor_mpi::SorParams<double> params, int num_threads = 2) {
+  boost::mpi::communicator world;
+  std::vector<double> u;
+  std::vector<double> f;
+  std::vector<double> out(static_cast<size_t>(rows) * cols);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    u = getRandomVector(out.size());
+    f = getRandomVector(out.size());
+    taskDataPar = makeTaskData(rows, cols, u, f, out);
+  }
+
+  red_black_sor_mpi::SorParallel<double> testMpiTaskParallel(taskDataPar, params, num_threads);
+  ppc::core::testing::runTask(testMpiTaskParallel);
+
+  if (world.rank() == 0) {
+    std::vector<double> reference(out.size());
+    auto taskDataSeq = ppc::core::testing::withOutputs(taskDataPar, {reinterpret_cast<uint8_t*>(reference.data())});
+    red_black_sor_mpi::SorSequential<double> testMpiTaskSequential(taskDataSeq, params);
+    ppc::core::testing::runTask(testMpiTaskSequential);
+
+    const auto& stats = testMpiTaskParallel.stats();
+    EXPECT_TRUE(stats.converged);
+    if (params.check.mode == ppc::mpi::CheckMode::Exact) {
+      EXPECT_EQ(stats.iterations, testMpiTaskSequential.iterations());
+      EXPECT_EQ(out, reference);
+    } else {
+      EXPECT_LE(stats.wasted_sweeps, params.check.interval);
+      for (size_t i = 0; i < out.size(); i++) {
+        ASSERT_NEAR(out[i], reference[i], 1e-8);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(red_black_sor_mpi, matches_sequential) {
+  runAndCompare(40, 30, {red_black_sor_mpi::optimalOmega<double>(40, 30), 1e-12, 5000});
+}
+
+TEST(red_black_sor_mpi, gauss_seidel_matches_sequential) { runAndCompare(17, 23, {1.0, 1e-12, 5000}); }
+
+TEST(red_black_sor_mpi, fewer_rows_than_processes) { runAndCompare(3, 10, {1.2, 1e-12, 5000}); }
+
+TEST(red_black_sor_mpi, single_thread) {
+  runAndCompare(33, 33, {red_black_sor_mpi::optimalOmega<double>(33, 33), 1e-12, 5000}, 1);
+}
+
+TEST(red_black_sor_mpi, check_every_fourth_sweep) {
+  runAndCompare(33, 20, {1.5, 1e-12, 5000, {4, ppc::mpi::CheckMode::Exact}});
+}
+
+TEST(red_black_sor_mpi, speculative_check) {
+  runAndCompare(33, 20, {1.5, 1e-12, 5000, {2, ppc::mpi::CheckMode::Speculative}});
+}
+
+// u = i^2 + j^2 has a constant discrete Laplacian of 4, so with f = -4 and the
+// boundary taken from u, the iteration must reproduce u in the interior.
+TEST(red_black_sor_mpi, solves_quadratic_exactly) {
+  boost::mpi::communicator world;
+  const int rows = 25;
+  const int cols = 31;
+  std::vector<double> u(rows * cols);
+  std::vector<double> f(rows * cols, -4.0);
+  std::vector<double> out(rows * cols);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) {
+        const bool border = i == 0 || j == 0 || i == rows - 1 || j == cols - 1;
+        u[i * cols + j] = border ? i * i + j * j : 0.0;
+      }
+    }
+    taskDataPar = makeTaskData(rows, cols, u, f, out);
+  }
+  red_black_sor_mpi::SorParallel<double> testMpiTaskParallel(
+      taskDataPar, {red_black_sor_mpi::optimalOmega<double>(rows, cols), 1e-12, 5000});
+  ppc::core::testing::runTask(testMpiTaskParallel);
+  if (world.rank() == 0) {
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) {
+        ASSERT_NEAR(out[i * cols + j], i * i + j * j, 1e-8);
+      }
+    }
+  }
+}
+
+TEST(red_black_sor_mpi, optimal_omega_beats_gauss_seidel) {
+  boost::mpi::communicator world;
+  const int n = 49;
+  std::vector<double> u(n * n, 0.0);
+  std::vector<double> f(n * n, 1.0);
+  std::vector<double> out(n * n);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(n, n, u, f, out);
+  }
+  const double omega = red_black_sor_mpi::optimalOmega<double>(n, n);
+  red_black_sor_mpi::SorParallel<double> sor(taskDataPar, {omega, 1e-10, 20000});
+  ppc::core::testing::runTask(sor);
+  red_black_sor_mpi::SorParallel<double> gauss_seidel(taskDataPar, {1.0, 1e-10, 20000});
+  ppc::core::testing::runTask(gauss_seidel);
+  if (world.rank() == 0) {
+    EXPECT_TRUE(sor.stats().converged);
+    EXPECT_TRUE(gauss_seidel.stats().converged);
+    EXPECT_LT(sor.stats().iterations * 5, gauss_seidel.stats().iterations);
+  }
+}
+
+// Ten sweeps do not converge, so a second run() continuing from the result of
+// the first one would give a different u.
+TEST(red_black_sor_mpi, repeated_runs_start_from_initial_guess) {
+  boost::mpi::communicator world;
+  const int n = 21;
+  std::vector<double> u(n * n, 0.0);
+  std::vector<double> f(n * n, 1.0);
+  std::vector<double> once(n * n);
+  std::vector<double> twice(n * n);
+  std::shared_ptr<ppc::core::TaskData> taskDataOnce = std::make_shared<ppc::core::TaskData>();
+  std::shared_ptr<ppc::core::TaskData> taskDataTwice = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataOnce = makeTaskData(n, n, u, f, once);
+    taskDataTwice = makeTaskData(n, n, u, f, twice);
+  }
+  const red_black_sor_mpi::SorParams<double> params{1.5, 1e-12, 10};
+  red_black_sor_mpi::SorParallel<double> parallelOnce(taskDataOnce, params);
+  ppc::core::testing::runTask(parallelOnce);
+  red_black_sor_mpi::SorParallel<double> parallelTwice(taskDataTwice, params);
+  ppc::core::testing::runTask(parallelTwice, 2);
+  if (world.rank() == 0) {
+    EXPECT_EQ(once, twice);
+    std::vector<double> reference(n * n);
+    auto taskDataSeq = makeTaskData(n, n, u, f, reference);
+    red_black_sor_mpi::SorSequential<double> sequentialTwice(taskDataSeq, params);
+    ppc::core::testing::runTask(sequentialTwice, 2);
+    EXPECT_EQ(reference, once);
+  }
+}
+
+TEST(red_black_sor_mpi, validation_fails_on_bad_params) {
+  boost::mpi::communicator world;
+  std::vector<double> u(9);
+  std::vector<double> f(9);
+  std::vector<double> out(9);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(3, 3, u, f, out);
+  }
+  red_black_sor_mpi::SorParallel<double> omega_two(taskDataPar, {2.0, 1e-9, 100});
+  red_black_sor_mpi::SorParallel<double> zero_eps(taskDataPar, {1.0, 0.0, 100});
+  red_black_sor_mpi::SorParallel<double> no_threads(taskDataPar, {1.0, 1e-9, 100}, 0);
+  if (world.rank() == 0) {
+    EXPECT_FALSE(omega_two.validation());
+    EXPECT_FALSE(zero_eps.validation());
+    EXPECT_FALSE(no_threads.validation());
+  }
+}
+
+TEST(red_black_sor_mpi, validation_fails_on_grid_without_interior) {
+  boost::mpi::communicator world;
+  std::vector<double> u(8);
+  std::vector<double> f(8);
+  std::vector<double> out(8);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar = makeTaskData(2, 4, u, f, out);
+  }
+  red_black_sor_mpi::SorParallel<double> testMpiTaskParallel(taskDataPar, {1.0, 1e-9, 100});
+  if (world.rank() == 0) {
+    EXPECT_FALSE(testMpiTaskParallel.validation());
+  }
+}
@@ -0,0 +1,263 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/parallel.hpp"
+#include "core/task/include/task.hpp"
+#include "mpi/common/include/convergence.hpp"
+#include "mpi/common/include/distributed_matrix.hpp"
+#include "mpi/common/include/process_grid.hpp"
+
+namespace red_black_sor_mpi {
+
+// Successive over-relaxation for the 5-point discretisation of -lap(u) = f on
+// a rows x cols grid with Dirichlet boundary: every interior cell solves
+// 4 u[i][j] - u[i-1][j] - u[i+1][j] - u[i][j-1] - u[i][j+1] = f[i][j]
+// (f already scaled by the squared mesh step). The cells are coloured like a
+// chessboard by (i + j) % 2; a cell's neighbours all have the other colour, so
+// each half-sweep updates one colour in any order and in parallel, and the
+// result is the same for every thread and process count.
+//
+// Input: inputs[0] is u (rows x cols, row-major; the border holds the boundary
+// values and the interior the initial guess), inputs[1] is f (rows x cols, the
+// border is ignored), inputs_count = {rows, cols}. Output: outputs[0] receives
+// rows * cols values of u.
+template <class T>
+struct SorParams {
+  T omega;
+  T eps;
+  int max_iterations;
+  ppc::mpi::ConvergencePolicy check{};
+};
+
+// Optimal relaxation factor for the Poisson problem on a rows x cols grid:
+// 2 / (1 + sqrt(1 - rho^2)) with rho the spectral radius of the Jacobi
+// iteration. It cuts the sweep count from O(n^2) (Gauss-Seidel, omega = 1) to
+// O(n).
+template <class T>
+T optimalOmega(int rows, int cols) {
+  const double pi = std::acos(-1.0);
+  const double rho = (std::cos(pi / (rows - 1)) + std::cos(pi / (cols - 1))) / 2;
+  return static_cast<T>(2.0 / (1.0 + std::sqrt(1.0 - rho * rho)));
+}
+
+template <class T>
+bool isValidTaskData(const ppc::core::TaskData& taskData, const SorParams<T>& params) {
+  return taskData.inputs.size() == 2 && taskData.inputs_count.size() == 2 && taskData.outputs.size() == 1 &&
+         taskData.outputs_count.size() == 1 && taskData.inputs_count[0] >= 3 && taskData.inputs_count[1] >= 3 &&
+         taskData.outputs_count[0] == taskData.inputs_count[0] * taskData.inputs_count[1] && params.omega > T{} &&
+         params.omega < T{2} && params.eps > T{} && params.max_iterations > 0;
+}
+
+namespace detail {
+
+// Over-relaxes the cells of `colour` in the interior rows among local rows
+// [0, local_rows) of `u` (row stride cols); local row r is global row
+// first_row + r, and rows -1 and local_rows must be readable. Rows are split
+// between num_threads threads. Returns the largest change.
+template <class T>
+T relaxColour(T* u, const T* f, int cols, int local_rows, int first_row, int global_rows, int colour, T omega,
+              int num_threads) {
+  const int begin = std::max(0, 1 - first_row);
+  const int end = std::min(local_rows, global_rows - 1 - first_row);
+  if (begin >= end) return T{};
+  std::vector<T> chunk_change(std::max(num_threads, 1), T{});
+  const std::size_t min_rows = std::max<std::size_t>(1, ppc::core::kernels::detail::kMinChunk / cols);
+  ppc::core::kernels::detail::forEachChunk(
+      end - begin, num_threads,
+      [&](std::size_t chunk, std::size_t chunk_begin, std::size_t chunk_end) {
+        T change{};
+        for (int r = begin + static_cast<int>(chunk_begin); r < begin + static_cast<int>(chunk_end); r++) {
+          T* row = u + static_cast<std::ptrdiff_t>(r) * cols;
+          const T* up = row - cols;
+          const T* down = row + cols;
+          const T* rhs = f + static_cast<std::ptrdiff_t>(r) * cols;
+          // First column j >= 1 with (i + j) % 2 == colour.
+          for (int j = 1 + (first_row + r + 1 + colour) % 2; j < cols - 1; j += 2) {
+            const T delta = omega * ((up[j] + down[j] + row[j - 1] + row[j + 1] + rhs[j]) / 4 - row[j]);
+            row[j] += delta;
+            change = std::max(change, std::abs(delta));
+          }
+        }
+        chunk_change[chunk] = change;
+      },
+      min_rows);
+  return *std::max_element(chunk_change.begin(), chunk_change.end());
+}
+
+}  // namespace detail
+
+template <class T>
+class SorSequential : public ppc::core::Task {
+ public:
+  explicit SorSequential(std::shared_ptr<ppc::core::TaskData> taskData_, SorParams<T> params_)
+      : Task(std::move(taskData_)), params(params_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    rows = static_cast<int>(taskData->inputs_count[0]);
+    cols = static_cast<int>(taskData->inputs_count[1]);
+    auto* f = reinterpret_cast<T*>(taskData->inputs[1]);
+    f_.assign(f, f + rows * cols);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return isValidTaskData(*taskData, params);
+  }
+
+  bool run() override {
+    internal_order_test();
+    // The sweeps update u in place, so every run starts from the initial guess.
+    auto* u = reinterpret_cast<T*>(taskData->inputs[0]);
+    u_.assign(u, u + rows * cols);
+    const int interval = std::max(1, params.check.interval);
+    iterations_ = 0;
+    while (iterations_ < params.max_iterations) {
+      iterations_++;
+      T change{};
+      for (int colour = 0; colour < 2; colour++) {
+        change =
+            std::max(change, detail::relaxColour(u_.data(), f_.data(), cols, rows, 0, rows, colour, params.omega, 1));
+      }
+      if (iterations_ % interval == 0 && change <= params.eps) break;
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(u_.begin(), u_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    return true;
+  }
+
+  [[nodiscard]] int iterations() const { return iterations_; }
+
+ private:
+  SorParams<T> params;
+  std::vector<T> u_;
+  std::vector<T> f_;
+  int rows{};
+  int cols{};
+  int iterations_{};
+};
+
+// Same contract as SorSequential. The grid is split into blocks of rows, one
+// per process (processes past the row count stay idle), held as
+// ppc::mpi::DistributedMatrix with one ghost row above and below. Every
+// half-sweep updates one colour on num_threads_ threads and refreshes the
+// ghost rows from the neighbouring processes. The stopping test goes through
+// a ppc::mpi::ConvergenceCheck; as the update is in place, an Exact check is
+// completed straight away and only a Speculative one overlaps the next sweeps.
+template <class T>
+class SorParallel : public ppc::core::Task {
+ public:
+  explicit SorParallel(std::shared_ptr<ppc::core::TaskData> taskData_, SorParams<T> params_, int num_threads_ = 1)
+      : Task(std::move(taskData_)), params(params_), num_threads(num_threads_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    std::array<int, 2> shape{};
+    if (world.rank() == 0) {
+      shape = {static_cast<int>(taskData->inputs_count[0]), static_cast<int>(taskData->inputs_count[1])};
+    }
+    broadcast(world, shape.data(), 2, 0);
+    rows = shape[0];
+    cols = shape[1];
+    grid_ = std::make_shared<const ppc::mpi::ProcessGrid>(world, std::array<int, 2>{std::min(world.size(), rows), 1},
+                                                          false);
+    if (!grid_->member()) return true;
+    const auto row_layout = ppc::mpi::Layout1D::block(rows, grid_->rows());
+    const auto col_layout = ppc::mpi::Layout1D::block(cols, 1);
+    u_.emplace(grid_, row_layout, col_layout, 1);
+    f_.emplace(grid_, row_layout, col_layout);
+    f_->scatter(world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[1]) : nullptr);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    if (world.rank() == 0) {
+      return isValidTaskData(*taskData, params) && num_threads > 0;
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    if (!grid_->member()) return true;
+    // As in SorSequential, every run starts from the initial guess.
+    u_->scatter(world.rank() == 0 ? reinterpret_cast<T*>(taskData->inputs[0]) : nullptr);
+    u_->exchangeGhosts();
+    const double start = MPI_Wtime();
+    const int interval = std::max(1, params.check.interval);
+    const int first_row = u_->rowLayout().toGlobal(grid_->row(), 0);
+    stats_ = {};
+    ppc::mpi::ConvergenceCheck<T> check(grid_->cart());
+    for (int sweep = 1; sweep <= params.max_iterations; sweep++) {
+      T change{};
+      for (int colour = 0; colour < 2; colour++) {
+        change = std::max(change, detail::relaxColour(u_->data(), f_->data(), cols, u_->localRows(), first_row, rows,
+                                                      colour, params.omega, num_threads));
+        u_->exchangeGhosts();
+      }
+      stats_.iterations = sweep;
+      if (sweep % interval != 0) continue;
+      if (check.pending() && check.wait() <= params.eps) {
+        stats_.converged = true;
+        stats_.wasted_sweeps = sweep - check.sweep();
+        break;
+      }
+      stats_.checks++;
+      check.start(change, sweep);
+      if (params.check.mode == ppc::mpi::CheckMode::Exact && check.wait() <= params.eps) {
+        stats_.converged = true;
+        break;
+      }
+    }
+    if (check.pending() && check.wait() <= params.eps) {
+      stats_.converged = true;
+      stats_.wasted_sweeps = stats_.iterations - check.sweep();
+    }
+    stats_.seconds = MPI_Wtime() - start;
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    if (!grid_->member()) return true;
+    u_->gather(world.rank() == 0 ? reinterpret_cast<T*>(taskData->outputs[0]) : nullptr);
+    return true;
+  }
+
+  // Sweeps, checks, wasted sweeps and wall time of run() (on the processes
+  // that hold rows).
+  [[nodiscard]] const ppc::mpi::SolveStats& stats() const { return stats_; }
+
+ private:
+  std::shared_ptr<const ppc::mpi::ProcessGrid> grid_;
+  std::optional<ppc::mpi::DistributedMatrix<T>> u_;
+  std::optional<ppc::mpi::DistributedMatrix<T>> f_;
+  ppc::mpi::SolveStats stats_;
+  SorParams<T> params;
+  int num_threads;
+  int rows{};
+  int cols{};
+  boost::mpi::communicator world;
+};
+
+}  // namespace red_black_sor_mpi
@@ -0,0 +1,175 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/timer.hpp>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "mpi/jacobi_method/include/ops_mpi.hpp"
+#include "mpi/red_black_sor/include/ops_mpi.hpp"
+
+namespace {
+
+// Poisson problem with f = 1 and a zero boundary on a 512 x 512 grid, solved
+// to a fixed tolerance with the optimal relaxation factor, so the measured time
+// is the time to convergence. It takes O(n) sweeps (about 2400); Jacobi and
+// Gauss-Seidel (omega = 1) need O(n^2) for the same tolerance.
+const int kSize = 512;
+
+void runPerf(bool pipeline) {
+  boost::mpi::communicator world;
+  const red_black_sor_mpi::SorParams<double> params{red_black_sor_mpi::optimalOmega<double>(kSize, kSize), 1e-9,
+                                                     10000};
+  std::vector<double> u;
+  std::vector<double> f;
+  std::vector<double> out;
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    u.assign(static_cast<size_t>(kSize) * kSize, 0.0);
+    f.assign(u.size(), 1.0);
+    out.resize(u.size());
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(u.data()));
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(f.data()));
+    taskDataPar->inputs_count = {kSize, kSize};
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    taskDataPar->outputs_count.emplace_back(out.size());
+  }
+
+  auto testMpiTaskParallel = std::make_shared<red_black_sor_mpi::SorParallel<double>>(taskDataPar, params);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->data_type = ppc::core::kernels::typeName<double>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    const auto& stats = testMpiTaskParallel->stats();
+    EXPECT_TRUE(stats.converged);
+    EXPECT_LT(stats.iterations, 5 * kSize);
+    // The solution is symmetric about the centre and positive inside.
+    for (int i = 1; i < kSize - 1; i++) {
+      ASSERT_GT(out[i * kSize + i], 0.0);
+      ASSERT_NEAR(out[i * kSize + 7], out[7 * kSize + i], 1e-6);
+    }
+  }
+}
+
+// Runs `task` once under the perf harness and prints its time.
+void runOnce(const std::shared_ptr<ppc::core::Task>& task) {
+  boost::mpi::communicator world;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 1;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->data_type = ppc::core::kernels::typeName<double>();
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf(task).task_run(perfAttr, perfResults);
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+  }
+}
+
+// The same problem on a grid small enough for jacobi_method_mpi::JacobiParallel,
+// which needs O(n^2) sweeps: it gets the interior unknowns as the CSR 5-point
+// matrix and both stop once the largest change of a sweep is below eps.
+const int kJacobiSize = 64;
+
+void runAgainstJacobi() {
+  boost::mpi::communicator world;
+  const double eps = 1e-9;
+  const int interior = kJacobiSize - 2;
+  const int n = interior * interior;
+  std::vector<double> u;
+  std::vector<double> f;
+  std::vector<double> out;
+  ppc::core::kernels::CsrMatrix<double> a;
+  std::vector<double> b;
+  std::vector<double> x;
+  std::shared_ptr<ppc::core::TaskData> taskDataSor = std::make_shared<ppc::core::TaskData>();
+  std::shared_ptr<ppc::core::TaskData> taskDataJacobi = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    u.assign(static_cast<size_t>(kJacobiSize) * kJacobiSize, 0.0);
+    f.assign(u.size(), 1.0);
+    out.resize(u.size());
+    taskDataSor->inputs = {reinterpret_cast<uint8_t*>(u.data()), reinterpret_cast<uint8_t*>(f.data())};
+    taskDataSor->inputs_count = {kJacobiSize, kJacobiSize};
+    taskDataSor->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    taskDataSor->outputs_count.emplace_back(out.size());
+
+    a.rows = a.cols = n;
+    for (int i = 0; i < interior; i++) {
+      for (int j = 0; j < interior; j++) {
+        const int row = i * interior + j;
+        const auto add = [&](int col, double value) {
+          a.col_idx.push_back(col);
+          a.values.push_back(value);
+        };
+        if (i > 0) add(row - interior, -1.0);
+        if (j > 0) add(row - 1, -1.0);
+        add(row, 4.0);
+        if (j + 1 < interior) add(row + 1, -1.0);
+        if (i + 1 < interior) add(row + interior, -1.0);
+        a.row_ptr.push_back(static_cast<int>(a.values.size()));
+      }
+    }
+    b.assign(n, 1.0);
+    x.resize(n);
+    const auto nnz = static_cast<uint32_t>(a.nnz());
+    taskDataJacobi->inputs = {reinterpret_cast<uint8_t*>(a.row_ptr.data()),
+                              reinterpret_cast<uint8_t*>(a.col_idx.data()),
+                              reinterpret_cast<uint8_t*>(a.values.data()), reinterpret_cast<uint8_t*>(b.data())};
+    taskDataJacobi->inputs_count = {static_cast<uint32_t>(n + 1), nnz, nnz, static_cast<uint32_t>(n)};
+    taskDataJacobi->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+    taskDataJacobi->outputs_count.emplace_back(x.size());
+  }
+
+  auto sor = std::make_shared<red_black_sor_mpi::SorParallel<double>>(
+      taskDataSor,
+      red_black_sor_mpi::SorParams<double>{red_black_sor_mpi::optimalOmega<double>(kJacobiSize, kJacobiSize), eps,
+                                           100000});
+  auto jacobi = std::make_shared<jacobi_method_mpi::JacobiParallel<double>>(
+      taskDataJacobi, jacobi_method_mpi::JacobiParams<double>{eps, 100000});
+  runOnce(sor);
+  runOnce(jacobi);
+  if (world.rank() == 0) {
+    const auto& sor_stats = sor->stats();
+    const auto& jacobi_stats = jacobi->stats();
+    std::cout << "time to eps " << eps << " on a " << kJacobiSize << " x " << kJacobiSize
+              << " grid: red-black SOR " << sor_stats.iterations << " sweeps in " << sor_stats.seconds
+              << " s, Jacobi " << jacobi_stats.iterations << " sweeps in " << jacobi_stats.seconds << " s" << std::endl;
+    EXPECT_TRUE(sor_stats.converged);
+    EXPECT_TRUE(jacobi_stats.converged);
+    EXPECT_LT(sor_stats.iterations, jacobi_stats.iterations);
+    for (int i = 0; i < interior; i++) {
+      for (int j = 0; j < interior; j++) {
+        ASSERT_NEAR(out[(i + 1) * kJacobiSize + j + 1], x[i * interior + j], 1e-5);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(red_black_sor_mpi_perf_test, test_pipeline_run) { runPerf(true); }
+
+TEST(red_black_sor_mpi_perf_test, test_task_run) { runPerf(false); }
+
+TEST(red_black_sor_mpi_perf_test, test_task_run_against_jacobi) { runAgainstJacobi(); }
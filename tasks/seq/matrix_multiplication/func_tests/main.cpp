@@ -0,0 +1,133 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "core/testing/include/compare.hpp"
+#include "seq/matrix_multiplication/include/ops_seq.hpp"
+
+namespace {
+
+template <class T, class Task = matrix_multiplication_seq::MatmulSequential<T>>
+void runAndCompare(size_t m, size_t k, size_t n) {
+  auto a = ppc::core::testing::getExactRandomVector<T>(m * k);
+  auto b = ppc::core::testing::getExactRandomVector<T>(k * n);
+  std::vector<T> c(m * n);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+  taskDataSeq->inputs_count = {static_cast<uint32_t>(m), static_cast<uint32_t>(k), static_cast<uint32_t>(k),
+                               static_cast<uint32_t>(n)};
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+  taskDataSeq->outputs_count.emplace_back(c.size());
+
+  Task testTaskSequential(taskDataSeq);
+  ppc::core::testing::runTask(testTaskSequential);
+
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) {
+      T expected{};
+      for (size_t p = 0; p < k; p++) {
+        expected += a[i * k + p] * b[p * n + j];
+      }
+      ASSERT_EQ(c[i * n + j], expected);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(matrix_multiplication_seq, square_int) { runAndCompare<int>(64, 64, 64); }
+
+TEST(matrix_multiplication_seq, rectangular_int) { runAndCompare<int>(37, 300, 21); }
+
+TEST(matrix_multiplication_seq, row_times_column) { runAndCompare<int>(1, 513, 1); }
+
+TEST(matrix_multiplication_seq, column_times_row) { runAndCompare<int>(19, 1, 23); }
+
+TEST(matrix_multiplication_seq, rectangular_float) { runAndCompare<float>(45, 70, 33); }
+
+TEST(matrix_multiplication_seq, rectangular_double) { runAndCompare<double>(100, 27, 130); }
+
+TEST(matrix_multiplication_seq, validation_fails_on_mismatched_inner_dimension) {
+  std::vector<int> a(6);
+  std::vector<int> b(6);
+  std::vector<int> c(4);
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+  taskDataSeq->inputs_count = {2, 3, 2, 3};
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+  taskDataSeq->outputs_count.emplace_back(c.size());
+
+  matrix_multiplication_seq::MatmulSequential<int> testTaskSequential(taskDataSeq);
+  ASSERT_EQ(testTaskSequential.validation(), false);
+}
+
+TEST(matrix_multiplication_seq_strassen, square_int) {
+  runAndCompare<int, matrix_multiplication_seq::StrassenSequential<int>>(300, 300, 300);
+}
+
+TEST(matrix_multiplication_seq_strassen, size_not_power_of_two) {
+  runAndCompare<int64_t, matrix_multiplication_seq::StrassenSequential<int64_t>>(515, 515, 515);
+}
+
+TEST(matrix_multiplication_seq_strassen, below_crossover) {
+  runAndCompare<float, matrix_multiplication_seq::StrassenSequential<float>>(40, 40, 40);
+}
+
+// Random doubles: the Strassen result must stay within the Winograd error bound
+// of the classical product.
+TEST(matrix_multiplication_seq_strassen, double_error_within_bound) {
+  const uint32_t n = 320;
+  const size_t crossover = 40;
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> a(n * n);
+  std::vector<double> b(n * n);
+  for (auto& value : a) value = dist(gen);
+  for (auto& value : b) value = dist(gen);
+  std::vector<double> c(n * n);
+  std::vector<double> reference(n * n);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+  taskDataSeq->inputs_count = {n, n, n, n};
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+  taskDataSeq->outputs_count.emplace_back(c.size());
+
+  matrix_multiplication_seq::StrassenSequential<double> testTaskSequential(taskDataSeq, crossover);
+  ASSERT_EQ(testTaskSequential.validation(), true);
+  testTaskSequential.pre_processing();
+  testTaskSequential.run();
+  testTaskSequential.post_processing();
+
+  ppc::core::kernels::matmul(n, n, n, a.data(), b.data(), reference.data());
+  double max_error = 0.0;
+  for (size_t i = 0; i < c.size(); i++) {
+    max_error = std::max(max_error, std::abs(c[i] - reference[i]));
+  }
+  EXPECT_LE(max_error, ppc::core::kernels::strassenErrorBound<double>(n, crossover, 1.0, 1.0));
+}
+
+TEST(matrix_multiplication_seq_strassen, validation_fails_on_non_square_matrix) {
+  std::vector<int> a(6);
+  std::vector<int> b(9);
+  std::vector<int> c(6);
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t*>(a.data()));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+  taskDataSeq->inputs_count = {2, 3, 3, 3};
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t*>(c.data()));
+  taskDataSeq->outputs_count.emplace_back(c.size());
+
+  matrix_multiplication_seq::StrassenSequential<int> testTaskSequential(taskDataSeq);
+  ASSERT_EQ(testTaskSequential.validation(), false);
+}
@@ -0,0 +1,118 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/gemm.hpp"
+#include "core/kernels/include/strassen.hpp"
+#include "core/task/include/task.hpp"
+
+namespace matrix_multiplication_seq {
+
+inline bool isValidTaskData(const ppc::core::TaskData& taskData) {
+  return taskData.inputs.size() == 2 && taskData.inputs_count.size() == 4 && taskData.outputs_count.size() == 1 &&
+         taskData.inputs_count[0] > 0 && taskData.inputs_count[1] > 0 && taskData.inputs_count[3] > 0 &&
+         taskData.inputs_count[1] == taskData.inputs_count[2] &&
+         taskData.outputs_count[0] == taskData.inputs_count[0] * taskData.inputs_count[3];
+}
+
+// C = A * B with the packed, cache-blocked core GEMM kernel.
+// Input: inputs[0] is A (rows_A x cols_A), inputs[1] is B (rows_B x cols_B), both
+// row-major, inputs_count = {rows_A, cols_A, rows_B, cols_B}.
+// Output: outputs[0] receives rows_A x cols_B values, outputs_count = {rows_A * cols_B}.
+template <class T>
+class MatmulSequential : public ppc::core::Task {
+ public:
+  explicit MatmulSequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    m = taskData->inputs_count[0];
+    k = taskData->inputs_count[1];
+    n = taskData->inputs_count[3];
+    auto* a = reinterpret_cast<T*>(taskData->inputs[0]);
+    auto* b = reinterpret_cast<T*>(taskData->inputs[1]);
+    a_.assign(a, a + m * k);
+    b_.assign(b, b + k * n);
+    c_.resize(m * n);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return isValidTaskData(*taskData);
+  }
+
+  bool run() override {
+    internal_order_test();
+    ppc::core::kernels::matmul(m, n, k, a_.data(), b_.data(), c_.data());
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(c_.begin(), c_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    return true;
+  }
+
+ private:
+  std::vector<T> a_;
+  std::vector<T> b_;
+  std::vector<T> c_;
+  size_t m{};
+  size_t k{};
+  size_t n{};
+};
+
+// C = A * B for square matrices with the Strassen-Winograd recursion of
+// ppc::core::kernels::strassenMatmul, falling back to the blocked GEMM kernel
+// for blocks of at most crossover_ rows. Same task data as MatmulSequential,
+// with rows_A == cols_A == cols_B.
+template <class T>
+class StrassenSequential : public ppc::core::Task {
+ public:
+  explicit StrassenSequential(std::shared_ptr<ppc::core::TaskData> taskData_,
+                              size_t crossover_ = ppc::core::kernels::kStrassenCrossover)
+      : Task(std::move(taskData_)), crossover(crossover_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    n = taskData->inputs_count[0];
+    auto* a = reinterpret_cast<T*>(taskData->inputs[0]);
+    auto* b = reinterpret_cast<T*>(taskData->inputs[1]);
+    a_.assign(a, a + n * n);
+    b_.assign(b, b + n * n);
+    c_.resize(n * n);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return isValidTaskData(*taskData) && taskData->inputs_count[0] == taskData->inputs_count[1] &&
+           taskData->inputs_count[1] == taskData->inputs_count[3] && crossover > 0;
+  }
+
+  bool run() override {
+    internal_order_test();
+    ppc::core::kernels::strassenMatmul(n, a_.data(), b_.data(), c_.data(), crossover);
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(c_.begin(), c_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    return true;
+  }
+
+ private:
+  std::vector<T> a_;
+  std::vector<T> b_;
+  std::vector<T> c_;
+  size_t crossover;
+  size_t n{};
+};
+
+}  // namespace matrix_multiplication_seq
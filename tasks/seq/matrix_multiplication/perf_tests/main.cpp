@@ -0,0 +1,105 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "seq/matrix_multiplication/include/ops_seq.hpp"
+
+namespace {
+
+// A is all ones and B[p][j] = j % 7, so every entry of C is n * (j % 7) and
+// the result is checked without a reference run.
+template <class T, class Task = matrix_multiplication_seq::MatmulSequential<T>>
+void runPerf(uint32_t n, bool pipeline) {
+  std::vector<T> a(static_cast<size_t>(n) * n, T{1});
+  std::vector<T> b(static_cast<size_t>(n) * n);
+  for (size_t i = 0; i < b.size(); i++) {
+    b[i] = static_cast<T>(i % n % 7);
+  }
+  std::vector<T> c(static_cast<size_t>(n) * n);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(a.data()));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(b.data()));
+  taskDataSeq->inputs_count = {n, n, n, n};
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(c.data()));
+  taskDataSeq->outputs_count.emplace_back(c.size());
+
+  // Create Task
+  auto testTaskSequential = std::make_shared<Task>(taskDataSeq);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  // n^3 work: keep the measurement of the larger sizes within PerfResults::MAX_TIME
+  // (10 s for all runs together). One 2048 product takes several seconds on a
+  // single core, so it is measured once; 4096 (8x that) does not fit at all.
+  perfAttr->num_running = n >= 2048 ? 1 : n >= 1024 ? 3 : 10;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perfAttr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+  // Classical operation count for every algorithm, so Strassen's rate reads as
+  // the effective speed-up over the blocked kernel.
+  perfAttr->flops_per_run = 2ULL * n * n * n;
+  perfAttr->data_type = ppc::core::kernels::typeName<T>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskSequential);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  for (size_t i = 0; i < n; i += n / 8) {
+    for (size_t j = 0; j < n; j++) {
+      ASSERT_EQ(c[i * n + j], static_cast<T>(n * (j % 7)));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(matrix_multiplication_seq_perf_test, test_pipeline_run_int32_512) { runPerf<int32_t>(512, true); }
+
+TEST(matrix_multiplication_seq_perf_test, test_pipeline_run_float_512) { runPerf<float>(512, true); }
+
+TEST(matrix_multiplication_seq_perf_test, test_pipeline_run_double_512) { runPerf<double>(512, true); }
+
+TEST(matrix_multiplication_seq_perf_test, test_task_run_int32_1024) { runPerf<int32_t>(1024, false); }
+
+TEST(matrix_multiplication_seq_perf_test, test_task_run_float_1024) { runPerf<float>(1024, false); }
+
+TEST(matrix_multiplication_seq_perf_test, test_task_run_double_1024) { runPerf<double>(1024, false); }
+
+TEST(matrix_multiplication_seq_perf_test, test_task_run_int32_2048) { runPerf<int32_t>(2048, false); }
+
+TEST(matrix_multiplication_seq_perf_test, test_task_run_float_2048) { runPerf<float>(2048, false); }
+
+TEST(matrix_multiplication_seq_perf_test, test_task_run_double_2048) { runPerf<double>(2048, false); }
+
+TEST(matrix_multiplication_seq_perf_test, test_task_run_strassen_double_1024) {
+  runPerf<double, matrix_multiplication_seq::StrassenSequential<double>>(1024, false);
+}
+
+TEST(matrix_multiplication_seq_perf_test, test_pipeline_run_strassen_float_512) {
+  runPerf<float, matrix_multiplication_seq::StrassenSequential<float>>(512, true);
+}
+
+TEST(matrix_multiplication_seq_perf_test, test_task_run_strassen_double_2048) {
+  runPerf<double, matrix_multiplication_seq::StrassenSequential<double>>(2048, false);
+}
+
+TEST(matrix_multiplication_seq_perf_test, test_task_run_strassen_float_2048) {
+  runPerf<float, matrix_multiplication_seq::StrassenSequential<float>>(2048, false);
+}
@@ -0,0 +1,87 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "core/kernels/include/gemm.hpp"
+#include "core/testing/include/compare.hpp"
+#include "tbb/matrix_multiplication/include/ops_tbb.hpp"
+
+namespace {
+
+template <class T>
+std::vector<T> runStrassen(std::vector<T>& a, std::vector<T>& b, uint32_t n, size_t crossover) {
+  std::vector<T> c(static_cast<size_t>(n) * n);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(a.data()));
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(b.data()));
+  taskDataPar->inputs_count = {n, n, n, n};
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(c.data()));
+  taskDataPar->outputs_count.emplace_back(c.size());
+
+  matrix_multiplication_tbb::StrassenParallel<T> testTaskParallel(taskDataPar, crossover);
+  ppc::core::testing::runTask(testTaskParallel);
+  return c;
+}
+
+template <class T>
+void runAndCompare(uint32_t n, size_t crossover) {
+  auto a = ppc::core::testing::getExactRandomVector<T>(static_cast<size_t>(n) * n);
+  auto b = ppc::core::testing::getExactRandomVector<T>(static_cast<size_t>(n) * n);
+  const std::vector<T> c = runStrassen(a, b, n, crossover);
+  std::vector<T> reference(static_cast<size_t>(n) * n);
+  ppc::core::kernels::matmul<T>(n, n, n, a.data(), b.data(), reference.data());
+  ASSERT_EQ(c, reference);
+}
+
+}  // namespace
+
+TEST(matrix_multiplication_tbb_strassen, square_int) { runAndCompare<int>(256, 32); }
+
+TEST(matrix_multiplication_tbb_strassen, size_not_power_of_two) { runAndCompare<int64_t>(300, 64); }
+
+TEST(matrix_multiplication_tbb_strassen, several_levels_float) { runAndCompare<float>(200, 8); }
+
+TEST(matrix_multiplication_tbb_strassen, below_crossover) { runAndCompare<double>(31, 64); }
+
+// Random doubles: the task-parallel result must stay within the Winograd error
+// bound of the classical product.
+TEST(matrix_multiplication_tbb_strassen, double_error_within_bound) {
+  const uint32_t n = 384;
+  const size_t crossover = 48;
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> a(static_cast<size_t>(n) * n);
+  std::vector<double> b(static_cast<size_t>(n) * n);
+  for (auto &value : a) value = dist(gen);
+  for (auto &value : b) value = dist(gen);
+  const std::vector<double> c = runStrassen(a, b, n, crossover);
+  std::vector<double> reference(static_cast<size_t>(n) * n);
+  ppc::core::kernels::matmul<double>(n, n, n, a.data(), b.data(), reference.data());
+
+  double max_error = 0.0;
+  for (size_t i = 0; i < c.size(); i++) {
+    max_error = std::max(max_error, std::abs(c[i] - reference[i]));
+  }
+  EXPECT_LE(max_error, ppc::core::kernels::strassenErrorBound<double>(n, crossover, 1.0, 1.0));
+}
+
+TEST(matrix_multiplication_tbb_strassen, validation_fails_on_non_square_matrix) {
+  std::vector<int> a(6);
+  std::vector<int> b(9);
+  std::vector<int> c(6);
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(a.data()));
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(b.data()));
+  taskDataPar->inputs_count = {2, 3, 3, 3};
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(c.data()));
+  taskDataPar->outputs_count.emplace_back(c.size());
+
+  matrix_multiplication_tbb::StrassenParallel<int> testTaskParallel(taskDataPar);
+  ASSERT_EQ(testTaskParallel.validation(), false);
+}
@@ -0,0 +1,79 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <oneapi/tbb/task_group.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/kernels/include/strassen.hpp"
+#include "core/task/include/task.hpp"
+
+namespace matrix_multiplication_tbb {
+
+// Fork policy for strassenMatmul: the seven products of a level run as tasks
+// of one tbb::task_group and are joined before the level combines them. Nested
+// levels fork into the same scheduler, so 7^depth tasks are load balanced by
+// work stealing.
+struct TaskGroupFork {
+  template <class... Tasks>
+  void operator()(Tasks&&... tasks) const {
+    oneapi::tbb::task_group group;
+    (group.run(tasks), ...);
+    group.wait();
+  }
+};
+
+// Task-parallel counterpart of matrix_multiplication_seq::StrassenSequential:
+// same task data (square A and B, row-major, inputs_count = {n, n, n, n}) and
+// the same crossover into the blocked GEMM kernel.
+template <class T>
+class StrassenParallel : public ppc::core::Task {
+ public:
+  explicit StrassenParallel(std::shared_ptr<ppc::core::TaskData> taskData_,
+                            size_t crossover_ = ppc::core::kernels::kStrassenCrossover)
+      : Task(std::move(taskData_)), crossover(crossover_) {}
+
+  bool pre_processing() override {
+    internal_order_test();
+    n = taskData->inputs_count[0];
+    auto* a = reinterpret_cast<T*>(taskData->inputs[0]);
+    auto* b = reinterpret_cast<T*>(taskData->inputs[1]);
+    a_.assign(a, a + n * n);
+    b_.assign(b, b + n * n);
+    c_.resize(n * n);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->inputs.size() == 2 && taskData->inputs_count.size() == 4 && taskData->outputs_count.size() == 1 &&
+           taskData->inputs_count[0] > 0 && taskData->inputs_count[0] == taskData->inputs_count[1] &&
+           taskData->inputs_count[1] == taskData->inputs_count[2] &&
+           taskData->inputs_count[2] == taskData->inputs_count[3] &&
+           taskData->outputs_count[0] == taskData->inputs_count[0] * taskData->inputs_count[0] && crossover > 0;
+  }
+
+  bool run() override {
+    internal_order_test();
+    ppc::core::kernels::strassenMatmul(n, a_.data(), b_.data(), c_.data(), crossover, TaskGroupFork{});
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(c_.begin(), c_.end(), reinterpret_cast<T*>(taskData->outputs[0]));
+    return true;
+  }
+
+ private:
+  std::vector<T> a_;
+  std::vector<T> b_;
+  std::vector<T> c_;
+  size_t crossover;
+  size_t n{};
+};
+
+}  // namespace matrix_multiplication_tbb
@@ -0,0 +1,71 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+#include <oneapi/tbb.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "core/kernels/include/simd.hpp"
+#include "core/perf/include/perf.hpp"
+#include "tbb/matrix_multiplication/include/ops_tbb.hpp"
+
+namespace {
+
+// A is all ones and B[p][j] = j % 7, so every entry of C is n * (j % 7) and
+// the result is checked without a reference run. Same sizes as the sequential
+// matrix_multiplication perf tests, so the two tables compare directly.
+template <class T>
+void runPerf(uint32_t n, bool pipeline) {
+  std::vector<T> a(static_cast<size_t>(n) * n, T{1});
+  std::vector<T> b(static_cast<size_t>(n) * n);
+  for (size_t i = 0; i < b.size(); i++) {
+    b[i] = static_cast<T>(i % n % 7);
+  }
+  std::vector<T> c(static_cast<size_t>(n) * n);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(a.data()));
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(b.data()));
+  taskDataPar->inputs_count = {n, n, n, n};
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(c.data()));
+  taskDataPar->outputs_count.emplace_back(c.size());
+
+  // Create Task
+  auto testTaskParallel = std::make_shared<matrix_multiplication_tbb::StrassenParallel<T>>(taskDataPar);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  // One 2048 product is measured once to stay within PerfResults::MAX_TIME.
+  perfAttr->num_running = n >= 2048 ? 1 : n >= 1024 ? 3 : 10;
+  const auto t0 = oneapi::tbb::tick_count::now();
+  perfAttr->current_timer = [&] { return (oneapi::tbb::tick_count::now() - t0).seconds(); };
+  // Classical operation count, as in the sequential perf tests.
+  perfAttr->flops_per_run = 2ULL * n * n * n;
+  perfAttr->data_type = ppc::core::kernels::typeName<T>();
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskParallel);
+  if (pipeline) {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  }
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  for (size_t i = 0; i < n; i += n / 8) {
+    for (size_t j = 0; j < n; j++) {
+      ASSERT_EQ(c[i * n + j], static_cast<T>(n * (j % 7)));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(matrix_multiplication_tbb_perf_test, test_pipeline_run_strassen_float_512) { runPerf<float>(512, true); }
+
+TEST(matrix_multiplication_tbb_perf_test, test_task_run_strassen_double_1024) { runPerf<double>(1024, false); }
+
+TEST(matrix_multiplication_tbb_perf_test, test_task_run_strassen_double_2048) { runPerf<double>(2048, false); }